@@ -51,6 +51,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include "apputils/apputilsDecl.h"
 #include "vvenc/vvencCfg.h"
 #include <string>
+#include <vector>
 
 namespace apputils {
 
@@ -75,6 +76,9 @@ public:
   bool         m_bClipOutputVideoToRec709Range = false;
   bool         m_packedYUVMode                 = false;        ///< If true, output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data
   bool         m_decode                        = false;
+  int          m_RCPass                        = -1;           ///< rate control pass to run with a statistics file (-1: both, 1: first only, 2: second only)
+  std::vector<int> m_ladderQPs;                                ///< QPs of additional rate points seeded from the analysis of the configured one
+  std::vector<int> m_ladderBitrates;                           ///< target bitrates of additional rate points seeded from the analysis of the configured one
   bool         m_showVersion                   = false;
 
 public:
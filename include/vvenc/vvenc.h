@@ -276,6 +276,25 @@ typedef void (*vvencRecYUVBufferCallback)(void*, vvencYUVBuffer* );
 */
 VVENC_DECL int vvenc_encoder_set_RecYUVBufferCallback(vvencEncoder *, void * ctx, vvencRecYUVBufferCallback callback );
 
+/* vvencSliceCallback:
+   callback function to receive the NAL units of an access unit slice by slice, in bitstream order.
+   The first chunk of an access unit additionally contains the parameter sets, prefix SEI messages and picture header,
+   the suffix SEI messages are delivered as last chunk. The concatenated chunks are equal to the access unit returned by vvenc_encode.
+   The slices are delivered while the picture is encoded if ALF is disabled and MaxParallelFrames <= 1,
+   otherwise as soon as the picture is written. The callback may be called from a worker thread of the encoder.
+*/
+typedef void (*vvencSliceCallback)(void*, vvencAccessUnit* );
+
+/* vvenc_encoder_set_SliceCallback
+ This method sets the callback to get the NAL units of the encoded slices (see SliceCtuRows for multiple slices per picture).
+ \param[in]  vvencEncoder pointer to opaque handler
+ \param[in]  ctx pointer of the caller, if not needed set it to null
+ \param[in]  implementation of the callback
+ \retval     int if non-zero an error occurred (see ErrorCodes), otherwise VVENC_OK indicates success.
+ \pre        The encoder has to be initialized.
+*/
+VVENC_DECL int vvenc_encoder_set_SliceCallback(vvencEncoder *, void * ctx, vvencSliceCallback callback );
+
 /* vvenc_init_pass
   This method initializes the encoder instance in dependency to the encoder pass.
  \param[in]  vvencEncoder pointer to opaque handler
@@ -314,10 +333,15 @@ VVENC_DECL int vvenc_get_config( vvencEncoder *,vvenc_config * );
 /* vvenc_reconfig
  This method reconfigures the encoder instance.
  This method is used to change encoder settings during the encoding process when the encoder was already initialized.
- Some parameter changes might require an internal encoder restart, especially when previously used parameter sets VPS, SPS or PPS
- become invalid after the parameter change. If changes are limited to TargetBitRate or QP changes then the encoder continues encoding
- without interruption, using the new parameters. Some parameters e.g. NumTheads are not reconfigurable - in this case the encoder returns an Error.
- The method fails if the encoder is not initialized or if the assigned parameter set given in vvenc_config struct
+ The encoder continues encoding without interruption, the new parameters are used starting with the next GOP in coding order
+ (pictures already being encoded are finished with the old parameters).
+ Reconfigurable parameters are: RCTargetBitrate (one pass rate control only, not with HRD parameters), QP (without rate control),
+ motionEstimationSearchMethod, SearchRange, bipredSearchRange, minSearchWindow, bRestrictMESampling, fastSubPel and
+ NumThreads (can be reduced, or restored up to the initial number, if the encoder was initialized with threads).
+ Changes of all other parameters are ignored. Switching rate control on or off and reconfiguration with two pass rate control is not
+ supported, in this case the encoder returns VVENC_ERR_NOT_SUPPORTED. Settings derived from QP during initialization (e.g. SAO offset
+ scaling, MCTF strength) are kept.
+ The method fails if the encoder is not initialized, if the encoder is already flushing or if the assigned parameter set given in vvenc_config struct
  does not pass the consistency and parameter check.
  \param[in]  vvencEncoder pointer to opaque handler
  \param[in]  vvenc_config const reference to vvenc_config struct that holds the new encoder parameters.
@@ -432,6 +432,7 @@ typedef struct vvenc_config
   int                 m_IntraPeriodSec;                                                  // period of I-slice in seconds (random access period)
   vvencDecodingRefreshType m_DecodingRefreshType;                                        // random access type
   int                 m_GOPSize;                                                          // GOP size of hierarchical structure
+  bool                m_lowDelay;                                                        // low-delay coding without picture reordering, each picture is returned by the encoder call it was passed in
 
   int                 m_QP;                                                              // QP value of key-picture (integer)
   bool                m_usePerceptQPA;                                                   // Mode of perceptually motivated input-adaptive QP modification, abbrev. perceptual QP adaptation (QPA).
@@ -556,6 +557,9 @@ typedef struct vvenc_config
   int                 m_useAMaxBT;
   bool                m_fastQtBtEnc;
   bool                m_contentBasedFastQtbt;
+  double              m_SplitModelConf;                                                  // confidence of the split model to skip a split (0: off)
+  char                m_SplitModelFile[VVENC_MAX_STRING_LEN];                            // weights of the split model replacing the built-in ones
+  char                m_SplitModelDumpFile[VVENC_MAX_STRING_LEN];                        // file to write the split model training data to
   int                 m_fastInterSearchMode;                                             // Parameter that controls fast encoder settings
   bool                m_bUseEarlyCU;                                                     // flag for using Early CU setting
   bool                m_useFastDecisionForMerge;                                         // flag for using Fast Decision Merge RD-Cost
@@ -582,6 +586,8 @@ typedef struct vvenc_config
 
   int                 m_RCInitialQP;
   bool                m_RCForceIntraQP;
+  int                 m_FirstPassMode;                                                   // first pass of two-pass RC (0: encode with reduced tools, 1: estimate from the lookahead analysis)
+  char                m_RCStatsFile[VVENC_MAX_STRING_LEN];                               // two-pass RC statistics file, written by the first pass, read by a second pass without preceding first pass
 
   int                 m_motionEstimationSearchMethod;
   int                 m_motionEstimationSearchMethodSCC;
@@ -592,7 +598,9 @@ typedef struct vvenc_config
   bool                m_bClipForBiPredMeEnabled;                                         // Enables clipping for Bi-Pred ME.
   bool                m_bFastMEAssumingSmootherMVEnabled;                                // Enables fast ME assuming a smoother MV.
   bool                m_bIntegerET;                                                      // Enables early termination for integer motion search.
+  bool                m_bMCTFMvPred;                                                     // Use the MCTF motion fields as start candidates for integer motion search.
   int                 m_fastSubPel;
+  bool                m_bHalfPelRefCache;                                                // Keep half-sample interpolated planes of the reference pictures for the fractional motion search.
   int                 m_SMVD;
   int                 m_AMVRspeed;
   bool                m_LMChroma;
@@ -634,6 +642,7 @@ typedef struct vvenc_config
 
   int                 m_IBCMode;
   int                 m_IBCFastMethod;
+  bool                m_HashME;                                                          // hash based exact match search for IBC and screen content ME
 
   int                 m_BCW;
 
@@ -649,6 +658,7 @@ typedef struct vvenc_config
   bool                m_bLFCrossTileBoundaryFlag;
   bool                m_bLFCrossSliceBoundaryFlag;                                       // 1: filter across slice boundaries 0: do not filter across slice boundaries
   bool                m_loopFilterAcrossSlicesEnabled;
+  int                 m_sliceCtuRows;                                                    // number of CTU rows per slice, 0: one slice per picture
 
   bool                m_bUseSAO;
   double              m_saoEncodingRate;                                                 // When >0 SAO early picture termination is enabled for luma and chroma
@@ -692,6 +702,10 @@ typedef struct vvenc_config
   int                 m_alfSpeed;
 
   vvencMCTF           m_vvencMCTF;
+  bool                m_LookAhead;                                                       // analyse the input pictures on a downscaled pyramid once (costs, motion, activity)
+  char                m_AnalysisSaveFile[VVENC_MAX_STRING_LEN];                          // file to store the partitioning, modes and motion of the coded pictures
+  char                m_AnalysisLoadFile[VVENC_MAX_STRING_LEN];                          // file with the decisions of an earlier encode to restrict the search to
+  int                 m_AnalysisRefine;                                                  // refinement of loaded decisions (0: partitioning and prediction type, 1: partitioning, 2: partitioning and one further split)
 
   int                 m_quantThresholdVal;
   int                 m_qtbttSpeedUp;
@@ -701,8 +715,14 @@ typedef struct vvenc_config
   int                 m_maxParallelFrames;
   int                 m_ensureWppBitEqual;                                               // Flag indicating bit equalitiy for single thread runs respecting multithread restrictions
 
+  double              m_RealTimeFps;                                                     // target frame rate of the real-time speed control (0: off, <0: source frame rate)
+  int                 m_RealTimeMaxDelay;                                                // max. number of frames the real-time encoder may fall behind the source (<0: GOP size)
+
   bool                m_picPartitionFlag;
 
+  bool                m_SIMDTuning;                                                      // time the SIMD kernels on encoder start and use the fastest extension per kernel and block width
+  char                m_SIMDTuningFile[VVENC_MAX_STRING_LEN];                            // cache file for the SIMD kernel tuning, skips the timing if valid for this CPU
+
   // decode bitstream options
   int                 m_switchPOC;                                                       // dbg poc.
   int                 m_switchDQP;                                                       // switch DQP.
@@ -111,12 +111,76 @@ bool EncApp::parseCfg( int argc, char* argv[])
  */
 int EncApp::encode()
 {
-  vvenc_config& vvencCfg = m_cEncAppCfg;
   if( m_cEncAppCfg.m_decode )
   {
     return vvenc_decode_bitstream( m_cEncAppCfg.m_bitstreamFileName.c_str() );
   }
 
+  if( m_cEncAppCfg.m_ladderQPs.empty() && m_cEncAppCfg.m_ladderBitrates.empty() )
+  {
+    return xEncode();
+  }
+
+  return xEncodeLadder();
+}
+
+/**
+ * multi-rate ladder: the configured rate point is encoded first as anchor, its stored analysis
+ * (partitioning, prediction modes, motion) seeds the search of all other rate points
+ */
+int EncApp::xEncodeLadder()
+{
+  const vvenc_config  baseCfg       = m_cEncAppCfg;
+  const std::string   bitstreamFile = m_cEncAppCfg.m_bitstreamFileName;
+  const bool          keepAnalysis  = baseCfg.m_AnalysisSaveFile[0] != '\0';
+  const std::string   analysisFile  = keepAnalysis ? std::string( baseCfg.m_AnalysisSaveFile ) : bitstreamFile + ".analysis";
+  const bool          isBitrate     = ! m_cEncAppCfg.m_ladderBitrates.empty();
+  const std::vector<int> rates      = isBitrate ? m_cEncAppCfg.m_ladderBitrates : m_cEncAppCfg.m_ladderQPs;
+
+  msgApp( VVENC_INFO, "ladder anchor: %s\n", bitstreamFile.c_str() );
+  snprintf( m_cEncAppCfg.m_AnalysisSaveFile, VVENC_MAX_STRING_LEN, "%s", analysisFile.c_str() );
+  int iRet = xEncode();
+
+  const size_t extPos = bitstreamFile.find_last_of( '.' );
+  const size_t dirPos = bitstreamFile.find_last_of( "/\\" );
+  const bool   hasExt = extPos != std::string::npos && ( dirPos == std::string::npos || extPos > dirPos );
+  for( size_t i = 0; i < rates.size() && 0 == iRet; i++ )
+  {
+    static_cast<vvenc_config&>( m_cEncAppCfg ) = baseCfg;
+    m_cEncAppCfg.m_AnalysisSaveFile[0] = '\0';
+    snprintf( m_cEncAppCfg.m_AnalysisLoadFile, VVENC_MAX_STRING_LEN, "%s", analysisFile.c_str() );
+    if( isBitrate )
+    {
+      m_cEncAppCfg.m_RCTargetBitrate = rates[ i ];
+    }
+    else
+    {
+      m_cEncAppCfg.m_QP = rates[ i ];
+    }
+
+    // the reconstruction is only written for the anchor
+    m_cEncAppCfg.m_reconFileName.clear();
+    m_cEncAppCfg.m_bitstreamFileName = hasExt ? bitstreamFile.substr( 0, extPos ) + "_" + std::to_string( i + 1 ) + bitstreamFile.substr( extPos )
+                                              : bitstreamFile + "_" + std::to_string( i + 1 );
+    m_essentialBytes = 0;
+    m_totalBytes     = 0;
+
+    msgApp( VVENC_INFO, "\nladder rate point %d (%s %d): %s\n", (int)i + 1, isBitrate ? "bitrate" : "QP", rates[ i ], m_cEncAppCfg.m_bitstreamFileName.c_str() );
+    iRet = xEncode();
+  }
+
+  if( ! keepAnalysis )
+  {
+    remove( analysisFile.c_str() );
+  }
+
+  return iRet;
+}
+
+int EncApp::xEncode()
+{
+  vvenc_config& vvencCfg = m_cEncAppCfg;
+
   // initialize encoder lib
   m_encCtx = vvenc_encoder_create();
   if( nullptr == m_encCtx )
@@ -184,8 +248,12 @@ int EncApp::encode()
     default: break;
   }
 
+  // with a rate control statistics file, the passes can be run separately
+  const int firstPass = m_cEncAppCfg.m_RCPass == 2 ? 1 : 0;
+  const int lastPass  = m_cEncAppCfg.m_RCPass == 1 ? 0 : vvencCfg.m_RCNumPasses - 1;
+
   int framesRcvd = 0;
-  for( int pass = 0; pass < vvencCfg.m_RCNumPasses; pass++ )
+  for( int pass = firstPass; pass <= lastPass; pass++ )
   {
     // open input YUV
     if( m_yuvInputFile.open( m_cEncAppCfg.m_inputFileName, false, vvencCfg.m_inputBitDepth[0], vvencCfg.m_MSBExtendedBitDepth[0], vvencCfg.m_internalBitDepth[0],
@@ -206,7 +274,16 @@ int EncApp::encode()
     }
 
     // initialize encoder pass
-    vvenc_init_pass( m_encCtx, pass );
+    iRet = vvenc_init_pass( m_encCtx, pass );
+    if( 0 != iRet )
+    {
+      msgApp( VVENC_ERROR, "init pass %d failed: err code %d - %s\n", pass, iRet, vvenc_get_last_error( m_encCtx ) );
+      vvenc_encoder_close( m_encCtx );
+      vvenc_YUVBuffer_free_buffer( &yuvInBuf );
+      vvenc_accessUnit_free_payload( &au );
+      closeFileIO();
+      return iRet;
+    }
 
     // loop over input YUV data
     bool inputDone  = false;
@@ -113,6 +113,9 @@ public:
   }
 
 private:
+  int   xEncode();                                    ///< encode one stream with the current configuration
+  int   xEncodeLadder();                              ///< encode the configured stream and the rate points of a multi-rate ladder
+
   // file I/O
   bool openFileIO();
   void closeFileIO();
@@ -80,6 +80,9 @@ AdaptiveLoopFilter::AdaptiveLoopFilter()
   m_filter7x7Blk[0] = filterBlk<ALF_FILTER_7>; // NonLin is Off
   m_filter7x7Blk[1] = filterBlk<ALF_FILTER_7>; // NonLin is On
 
+  m_calcCovLin4x4   = calcCovLin4x4;
+  m_calcCovNonLin   = calcCovNonLin;
+
 #if ENABLE_SIMD_OPT_ALF
 #ifdef TARGET_SIMD_X86
   initAdaptiveLoopFilterX86();
@@ -87,6 +90,70 @@ AdaptiveLoopFilter::AdaptiveLoopFilter()
 #endif
 }
 
+void AdaptiveLoopFilter::calcCovLin4x4( const Pel* ELocal, const Pel* yLocal, const int numCoeff, double E[MAX_NUM_ALF_LUMA_COEFF][MAX_NUM_ALF_LUMA_COEFF], double* y, double& pixAcc )
+{
+  for( int k = 0; k < numCoeff; k++ )
+  {
+    const Pel* Elocalk = &ELocal[k << 4];
+    double* cov = &E[k][k];
+
+    for( int l = k; l < numCoeff; l++ )
+    {
+      const Pel* Elocall = &ELocal[l << 4];
+
+      int64_t sum = 0;
+      for( int i = 0; i < 16; i++ )
+      {
+        sum += int( Elocall[i] ) * Elocalk[i];
+      }
+
+      *cov++ += sum;
+    }
+
+    int64_t sum = 0;
+    for( int i = 0; i < 16; i++ )
+    {
+      sum += int( Elocalk[i] ) * yLocal[i];
+    }
+
+    y[k] += sum;
+  }
+
+  int64_t sum = 0;
+  for( int i = 0; i < 16; i++ )
+  {
+    sum += int( yLocal[i] ) * yLocal[i];
+  }
+
+  pixAcc += sum;
+}
+
+void AdaptiveLoopFilter::calcCovNonLin( const int ELocal[MAX_NUM_ALF_LUMA_COEFF][MaxAlfNumClippingValues], const int yLocal, const double weight, const int numCoeff,
+                                        double (**E)[MAX_NUM_ALF_LUMA_COEFF][MAX_NUM_ALF_LUMA_COEFF], double (*y)[MAX_NUM_ALF_LUMA_COEFF], double& pixAcc )
+{
+  // the products are exact in double, so a weight of 1.0 yields the unweighted statistics
+  for( int k = 0; k < numCoeff; k++ )
+  {
+    for( int l = k; l < numCoeff; l++ )
+    {
+      for( int b0 = 0; b0 < MaxAlfNumClippingValues; b0++ )
+      {
+        for( int b1 = 0; b1 < MaxAlfNumClippingValues; b1++ )
+        {
+          E[b0][b1][k][l] += weight * ( ELocal[k][b0] * ( double ) ELocal[l][b1] );
+        }
+      }
+    }
+
+    for( int b = 0; b < MaxAlfNumClippingValues; b++ )
+    {
+      y[b][k] += weight * ( ELocal[k][b] * ( double ) yLocal );
+    }
+  }
+
+  pixAcc += weight * ( yLocal * ( double ) yLocal );
+}
+
 bool AdaptiveLoopFilter::isCrossedByVirtualBoundaries( const CodingStructure& cs, const int xPos, const int yPos, const int width, const int height, bool& clipTop, bool& clipBottom, bool& clipLeft, bool& clipRight, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], int& rasterSliceAlfPad )
 {
   clipTop = false; clipBottom = false; clipLeft = false; clipRight = false;
@@ -140,6 +140,16 @@ public:
                                      const short *fClipSet, const ClpRng &clpRng, const CodingStructure &cs, const int vbCTUHeight,
                                      int vbPos);
 
+  // encoder statistics, only the upper triangle of the covariance matrices is accumulated
+  static void calcCovLin4x4         ( const Pel* ELocal, const Pel* yLocal, const int numCoeff,
+                                      double E[MAX_NUM_ALF_LUMA_COEFF][MAX_NUM_ALF_LUMA_COEFF], double* y, double& pixAcc );
+  static void calcCovNonLin         ( const int ELocal[MAX_NUM_ALF_LUMA_COEFF][MaxAlfNumClippingValues], const int yLocal, const double weight, const int numCoeff,
+                                      double (**E)[MAX_NUM_ALF_LUMA_COEFF][MAX_NUM_ALF_LUMA_COEFF], double (*y)[MAX_NUM_ALF_LUMA_COEFF], double& pixAcc );
+  void (*m_calcCovLin4x4)           ( const Pel* ELocal, const Pel* yLocal, const int numCoeff,
+                                      double E[MAX_NUM_ALF_LUMA_COEFF][MAX_NUM_ALF_LUMA_COEFF], double* y, double& pixAcc );
+  void (*m_calcCovNonLin)           ( const int ELocal[MAX_NUM_ALF_LUMA_COEFF][MaxAlfNumClippingValues], const int yLocal, const double weight, const int numCoeff,
+                                      double (**E)[MAX_NUM_ALF_LUMA_COEFF][MAX_NUM_ALF_LUMA_COEFF], double (*y)[MAX_NUM_ALF_LUMA_COEFF], double& pixAcc );
+
 #ifdef TARGET_SIMD_X86
   void initAdaptiveLoopFilterX86();
   template <X86_VEXT vext>
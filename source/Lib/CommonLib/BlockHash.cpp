@@ -0,0 +1,289 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     BlockHash.cpp
+    \brief    block hash table for exact match motion and block vector search
+*/
+
+#include "BlockHash.h"
+
+#include <array>
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+static std::array<uint32_t, 256> initCrc32cTable()
+{
+  std::array<uint32_t, 256> table;
+  for( uint32_t i = 0; i < 256; i++ )
+  {
+    uint32_t crc = i;
+    for( int k = 0; k < 8; k++ )
+    {
+      crc = ( crc & 1 ) ? ( crc >> 1 ) ^ 0x82F63B78 : ( crc >> 1 );
+    }
+    table[ i ] = crc;
+  }
+  return table;
+}
+
+static const std::array<uint32_t, 256> g_crc32cTable = initCrc32cTable();
+
+uint32_t BlockHashMap::xCrc32c( uint32_t crc, uint32_t val )
+{
+  crc ^= val;
+  crc = ( crc >> 8 ) ^ g_crc32cTable[ crc & 0xff ];
+  crc = ( crc >> 8 ) ^ g_crc32cTable[ crc & 0xff ];
+  crc = ( crc >> 8 ) ^ g_crc32cTable[ crc & 0xff ];
+  crc = ( crc >> 8 ) ^ g_crc32cTable[ crc & 0xff ];
+  return crc;
+}
+
+uint32_t BlockHashMap::xRowHash4( const Pel* src )
+{
+  uint32_t crc = xCrc32c( 0xffffffff, ( uint16_t ) src[ 0 ] | ( ( uint32_t ) ( uint16_t ) src[ 1 ] << 16 ) );
+  return         xCrc32c( crc,        ( uint16_t ) src[ 2 ] | ( ( uint32_t ) ( uint16_t ) src[ 3 ] << 16 ) );
+}
+
+uint32_t BlockHashMap::xHash4x4( const uint32_t* rowHash, const ptrdiff_t stride )
+{
+  uint32_t crc = 0x4a4a4a4a;
+  crc = xCrc32c( crc, rowHash[ 0          ] );
+  crc = xCrc32c( crc, rowHash[     stride ] );
+  crc = xCrc32c( crc, rowHash[ 2 * stride ] );
+  crc = xCrc32c( crc, rowHash[ 3 * stride ] );
+  return crc;
+}
+
+uint32_t BlockHashMap::xHash8x8( const uint32_t h0, const uint32_t h1, const uint32_t h2, const uint32_t h3 )
+{
+  uint32_t crc = 0x88888888;
+  crc = xCrc32c( crc, h0 );
+  crc = xCrc32c( crc, h1 );
+  crc = xCrc32c( crc, h2 );
+  crc = xCrc32c( crc, h3 );
+  return crc;
+}
+
+// bit 0: every row is flat, bit 1: all rows are identical (every column is flat)
+uint8_t BlockHashMap::xFlags4x4( const uint32_t* rowHash, const uint8_t* rowFlat, const ptrdiff_t stride )
+{
+  const uint8_t hor = rowFlat[ 0 ] & rowFlat[ stride ] & rowFlat[ 2 * stride ] & rowFlat[ 3 * stride ];
+  const uint8_t ver = rowHash[ 0 ] == rowHash[ stride ] && rowHash[ 0 ] == rowHash[ 2 * stride ] && rowHash[ 0 ] == rowHash[ 3 * stride ];
+  return hor | ( ver << 1 );
+}
+
+// sub-blocks in the order top-left, top-right, bottom-left, bottom-right
+uint8_t BlockHashMap::xFlags8x8( const uint32_t h[4], const uint8_t f[4] )
+{
+  const uint8_t all = f[ 0 ] & f[ 1 ] & f[ 2 ] & f[ 3 ];
+  const uint8_t hor = ( all & 1 ) && h[ 0 ] == h[ 1 ] && h[ 2 ] == h[ 3 ];
+  const uint8_t ver = ( all & 2 ) && h[ 0 ] == h[ 2 ] && h[ 1 ] == h[ 3 ];
+  return hor | ( ver << 1 );
+}
+
+bool BlockHashMap::getKeyBlock( const CPelBuf& blk, const int blkSize, Position& keyPos, uint32_t& keyHash )
+{
+  CHECKD( blkSize != MIN_HASH_BLK_SIZE && blkSize != MAX_HASH_BLK_SIZE, "unsupported hash block size" );
+
+  for( int y = 0; y + blkSize <= blk.height; y += blkSize )
+  {
+    for( int x = 0; x + blkSize <= blk.width; x += blkSize )
+    {
+      uint32_t h[ 4 ];
+      uint8_t  f[ 4 ];
+      for( int i = 0; i < ( blkSize >> 2 ) * ( blkSize >> 2 ); i++ )
+      {
+        const Pel* src = blk.bufAt( x + ( i & 1 ) * 4, y + ( i >> 1 ) * 4 );
+        uint32_t rowHash[ 4 ];
+        uint8_t  rowFlat[ 4 ];
+        for( int k = 0; k < 4; k++ )
+        {
+          rowHash[ k ] = xRowHash4( src + k * blk.stride );
+          rowFlat[ k ] = xRowFlat4( src + k * blk.stride );
+        }
+        h[ i ] = xHash4x4 ( rowHash, 1 );
+        f[ i ] = xFlags4x4( rowHash, rowFlat, 1 );
+      }
+
+      const uint8_t flags = blkSize == MIN_HASH_BLK_SIZE ? f[ 0 ] : xFlags8x8( h, f );
+      if( !flags )
+      {
+        keyPos.x = x;
+        keyPos.y = y;
+        keyHash  = blkSize == MIN_HASH_BLK_SIZE ? h[ 0 ] : xHash8x8( h[ 0 ], h[ 1 ], h[ 2 ], h[ 3 ] );
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void BlockHashMap::clear()
+{
+  for( int i = 0; i < 2; i++ )
+  {
+    m_bucketStart[ i ].clear();
+    m_entries    [ i ].clear();
+  }
+}
+
+std::pair<const BlockHashMap::Entry*, const BlockHashMap::Entry*> BlockHashMap::getBucket( const uint32_t hash, const int blkSize ) const
+{
+  const int idx = blkSize == MIN_HASH_BLK_SIZE ? 0 : 1;
+  if( m_entries[ idx ].empty() )
+  {
+    return std::make_pair( nullptr, nullptr );
+  }
+
+  const uint32_t bucket = hash >> ( 32 - HASH_BUCKET_BITS );
+  const Entry*   base   = m_entries[ idx ].data();
+  return std::make_pair( base + m_bucketStart[ idx ][ bucket ], base + m_bucketStart[ idx ][ bucket + 1 ] );
+}
+
+void BlockHashMap::xBuildTable( const int idx, const std::vector<uint32_t>& blkHash, const std::vector<uint8_t>& blkValid, const int width, const int height )
+{
+  // counting sort of all valid blocks by the upper hash bits, keeps the raster order within a bucket
+  std::vector<uint32_t>& start = m_bucketStart[ idx ];
+  start.assign( ( 1 << HASH_BUCKET_BITS ) + 1, 0 );
+
+  for( int i = 0; i < width * height; i++ )
+  {
+    if( blkValid[ i ] )
+    {
+      start[ ( blkHash[ i ] >> ( 32 - HASH_BUCKET_BITS ) ) + 1 ]++;
+    }
+  }
+  for( int b = 0; b < ( 1 << HASH_BUCKET_BITS ); b++ )
+  {
+    start[ b + 1 ] += start[ b ];
+  }
+
+  m_entries[ idx ].resize( start.back() );
+  std::vector<uint32_t> pos( start.begin(), start.end() - 1 );
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int i = y * width + x;
+      if( blkValid[ i ] )
+      {
+        Entry& e = m_entries[ idx ][ pos[ blkHash[ i ] >> ( 32 - HASH_BUCKET_BITS ) ]++ ];
+        e.hash   = blkHash[ i ];
+        e.x      = ( uint16_t ) x;
+        e.y      = ( uint16_t ) y;
+      }
+    }
+  }
+}
+
+void BlockHashMap::create( const CPelBuf& picBuf )
+{
+  const int w = picBuf.width;
+  const int h = picBuf.height;
+
+  clear();
+
+  if( w < MAX_HASH_BLK_SIZE || h < MAX_HASH_BLK_SIZE )
+  {
+    return;
+  }
+
+  std::vector<uint32_t> rowHash( w * h, 0 );
+  std::vector<uint8_t>  rowFlat( w * h, 0 );
+  std::vector<uint32_t> hash4  ( w * h, 0 );
+  std::vector<uint8_t>  flags4 ( w * h, 0 );
+  std::vector<uint32_t> hash8  ( w * h, 0 );
+  std::vector<uint8_t>  valid  ( w * h, 0 );
+
+  for( int y = 0; y < h; y++ )
+  {
+    const Pel* src = picBuf.bufAt( 0, y );
+    for( int x = 0; x + 4 <= w; x++ )
+    {
+      rowHash[ y * w + x ] = xRowHash4( src + x );
+      rowFlat[ y * w + x ] = xRowFlat4( src + x );
+    }
+  }
+
+  for( int y = 0; y + 4 <= h; y++ )
+  {
+    for( int x = 0; x + 4 <= w; x++ )
+    {
+      const int idx  = y * w + x;
+      hash4 [ idx ]  = xHash4x4 ( &rowHash[ idx ], w );
+      flags4[ idx ]  = xFlags4x4( &rowHash[ idx ], &rowFlat[ idx ], w );
+      valid [ idx ]  = !flags4[ idx ];
+    }
+  }
+
+  xBuildTable( 0, hash4, valid, w, h );
+
+  std::fill( valid.begin(), valid.end(), 0 );
+
+  for( int y = 0; y + 8 <= h; y++ )
+  {
+    for( int x = 0; x + 8 <= w; x++ )
+    {
+      const int idx = y * w + x;
+      const uint32_t hs[ 4 ] = { hash4 [ idx ], hash4 [ idx + 4 ], hash4 [ idx + 4 * w ], hash4 [ idx + 4 * w + 4 ] };
+      const uint8_t  fs[ 4 ] = { flags4[ idx ], flags4[ idx + 4 ], flags4[ idx + 4 * w ], flags4[ idx + 4 * w + 4 ] };
+
+      hash8[ idx ] = xHash8x8( hs[ 0 ], hs[ 1 ], hs[ 2 ], hs[ 3 ] );
+      valid[ idx ] = !xFlags8x8( hs, fs );
+    }
+  }
+
+  xBuildTable( 1, hash8, valid, w, h );
+}
+
+} // namespace vvenc
+
+//! \}
+
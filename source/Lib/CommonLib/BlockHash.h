@@ -0,0 +1,119 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     BlockHash.h
+    \brief    block hash table for exact match motion and block vector search (header)
+*/
+
+#pragma once
+
+#include "CommonDef.h"
+#include "Common.h"
+#include "Unit.h"
+
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// CRC based hash table of all luma 4x4 and 8x8 blocks of a picture, maps a block hash to the block positions
+class BlockHashMap
+{
+public:
+  static const int MIN_HASH_BLK_SIZE = 4;
+  static const int MAX_HASH_BLK_SIZE = 8;
+  static const int MAX_NUM_CHECKS    = 32;   // max. number of candidate positions verified per lookup
+
+  struct Entry
+  {
+    uint32_t hash;
+    uint16_t x;
+    uint16_t y;
+  };
+
+  BlockHashMap() {}
+  ~BlockHashMap() {}
+
+  /// hashes all non-uniform blocks of the picture
+  void create               ( const CPelBuf& picBuf );
+  void clear                ();
+  bool empty                () const { return m_entries[ 0 ].empty() && m_entries[ 1 ].empty(); }
+
+  /// returns the range of entries sharing the upper hash bits in raster order, callers have to compare the full hash
+  std::pair<const Entry*, const Entry*> getBucket( const uint32_t hash, const int blkSize ) const;
+
+  /// finds the first non-uniform sub-block of a block, which can serve as lookup key, returns false if there is none
+  static bool getKeyBlock   ( const CPelBuf& blk, const int blkSize, Position& keyPos, uint32_t& keyHash );
+
+private:
+  static const int HASH_BUCKET_BITS  = 16;
+
+  static uint32_t xCrc32c   ( uint32_t crc, uint32_t val );
+  static uint32_t xRowHash4 ( const Pel* src );
+  static uint8_t  xRowFlat4 ( const Pel* src ) { return src[ 0 ] == src[ 1 ] && src[ 0 ] == src[ 2 ] && src[ 0 ] == src[ 3 ]; }
+
+  static uint32_t xHash4x4  ( const uint32_t* rowHash, const ptrdiff_t stride );
+  static uint32_t xHash8x8  ( const uint32_t h0, const uint32_t h1, const uint32_t h2, const uint32_t h3 );
+  static uint8_t  xFlags4x4 ( const uint32_t* rowHash, const uint8_t* rowFlat, const ptrdiff_t stride );
+  static uint8_t  xFlags8x8 ( const uint32_t h[4], const uint8_t f[4] );
+
+  void xBuildTable          ( const int idx, const std::vector<uint32_t>& blkHash, const std::vector<uint8_t>& blkValid, const int width, const int height );
+
+private:
+  // index 0: 4x4 blocks, index 1: 8x8 blocks
+  std::vector<uint32_t> m_bucketStart[ 2 ];
+  std::vector<Entry>    m_entries    [ 2 ];
+};
+
+} // namespace vvenc
+
+//! \}
+
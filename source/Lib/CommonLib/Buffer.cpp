@@ -345,6 +345,203 @@ void applyLutCore( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const pt
 #undef RSP_SGNL_INC
 }
 
+uint64_t AvgHighPassCore( const int width, const int height, const Pel* pSrc, const int iSrcStride )
+{
+  uint64_t saAct = 0;
+
+  pSrc += iSrcStride;
+  for( int y = 1; y < height - 1; y++ )
+  {
+    for( int x = 1; x < width - 1; x++ ) // center cols
+    {
+      const int s = 12 * (int) pSrc[x  ] - 2 * ((int) pSrc[x-1] + (int) pSrc[x+1] + (int) pSrc[x  -iSrcStride] + (int) pSrc[x  +iSrcStride])
+                       - ((int) pSrc[x-1-iSrcStride] + (int) pSrc[x+1-iSrcStride] + (int) pSrc[x-1+iSrcStride] + (int) pSrc[x+1+iSrcStride]);
+      saAct += abs( s );
+    }
+    pSrc += iSrcStride;
+  }
+  return saAct;
+}
+
+uint64_t AvgHighPassWithDownsamplingCore( const int width, const int height, const Pel* pSrc, const int iSrcStride )
+{
+  const int i2ndStride = iSrcStride * 2;
+  const int i3rdStride = iSrcStride * 3;
+  uint64_t saAct = 0;
+
+  pSrc += i2ndStride;
+  for( int y = 2; y < height - 2; y += 2 )
+  {
+    for( int x = 2; x < width - 2; x += 2 ) // cnt cols
+    {
+      const int s = 12 * ((int) pSrc[x             ] + (int) pSrc[x+1           ] + (int) pSrc[x  +iSrcStride] + (int) pSrc[x+1+iSrcStride])
+                   - 3 * ((int) pSrc[x-1           ] + (int) pSrc[x+2           ] + (int) pSrc[x-1+iSrcStride] + (int) pSrc[x+2+iSrcStride]
+                        + (int) pSrc[x  -iSrcStride] + (int) pSrc[x+1-iSrcStride] + (int) pSrc[x  +i2ndStride] + (int) pSrc[x+1+i2ndStride])
+                   - 2 * ((int) pSrc[x-1-iSrcStride] + (int) pSrc[x+2-iSrcStride] + (int) pSrc[x-1+i2ndStride] + (int) pSrc[x+2+i2ndStride])
+                       - ((int) pSrc[x-1-i2ndStride] + (int) pSrc[x  -i2ndStride] + (int) pSrc[x+1-i2ndStride] + (int) pSrc[x+2-i2ndStride]
+                        + (int) pSrc[x-1+i3rdStride] + (int) pSrc[x  +i3rdStride] + (int) pSrc[x+1+i3rdStride] + (int) pSrc[x+2+i3rdStride]
+                        + (int) pSrc[x-2-iSrcStride] + (int) pSrc[x-2           ] + (int) pSrc[x-2+iSrcStride] + (int) pSrc[x-2+i2ndStride]
+                        + (int) pSrc[x+3-iSrcStride] + (int) pSrc[x+3           ] + (int) pSrc[x+3+iSrcStride] + (int) pSrc[x+3+i2ndStride]);
+      saAct += abs( s );
+    }
+    pSrc += i2ndStride;
+  }
+  return saAct;
+}
+
+uint64_t HDHighPassCore( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const int iSrcStride, const int iSM1Stride )
+{
+  uint64_t taAct = 0;
+
+  pSrc += iSrcStride;
+  pSM1 += iSM1Stride;
+  for( int y = 1; y < height - 1; y++ )
+  {
+    for( int x = 1; x < width - 1; x++ ) // cnt cols
+    {
+      const int t = (int) pSrc[x] - (int) pSM1[x];
+
+      taAct += (1 + 3 * abs( t )) >> 1;
+    }
+    pSrc += iSrcStride;
+    pSM1 += iSM1Stride;
+  }
+  return taAct;
+}
+
+uint64_t HDHighPass2Core( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const Pel* pSM2, const int iSrcStride, const int iSM1Stride, const int iSM2Stride )
+{
+  uint64_t taAct = 0;
+
+  pSrc += iSrcStride;
+  pSM1 += iSM1Stride;
+  pSM2 += iSM2Stride;
+  for( int y = 1; y < height - 1; y++ )
+  {
+    for( int x = 1; x < width - 1; x++ ) // cnt cols
+    {
+      const int t = (int) pSrc[x] - 2 * (int) pSM1[x] + (int) pSM2[x];
+
+      taAct += abs( t );
+    }
+    pSrc += iSrcStride;
+    pSM1 += iSM1Stride;
+    pSM2 += iSM2Stride;
+  }
+  return taAct;
+}
+
+uint64_t AvgHighPassWithDownsamplingDiff1stCore( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const int iSrcStride, const int iSM1Stride )
+{
+  const int i2M0Stride = iSrcStride * 2;
+  const int i2M1Stride = iSM1Stride * 2;
+  uint64_t taAct = 0;
+
+  pSrc += i2M0Stride;
+  pSM1 += i2M1Stride;
+  for( int y = 2; y < height - 2; y += 2 )
+  {
+    for( int x = 2; x < width - 2; x += 2 ) // c cols
+    {
+      const int t = (int) pSrc[x] + (int) pSrc[x+1] + (int) pSrc[x+iSrcStride] + (int) pSrc[x+1+iSrcStride]
+                 - ((int) pSM1[x] + (int) pSM1[x+1] + (int) pSM1[x+iSM1Stride] + (int) pSM1[x+1+iSM1Stride]);
+      taAct += (1 + 3 * abs( t )) >> 1;
+    }
+    pSrc += i2M0Stride;
+    pSM1 += i2M1Stride;
+  }
+  return taAct;
+}
+
+uint64_t AvgHighPassWithDownsamplingDiff2ndCore( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const Pel* pSM2, const int iSrcStride, const int iSM1Stride, const int iSM2Stride )
+{
+  const int i2M0Stride = iSrcStride * 2;
+  const int i2M1Stride = iSM1Stride * 2;
+  const int i2M2Stride = iSM2Stride * 2;
+  uint64_t taAct = 0;
+
+  pSrc += i2M0Stride;
+  pSM1 += i2M1Stride;
+  pSM2 += i2M2Stride;
+  for( int y = 2; y < height - 2; y += 2 )
+  {
+    for( int x = 2; x < width - 2; x += 2 ) // c cols
+    {
+      const int t = (int) pSrc[x] + (int) pSrc[x+1] + (int) pSrc[x+iSrcStride] + (int) pSrc[x+1+iSrcStride]
+             - 2 * ((int) pSM1[x] + (int) pSM1[x+1] + (int) pSM1[x+iSM1Stride] + (int) pSM1[x+1+iSM1Stride])
+                  + (int) pSM2[x] + (int) pSM2[x+1] + (int) pSM2[x+iSM2Stride] + (int) pSM2[x+1+iSM2Stride];
+      taAct += abs( t );
+    }
+    pSrc += i2M0Stride;
+    pSM1 += i2M1Stride;
+    pSM2 += i2M2Stride;
+  }
+  return taAct;
+}
+
+int AvgAbsDev4x4Core( const Pel* pSrc, const int iSrcStride, const int width, const int height )
+{
+  int sum = 0;
+  int dev = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      sum += (int) pSrc[y * iSrcStride + x];
+    }
+  }
+  const int size = width * height;
+  const int mean = sum / size;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      dev += abs( mean - (int) pSrc[y * iSrcStride + x] );
+    }
+  }
+  return dev / size;
+}
+
+void addSubColSumsCore( const Pel* addRow, const Pel* subRow, int* colSum, int* colSumSq, const int width )
+{
+  if( addRow )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      colSum  [x] += addRow[x];
+      colSumSq[x] += addRow[x] * addRow[x];
+    }
+  }
+  if( subRow )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      colSum  [x] -= subRow[x];
+      colSumSq[x] -= subRow[x] * subRow[x];
+    }
+  }
+}
+
+void sumAndSumSqCore( const Pel* src, const ptrdiff_t srcStride, const int width, const int height, int64_t* sum, int64_t* sumSq )
+{
+  int64_t s = 0, sq = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      s  += src[x];
+      sq += src[x] * src[x];
+    }
+    src += srcStride;
+  }
+
+  *sum   = s;
+  *sumSq = sq;
+}
+
 void fillMapPtr_Core( void** ptrMap, const ptrdiff_t mapStride, int width, int height, void* val )
 {
   if( width == mapStride )
@@ -406,6 +603,17 @@ PelBufferOps::PelBufferOps()
   applyLut          = applyLutCore;
 
   fillPtrMap        = fillMapPtr_Core;
+
+  AvgHighPass                        = AvgHighPassCore;
+  AvgHighPassWithDownsampling        = AvgHighPassWithDownsamplingCore;
+  HDHighPass                         = HDHighPassCore;
+  HDHighPass2                        = HDHighPass2Core;
+  AvgHighPassWithDownsamplingDiff1st = AvgHighPassWithDownsamplingDiff1stCore;
+  AvgHighPassWithDownsamplingDiff2nd = AvgHighPassWithDownsamplingDiff2ndCore;
+  AvgAbsDev4x4                       = AvgAbsDev4x4Core;
+
+  addSubColSums     = addSubColSumsCore;
+  sumAndSumSq       = sumAndSumSqCore;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
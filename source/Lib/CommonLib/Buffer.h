@@ -115,6 +115,15 @@ struct PelBufferOps
   void ( *weightCiip)     ( Pel* res, const Pel* intra, const int numSamples, int numIntra );
   void ( *applyLut )      ( const Pel* src, const ptrdiff_t srcStride, Pel* dst, ptrdiff_t dstStride, int width, int height, const Pel* lut );
   void ( *fillPtrMap )    ( void** ptrMap, const ptrdiff_t mapStride, int width, int height, void* val );
+  uint64_t ( *AvgHighPass )                       ( const int width, const int height, const Pel* pSrc, const int iSrcStride );
+  uint64_t ( *AvgHighPassWithDownsampling )       ( const int width, const int height, const Pel* pSrc, const int iSrcStride );
+  uint64_t ( *HDHighPass )                        ( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const int iSrcStride, const int iSM1Stride );
+  uint64_t ( *HDHighPass2 )                       ( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const Pel* pSM2, const int iSrcStride, const int iSM1Stride, const int iSM2Stride );
+  uint64_t ( *AvgHighPassWithDownsamplingDiff1st )( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const int iSrcStride, const int iSM1Stride );
+  uint64_t ( *AvgHighPassWithDownsamplingDiff2nd )( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const Pel* pSM2, const int iSrcStride, const int iSM1Stride, const int iSM2Stride );
+  int      ( *AvgAbsDev4x4 )                      ( const Pel* pSrc, const int iSrcStride, const int width, const int height );
+  void ( *addSubColSums )  ( const Pel* addRow, const Pel* subRow, int* colSum, int* colSumSq, const int width );
+  void ( *sumAndSumSq )    ( const Pel* src, const ptrdiff_t srcStride, const int width, const int height, int64_t* sum, int64_t* sumSq );
 };
 
 extern PelBufferOps g_pelBufOP;
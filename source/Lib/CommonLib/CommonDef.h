@@ -699,6 +699,7 @@ typedef enum {
   AVX512
 } X86_VEXT;
 
+X86_VEXT _get_x86_extensions();
 X86_VEXT read_x86_extension_flags(const std::string &extStrId = std::string());
 const char* read_x86_extension(const std::string &extStrId);
 #endif
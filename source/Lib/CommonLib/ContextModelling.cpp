@@ -136,11 +136,11 @@ void CoeffCodingContext::initSubblock( int SubsetId, bool sigGroupFlag )
 }
 
 
-void DeriveCtx::determineNeighborCus( const CodingStructure& cs, const UnitArea& ua, const ChannelType ch, const TreeType _treeType )
+void DeriveCtx::determineNeighborCus( const CodingStructure& cs, const UnitArea& ua, const ChannelType ch, const TreeType _treeType, const Slice* slice )
 {
   const Position& posLuma    = ua.lumaPos();
   const Position& pos        = ch == CH_L ? posLuma : ua.chromaPos();
-  const uint32_t curSliceIdx = cs.slice->independentSliceIdx;
+  const uint32_t curSliceIdx = slice ? slice->independentSliceIdx : cs.slice->independentSliceIdx;
   const uint32_t curTileIdx  = cs.pps->getTileIdx( posLuma );
 
   cuRestrictedLeft[ch]  = cs.getCURestricted( pos.offset(-1, 0), pos, curSliceIdx, curTileIdx, ch, _treeType );
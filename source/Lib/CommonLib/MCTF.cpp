@@ -232,6 +232,7 @@ void MCTF::init( const int internalBitDepth[MAX_NUM_CH],
                  const int qp,
                  const vvencMCTF MCTFCfg,
                  const int framesToBeEncoded,
+                 const bool storeMotion,
                  NoMallocThreadPool* threadPool)
 {
   CHECK( MCTFCfg.numFrames != MCTFCfg.numStrength, "should have been checked before" );
@@ -257,6 +258,7 @@ void MCTF::init( const int internalBitDepth[MAX_NUM_CH],
   m_numLeadFrames         = MCTFCfg.MCTFNumLeadFrames;
   m_numTrailFrames        = MCTFCfg.MCTFNumTrailFrames;
   m_framesToBeEncoded     = framesToBeEncoded;
+  m_storeMotion           = storeMotion;
   m_threadPool            = threadPool;
 
   const uint8_t             acMCTFSpeedVal[] = {0, 5, 6, 22, 26 }; 
@@ -343,8 +345,8 @@ void MCTF::filter( Picture* pic )
     m_picFifo.push_back( pic );
   }
 
-  // update current process poc
-  const int process_poc = m_filterFutureReference ? m_input_cnt - ( m_numLeadFrames + m_range ) : m_input_cnt - ( m_numLeadFrames + m_range - 1 );
+  // update current process poc, without future references the picture is filtered right away using past pictures only
+  const int process_poc = m_filterFutureReference ? m_input_cnt - ( m_numLeadFrames + m_range ) : m_input_cnt - m_numLeadFrames;
   m_input_cnt += 1;
 
   // update resulting delay
@@ -449,11 +451,38 @@ void MCTF::filter( Picture* pic )
       }
 
       srcPic.index = std::min(1, std::abs(curPic->poc - process_poc) - 1);
+      srcPic.poc   = curPic->poc;
     }
 
     // filter
     fltrBuf.create( m_chromaFormatIDC, m_area, 0, m_padding );
     bilateralFilter( origBuf, srcFrameInfo, fltrBuf, overallStrength );
+
+    // keep the motion fields as start candidates for the motion estimation of the encoder
+    if( m_storeMotion )
+    {
+      const int blkSize = 8;
+      const int numX    = m_area.width  / blkSize;
+      const int numY    = m_area.height / blkSize;
+
+      fltrPic->mctfMotion.resize( srcFrameInfo.size() );
+      for( int i = 0; i < srcFrameInfo.size(); i++ )
+      {
+        MctfMotionField& field = fltrPic->mctfMotion[ i ];
+        field.refPoc  = srcFrameInfo[ i ].poc;
+        field.blkSize = blkSize;
+        field.stride  = numX;
+        field.mvs.resize( numX * numY );
+        for( int y = 0; y < numY; y++ )
+        {
+          for( int x = 0; x < numX; x++ )
+          {
+            const MotionVector& mv = srcFrameInfo[ i ].mvs.get( x, y );
+            field.mvs[ y * numX + x ].set( mv.x, mv.y );
+          }
+        }
+      }
+    }
   }
 
   fltrPic->isMctfProcessed = true;
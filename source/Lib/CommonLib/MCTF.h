@@ -105,10 +105,11 @@ public:
 
 struct TemporalFilterSourcePicInfo
 {
-  TemporalFilterSourcePicInfo() : picBuffer(), mvs(), index(0) { }
+  TemporalFilterSourcePicInfo() : picBuffer(), mvs(), index(0), poc(0) { }
   PelStorage            picBuffer;
   Array2D<MotionVector> mvs;
   int                   index;
+  int                   poc;
 };
 
 // ====================================================================================================================
@@ -131,6 +132,7 @@ public:
              const int qp,
              const vvencMCTF MCTFCfg,
              const int framesToBeEncoded,
+             const bool storeMotion,
              NoMallocThreadPool* threadPool );
   void uninit();
 
@@ -185,6 +187,7 @@ private:
   int                   m_numTrailFrames;
   int                   m_framesToBeEncoded;
   int                   m_MCTFSpeedVal;
+  bool                  m_storeMotion;
   NoMallocThreadPool*   m_threadPool;
 
   std::deque<Picture*>  m_picFifo;
@@ -51,6 +51,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Picture.h"
 #include "SEI.h"
+#include "InterpolationFilter.h"
 
 #include <math.h>
 
@@ -93,9 +94,11 @@ void BlkStat::updateMaxBT( const Slice& slice, const BlkStat& blkStat )
 {
   if ( ! slice.isIRAP() )
   {
+    // keep statistics of the last finished picture per layer, pictures are finished in coding order,
+    // thus independent of the number of pictures encoded in parallel
     const int refLayer = slice.depth < NUM_AMAXBT_LAYER ? slice.depth: NUM_AMAXBT_LAYER - 1;
-    m_uiBlkSize[ refLayer ] += blkStat.m_uiBlkSize[ refLayer ];
-    m_uiNumBlk [ refLayer ] += blkStat.m_uiNumBlk [ refLayer ];
+    m_uiBlkSize[ refLayer ] = blkStat.m_uiBlkSize[ refLayer ];
+    m_uiNumBlk [ refLayer ] = blkStat.m_uiNumBlk [ refLayer ];
   }
 }
 
@@ -127,9 +130,6 @@ void BlkStat::setSliceMaxBT( Slice& slice )
       {
         slice.picHeader->maxBTSize[1] = ( 128 > MAX_BT_SIZE_INTER ? MAX_BT_SIZE_INTER : 128 );
       }
-
-      m_uiBlkSize[ refLayer ] = 0;
-      m_uiNumBlk [ refLayer ] = 0;
     }
   }
   else
@@ -146,6 +146,116 @@ void BlkStat::setSliceMaxBT( Slice& slice )
 }
 
 
+// ====================================================================================================================
+// half-sample reference planes
+// ====================================================================================================================
+
+void HalfPelPlanes::destroy()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  for( auto& plane : m_planes )
+  {
+    plane.destroy();
+  }
+  std::vector<std::atomic_bool>().swap( m_rowDone );
+  m_numRows = 0;
+}
+
+void HalfPelPlanes::reset()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  for( auto& rowDone : m_rowDone )
+  {
+    rowDone = false;
+  }
+}
+
+void HalfPelPlanes::fill( const CPelBuf& reco, unsigned margin, unsigned ctuSize, InterpolationFilter& interpFilter, const ClpRng& clpRng, int yStart, int yEnd ) const
+{
+  const int numRows  = ( reco.height + ctuSize - 1 ) / ctuSize;
+  const int rowStart = Clip3<int>( 0, numRows - 1, yStart / ( int ) ctuSize );
+  const int rowEnd   = Clip3<int>( 0, numRows - 1, yEnd   / ( int ) ctuSize );
+
+  if( m_numRows )
+  {
+    bool allDone = true;
+    for( int row = rowStart; row <= rowEnd && allDone; row++ )
+    {
+      allDone = m_rowDone[ row ];
+    }
+    if( allDone )
+    {
+      return;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  if( !m_numRows )
+  {
+    m_ctuSize = ctuSize;
+    m_margin  = margin;
+    for( auto& plane : m_planes )
+    {
+      plane.create( CHROMA_400, Area( 0, 0, reco.width, reco.height ), ctuSize, margin, MEMORY_ALIGN_DEF_SIZE );
+    }
+    CHECK( m_planes[ HPEL_HOR ].Y().stride != reco.stride, "half-sample planes need the stride of the reconstruction" );
+    std::vector<std::atomic_bool>( numRows ).swap( m_rowDone );
+    for( auto& rowDone : m_rowDone )
+    {
+      rowDone = false;
+    }
+    m_numRows = numRows;
+  }
+
+  for( int row = rowStart; row <= rowEnd; row++ )
+  {
+    if( !m_rowDone[ row ] )
+    {
+      xFillRow( reco, interpFilter, clpRng, row );
+      m_rowDone[ row ] = true;
+    }
+  }
+}
+
+void HalfPelPlanes::xFillRow( const CPelBuf& reco, InterpolationFilter& interpFilter, const ClpRng& clpRng, int row ) const
+{
+  // the first and last row also cover the picture margin, reduced by the filter support
+  const int numRows   = m_numRows;
+  const int halfTaps  = NTAPS_LUMA >> 1;
+  const int border    = ( int ) m_margin - halfTaps;
+  const int xStart    = -border;
+  const int width     = reco.width + 2 * border;
+  const int yStart    = row == 0           ? -border                : row * ( int ) m_ctuSize;
+  const int yEnd      = row == numRows - 1 ? reco.height + border   : ( row + 1 ) * ( int ) m_ctuSize;
+  const int height    = yEnd - yStart;
+
+  // horizontal intermediates including the rows needed by the vertical filter
+  const int tmpHeight = height + NTAPS_LUMA;
+  const int tmpStride = width;
+  std::vector<Pel> tmpInt( tmpStride * tmpHeight );
+  std::vector<Pel> tmpHor( tmpStride * tmpHeight );
+
+  const Pel* src = reco.bufAt( xStart, yStart - halfTaps );
+  interpFilter.filterHor( COMP_Y, src, reco.stride, &tmpInt[0], tmpStride, width, tmpHeight, 0 << MV_FRACTIONAL_BITS_DIFF, false, CHROMA_400, clpRng );
+  interpFilter.filterHor( COMP_Y, src, reco.stride, &tmpHor[0], tmpStride, width, tmpHeight, 2 << MV_FRACTIONAL_BITS_DIFF, false, CHROMA_400, clpRng );
+
+  const int stride = m_planes[ HPEL_HOR ].Y().stride;
+  Pel* dstHor      = m_planes[ HPEL_HOR     ].Y().bufAt( xStart, yStart );
+  Pel* dstVer      = m_planes[ HPEL_VER     ].Y().bufAt( xStart, yStart );
+  Pel* dstHorVer   = m_planes[ HPEL_HOR_VER ].Y().bufAt( xStart, yStart );
+
+  interpFilter.filterVer( COMP_Y, &tmpHor[ halfTaps * tmpStride ],       tmpStride, dstHor,    stride, width, height, 0 << MV_FRACTIONAL_BITS_DIFF, false, true, CHROMA_400, clpRng );
+  interpFilter.filterVer( COMP_Y, &tmpInt[ halfTaps * tmpStride ],       tmpStride, dstVer,    stride, width, height, 2 << MV_FRACTIONAL_BITS_DIFF, false, true, CHROMA_400, clpRng );
+  interpFilter.filterVer( COMP_Y, &tmpHor[ halfTaps * tmpStride ],       tmpStride, dstHorVer, stride, width, height, 2 << MV_FRACTIONAL_BITS_DIFF, false, true, CHROMA_400, clpRng );
+
+  for( int y = 0; y < height; y++ )
+  {
+    memcpy( m_planes[ HPEL_TMP_INT ].Y().bufAt( xStart, yStart + y ), &tmpInt[ ( y + halfTaps ) * tmpStride ], width * sizeof( Pel ) );
+    memcpy( m_planes[ HPEL_TMP_HOR ].Y().bufAt( xStart, yStart + y ), &tmpHor[ ( y + halfTaps ) * tmpStride ], width * sizeof( Pel ) );
+  }
+}
+
 // ====================================================================================================================
 // Picture
 // ====================================================================================================================
@@ -171,15 +281,20 @@ Picture::Picture()
     , poc               ( 0 )
     , gopId             ( 0 )
     , rcIdxInGop        ( 0 )
+    , codingOrderIdx    ( -1 )
+    , refAncestorMask   ( 0 )
+    , cabacTableIdxEst  ( VVENC_I_SLICE )
     , TLayer            ( std::numeric_limits<uint32_t>::max() )
     , layerId           ( 0 )
     , isSubPicBorderSaved (false)
     , sliceDataNumBins  ( 0 )
+    , numSlicesWritten  ( 0 )
     , cts               ( 0 )
     , ctsValid          ( false )
     , m_bufsOrigPrev    { nullptr, nullptr }
     , picInitialQP      ( 0 )
     , picVisActY        ( 0.0 )
+    , speedLevel        ( 0 )
     , useScME           ( false )
     , useScMCTF         ( false )
     , useScTS           ( false )
@@ -191,6 +306,9 @@ Picture::Picture()
     , actualTotalBits   ( 0 )
     , encRCPic          ( nullptr )
 {
+  std::fill_n( alfApsSrcIdx, ALF_CTB_MAX_NUM_APS, -1 );
+  std::fill_n( saoDisabledRateIdx, VVENC_MAX_TLAYER, -1 );
+  ::memset( saoDisabledRate, 0, sizeof( saoDisabledRate ) );
 }
 
 void Picture::create( ChromaFormat _chromaFormat, const Size& size, unsigned _maxCUSize, unsigned _margin, bool _decoder, int _padding )
@@ -217,6 +335,8 @@ void Picture::destroy()
   {
     m_bufs[  t ].destroy();
   }
+  halfPelPlanes.destroy();
+  blockHashMap.clear();
   if( cs )
   {
     cs->picHeader = nullptr;
@@ -482,6 +602,149 @@ void Picture::resizeAlfCtuBuffers( int numEntries )
   }
 }
 
+bool Picture::getMctfMv( const Position& pos, const int refPoc, Mv& mv ) const
+{
+  // use the motion field towards the closest neighbour in the direction of the reference picture
+  const int refDist = refPoc - poc;
+  const MctfMotionField* field = nullptr;
+  for( const auto& cand : mctfMotion )
+  {
+    const int dist = cand.refPoc - poc;
+    if( dist * refDist > 0 && ( !field || abs( refDist - dist ) < abs( refDist - ( field->refPoc - poc ) ) ) )
+    {
+      field = &cand;
+    }
+  }
+
+  if( !field )
+  {
+    return false;
+  }
+
+  const int numRows = int( field->mvs.size() ) / field->stride;
+  const int blkX    = std::min( pos.x / field->blkSize, field->stride - 1 );
+  const int blkY    = std::min( pos.y / field->blkSize, numRows - 1 );
+  mv = field->mvs[ blkY * field->stride + blkX ];
+
+  // scale to the distance of the reference picture
+  const int dist = field->refPoc - poc;
+  if( dist != refDist )
+  {
+    mv.set( mv.hor * refDist / dist, mv.ver * refDist / dist );
+  }
+  return true;
+}
+
+bool Picture::getLookaheadMv( const Position& pos, const int refPoc, Mv& mv ) const
+{
+  // the lookahead motion points to the previous input picture, assume linear motion for other references
+  const MctfMotionField& field = lookahead.motion;
+  if( field.refPoc < 0 || field.mvs.empty() || refPoc == poc )
+  {
+    return false;
+  }
+
+  const int numRows = int( field.mvs.size() ) / field.stride;
+  const int blkX    = std::min( pos.x / field.blkSize, field.stride - 1 );
+  const int blkY    = std::min( pos.y / field.blkSize, numRows - 1 );
+  mv = field.mvs[ blkY * field.stride + blkX ];
+
+  const int refDist = refPoc - poc;
+  const int dist    = field.refPoc - poc;
+  if( dist != refDist )
+  {
+    mv.set( mv.hor * refDist / dist, mv.ver * refDist / dist );
+  }
+  return true;
+}
+
+bool Picture::getAnalysisMv( const Position& pos, const int refPoc, Mv& mv ) const
+{
+  // motion of the loaded analysis, scaled if the coding unit used another reference picture in the same direction
+  const AnalysisCu* aCu = analysis.getCu( pos );
+  if( !aCu || aCu->predMode != MODE_INTER || ( aCu->flags & ( AnalysisCu::AFFINE | AnalysisCu::GEO ) ) || refPoc == poc )
+  {
+    return false;
+  }
+
+  const int refDist = refPoc - poc;
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    const int dist = aCu->refPoc[ l ] - poc;
+    if( ( aCu->interDir & ( 1 << l ) ) && dist * refDist > 0 )
+    {
+      mv = aCu->mv[ l ];
+      if( dist != refDist )
+      {
+        mv.set( mv.hor * refDist / dist, mv.ver * refDist / dist );
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void PicAnalysis::store( const CodingStructure& cs )
+{
+  reset();
+  poc = cs.picture->poc;
+
+  for( const CodingUnit* cu : cs.cus )
+  {
+    if( cu->chType != CH_L )
+    {
+      continue;
+    }
+
+    const bool inter = cu->predMode == MODE_INTER;
+    AnalysisCu aCu;
+    aCu.x           = cu->lx();
+    aCu.y           = cu->ly();
+    aCu.width       = cu->lwidth();
+    aCu.height      = cu->lheight();
+    aCu.depth       = cu->depth;
+    aCu.predMode    = cu->predMode;
+    aCu.flags       = ( cu->skip ? AnalysisCu::SKIP : 0 ) | ( cu->mergeFlag ? AnalysisCu::MERGE : 0 ) | ( cu->affine ? AnalysisCu::AFFINE : 0 ) | ( cu->geo ? AnalysisCu::GEO : 0 );
+    aCu.intraDir    = cu->predMode == MODE_INTRA ? cu->intraDir[ CH_L ] : 0;
+    aCu.interDir    = inter ? cu->interDir : 0;
+    for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+    {
+      const bool used = inter && ( cu->interDir & ( 1 << l ) );
+      aCu.refPoc[ l ] = used ? cu->slice->getRefPOC( RefPicList( l ), cu->refIdx[ l ] ) : -1;
+      aCu.mv    [ l ] = used ? cu->mv[ l ][ 0 ] : Mv();
+    }
+    aCu.splitSeries = cu->splitSeries;
+    cus.push_back( aCu );
+  }
+}
+
+void PicAnalysis::buildMap( const Size& lumaSize )
+{
+  mapStride = ( lumaSize.width + 3 ) >> 2;
+  cuMap.assign( mapStride * ( ( lumaSize.height + 3 ) >> 2 ), -1 );
+
+  for( int i = 0; i < (int)cus.size(); i++ )
+  {
+    const AnalysisCu& aCu = cus[ i ];
+    const int x1 = ( std::min<int>( aCu.x + aCu.width,  lumaSize.width  ) + 3 ) >> 2;
+    const int y1 = ( std::min<int>( aCu.y + aCu.height, lumaSize.height ) + 3 ) >> 2;
+    for( int y = aCu.y >> 2; y < y1; y++ )
+    {
+      std::fill( &cuMap[ y * mapStride + ( aCu.x >> 2 ) ], &cuMap[ y * mapStride + x1 ], i );
+    }
+  }
+}
+
+const AnalysisCu* PicAnalysis::getCu( const Position& pos ) const
+{
+  if( cuMap.empty() || pos.x < 0 || pos.y < 0 || ( pos.x >> 2 ) >= mapStride )
+  {
+    return nullptr;
+  }
+
+  const size_t idx = ( pos.y >> 2 ) * mapStride + ( pos.x >> 2 );
+  return idx < cuMap.size() && cuMap[ idx ] >= 0 ? &cus[ cuMap[ idx ] ] : nullptr;
+}
 
 } // namespace vvenc
 
@@ -56,6 +56,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include "CodingStructure.h"
 #include "BitStream.h"
 #include "Reshape.h"
+#include "BlockHash.h"
 
 #include <deque>
 #include <chrono>
@@ -69,6 +70,7 @@ namespace vvenc {
 class SEI;
 class SEIDecodedPictureHash;
 class EncRCPic;
+class InterpolationFilter;
 
 typedef std::list<SEI*> SEIMessages;
 
@@ -140,6 +142,128 @@ protected:
   bool     m_bResetAMaxBT;
 };
 
+enum HalfPelPlaneType
+{
+  HPEL_HOR = 0,     // luma at ( x + 1/2, y )
+  HPEL_VER,         // luma at ( x, y + 1/2 )
+  HPEL_HOR_VER,     // luma at ( x + 1/2, y + 1/2 )
+  HPEL_TMP_INT,     // horizontal filter intermediate at ( x, y )
+  HPEL_TMP_HOR,     // horizontal filter intermediate at ( x + 1/2, y )
+  NUM_HPEL_PLANES
+};
+
+/// half-sample interpolated luma planes of a reference picture, filled lazily per CTU row and shared by all threads
+class HalfPelPlanes
+{
+public:
+  HalfPelPlanes() : m_numRows( 0 ), m_ctuSize( 0 ), m_margin( 0 ) {}
+
+  void destroy();
+  void reset();
+
+  // makes sure the planes are available for the luma rows yStart..yEnd, may be called concurrently
+  void fill( const CPelBuf& reco, unsigned margin, unsigned ctuSize, InterpolationFilter& interpFilter, const ClpRng& clpRng, int yStart, int yEnd ) const;
+
+  const Pel* getBuf( HalfPelPlaneType type, const Position& pos ) const { return m_planes[ type ].Y().bufAt( pos.x, pos.y ); }
+  int        getStride()                                          const { return m_planes[ HPEL_HOR ].Y().stride; }
+
+private:
+  void xFillRow( const CPelBuf& reco, InterpolationFilter& interpFilter, const ClpRng& clpRng, int row ) const;
+
+  mutable PelStorage                     m_planes[ NUM_HPEL_PLANES ];
+  mutable std::vector<std::atomic_bool>  m_rowDone;
+  mutable std::mutex                     m_mutex;
+  mutable std::atomic_int                m_numRows;
+  mutable unsigned                       m_ctuSize;
+  mutable unsigned                       m_margin;
+};
+
+struct MctfMotionField
+{
+  int             refPoc;
+  int             blkSize;
+  int             stride;
+  std::vector<Mv> mvs;      // luma motion per blkSize x blkSize block in raster order, internal mv precision
+};
+
+struct LookaheadStats
+{
+  LookaheadStats() { reset(); }
+
+  void reset()
+  {
+    isValid      = false;
+    numBlkX      = 0;
+    numBlkY      = 0;
+    sumIntraCost = 0;
+    sumInterCost = 0;
+    spatialAct   = 0.0;
+    temporalAct  = 0.0;
+    intraCost.clear();
+    interCost.clear();
+    motion.refPoc = -1;
+    motion.mvs.clear();
+  }
+
+  bool                  isValid;
+  int                   numBlkX;
+  int                   numBlkY;
+  std::vector<uint32_t> intraCost;    // luma SATD of the best intra estimate per block of the low resolution picture
+  std::vector<uint32_t> interCost;    // luma SATD of the motion compensated estimate from the previous input picture
+  uint64_t              sumIntraCost;
+  uint64_t              sumInterCost; // sum of the per block minimum of intra and inter cost, equals sumIntraCost without previous picture
+  double                spatialAct;   // mean absolute high-pass of the low resolution picture
+  double                temporalAct;  // mean absolute difference to the low resolution previous input picture
+  MctfMotionField       motion;       // full resolution motion per block towards the previous input picture, refPoc -1 if not available
+};
+
+struct AnalysisCu
+{
+  enum Flags
+  {
+    SKIP   = 1 << 0,
+    MERGE  = 1 << 1,
+    AFFINE = 1 << 2,
+    GEO    = 1 << 3,
+  };
+
+  uint16_t    x;
+  uint16_t    y;
+  uint8_t     width;
+  uint8_t     height;
+  uint8_t     depth;
+  uint8_t     predMode;
+  uint8_t     flags;
+  uint8_t     intraDir;
+  uint8_t     interDir;
+  int32_t     refPoc[ NUM_REF_PIC_LIST_01 ];
+  Mv          mv    [ NUM_REF_PIC_LIST_01 ];
+  SplitSeries splitSeries;
+};
+
+struct PicAnalysis
+{
+  PicAnalysis() { reset(); }
+
+  void reset()
+  {
+    poc       = -1;
+    mapStride = 0;
+    cus.clear();
+    cuMap.clear();
+  }
+
+  bool              isValid() const { return !cuMap.empty(); }
+  void              store   ( const CodingStructure& cs );
+  void              buildMap( const Size& lumaSize );
+  const AnalysisCu* getCu   ( const Position& pos ) const;
+
+  int                     poc;
+  std::vector<AnalysisCu> cus;        // luma coding units of the picture in coding order
+  int                     mapStride;
+  std::vector<int>        cuMap;      // index into cus per 4x4 luma block, built when loaded only
+};
+
 struct Picture : public UnitArea
 {
   uint32_t margin;
@@ -229,10 +353,17 @@ public:
   int                           poc;
   int                           gopId;
   int                           rcIdxInGop;
+  int                           codingOrderIdx;
+  uint64_t                      refAncestorMask;  // bit k set: picture coded k+1 pictures earlier is a (transitive) reference
+  int                           alfApsSrcIdx[ ALF_CTB_MAX_NUM_APS ]; // frame parallel ALF temporal prediction: coding index of picture providing each APS slot
+  double                        saoDisabledRate[ MAX_NUM_COMP ][ VVENC_MAX_TLAYER ]; // SAO disabled rate per layer, inherited from the reference pictures
+  int                           saoDisabledRateIdx[ VVENC_MAX_TLAYER ];               // coding order index of the picture providing the rate of each layer
+  SliceType                     cabacTableIdxEst; // CABAC init table estimated as best after encoding, predicts the table of following pictures
   unsigned                      TLayer;
   int                           layerId;
   bool                          isSubPicBorderSaved;
   int                           sliceDataNumBins;
+  int                           numSlicesWritten; // slices already written during encoding (slice streaming)
   uint64_t                      cts;
   bool                          ctsValid;
 
@@ -245,6 +376,7 @@ public:
   int                           picInitialQP;
   double                        picVisActY;
   StopClock                     encTime;
+  int                           speedLevel;
   bool                          useScME;
   bool                          useScMCTF;
   bool                          useScTS;
@@ -261,6 +393,12 @@ public:
   std::vector<short>            m_alfCtbFilterIndex;
   std::vector<uint8_t>          m_alfCtuAlternative[ MAX_NUM_COMP ];
 
+  std::vector<MctfMotionField>  mctfMotion;
+  HalfPelPlanes                 halfPelPlanes;
+  BlockHashMap                  blockHashMap;
+  LookaheadStats                lookahead;
+  PicAnalysis                   analysis;
+
 public:
   Slice*          allocateNewSlice();
   Slice*          swapSliceObject( Slice* p, uint32_t i );
@@ -270,6 +408,10 @@ public:
   void            copySAO   (const Picture& src, int dstid)  { std::copy(src.m_sao[0].begin(), src.m_sao[0].end(), m_sao[dstid].begin()); }
 
   void            resizeAlfCtuBuffers( int numEntries );
+
+  bool            getMctfMv ( const Position& pos, const int refPoc, Mv& mv ) const;
+  bool            getLookaheadMv( const Position& pos, const int refPoc, Mv& mv ) const;
+  bool            getAnalysisMv ( const Position& pos, const int refPoc, Mv& mv ) const;
 };
 
 int calcAndPrintHashStatus(const CPelUnitBuf& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, const vvencMsgLevel msgl);
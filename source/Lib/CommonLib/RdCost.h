@@ -108,8 +108,15 @@ public:
 };
 
 /// RD cost computation class
+#ifdef TARGET_SIMD_X86
+class KernelTuning;
+#endif
+
 class RdCost
 {
+#ifdef TARGET_SIMD_X86
+  friend class KernelTuning;
+#endif
 private:
   // for distortion
 
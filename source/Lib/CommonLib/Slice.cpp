@@ -1839,6 +1839,42 @@ void PPS::initRectSlices()
   rectSlices.resize(numSlicesInPic);
 }
 
+/**
+ - derive the CTU maps of all rectangular slices in the picture
+ */
+void PPS::initRectSliceMap()
+{
+  sliceMap.clear();
+  sliceMap.resize( numSlicesInPic );
+  for( uint32_t i = 0; i < numSlicesInPic; i++ )
+  {
+    const RectSlice& rectSlice = rectSlices[ i ];
+    const uint32_t   tileX     = rectSlice.tileIdx % numTileCols;
+    const uint32_t   tileY     = rectSlice.tileIdx / numTileCols;
+    sliceMap[ i ].sliceID      = i;
+    if( rectSlice.numSlicesInTile > 1 )
+    {
+      // multiple slices within a single tile, slices are stacked vertically inside the tile
+      uint32_t ctuY = tileRowBd[ tileY ];
+      for( uint32_t j = i; j > 0 && rectSlices[ j - 1 ].tileIdx == rectSlice.tileIdx; j-- )
+      {
+        ctuY += rectSlices[ j - 1 ].sliceHeightInCtu;
+      }
+      sliceMap[ i ].addCtusToSlice( tileColBd[ tileX ], tileColBd[ tileX + 1 ], ctuY, ctuY + rectSlice.sliceHeightInCtu, picWidthInCtu );
+    }
+    else
+    {
+      for( uint32_t j = 0; j < rectSlice.sliceHeightInTiles; j++ )
+      {
+        for( uint32_t k = 0; k < rectSlice.sliceWidthInTiles; k++ )
+        {
+          sliceMap[ i ].addCtusToSlice( tileColBd[ tileX + k ], tileColBd[ tileX + k + 1 ], tileRowBd[ tileY + j ], tileRowBd[ tileY + j + 1 ], picWidthInCtu );
+        }
+      }
+    }
+  }
+}
+
 
 int Slice::getNumEntryPoints( const SPS& sps, const PPS& pps ) const
 {
@@ -970,6 +970,7 @@ public:
   void resetTileSliceInfo();
   void initTiles();
   void initRectSlices();
+  void initRectSliceMap();
 
 };
 
@@ -1443,6 +1443,176 @@ void simdFilterBlkCcAlf<AVX2>( const PelBuf &dstBuf, const CPelUnitBuf &recSrc,
 
 #endif
 
+static inline int simdHsum4x32( __m128i mmacc )
+{
+  mmacc = _mm_hadd_epi32( mmacc, mmacc );
+  mmacc = _mm_hadd_epi32( mmacc, mmacc );
+  return _mm_cvtsi128_si32( mmacc );
+}
+
+template<X86_VEXT vext>
+static void simdCalcCovLin4x4( const Pel* ELocal, const Pel* yLocal, const int numCoeff, double E[MAX_NUM_ALF_LUMA_COEFF][MAX_NUM_ALF_LUMA_COEFF], double* y, double& pixAcc )
+{
+#if USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i mylocal = _mm256_loadu_si256( ( const __m256i* ) yLocal );
+
+    for( int k = 0; k < numCoeff; k++ )
+    {
+      const __m256i melocalk = _mm256_loadu_si256( ( const __m256i* ) &ELocal[k << 4] );
+      double* cov = &E[k][k];
+      int l = k;
+
+      for( ; l + 1 < numCoeff; l += 2 )
+      {
+        const __m256i mmacc0 = _mm256_madd_epi16( melocalk, _mm256_loadu_si256( ( const __m256i* ) &ELocal[( l + 0 ) << 4] ) );
+        const __m256i mmacc1 = _mm256_madd_epi16( melocalk, _mm256_loadu_si256( ( const __m256i* ) &ELocal[( l + 1 ) << 4] ) );
+
+        // lanes 0,1 hold the partial sums for l, lanes 2,3 for l + 1
+        const __m256i mmhadd = _mm256_hadd_epi32( mmacc0, mmacc1 );
+        __m128i       mmacc  = _mm_add_epi32( _mm256_castsi256_si128( mmhadd ), _mm256_extracti128_si256( mmhadd, 1 ) );
+        mmacc = _mm_hadd_epi32( mmacc, mmacc );
+
+        *cov++ += _mm_cvtsi128_si32( mmacc );
+        *cov++ += _mm_extract_epi32( mmacc, 1 );
+      }
+
+      if( l < numCoeff )
+      {
+        const __m256i mmacc = _mm256_madd_epi16( melocalk, _mm256_loadu_si256( ( const __m256i* ) &ELocal[l << 4] ) );
+
+        *cov += simdHsum4x32( _mm_add_epi32( _mm256_castsi256_si128( mmacc ), _mm256_extracti128_si256( mmacc, 1 ) ) );
+      }
+
+      const __m256i mmacc = _mm256_madd_epi16( melocalk, mylocal );
+
+      y[k] += simdHsum4x32( _mm_add_epi32( _mm256_castsi256_si128( mmacc ), _mm256_extracti128_si256( mmacc, 1 ) ) );
+    }
+
+    const __m256i mmacc = _mm256_madd_epi16( mylocal, mylocal );
+
+    pixAcc += simdHsum4x32( _mm_add_epi32( _mm256_castsi256_si128( mmacc ), _mm256_extracti128_si256( mmacc, 1 ) ) );
+
+    _mm256_zeroupper();
+  }
+  else
+#endif
+  {
+    const __m128i mylocal0 = _mm_loadu_si128( ( const __m128i* ) &yLocal[0] );
+    const __m128i mylocal8 = _mm_loadu_si128( ( const __m128i* ) &yLocal[8] );
+
+    for( int k = 0; k < numCoeff; k++ )
+    {
+      const Pel* Elocalk = &ELocal[k << 4];
+      double* cov = &E[k][k];
+
+      const __m128i melocalk0 = _mm_loadu_si128( ( const __m128i* ) &Elocalk[0] );
+      const __m128i melocalk8 = _mm_loadu_si128( ( const __m128i* ) &Elocalk[8] );
+
+      for( int l = k; l < numCoeff; l++ )
+      {
+        const Pel* Elocall = &ELocal[l << 4];
+
+        const __m128i melocall0 = _mm_loadu_si128( ( const __m128i* ) &Elocall[0] );
+        const __m128i melocall8 = _mm_loadu_si128( ( const __m128i* ) &Elocall[8] );
+
+        const __m128i mmacc0 = _mm_madd_epi16( melocalk0, melocall0 );
+        const __m128i mmacc8 = _mm_madd_epi16( melocalk8, melocall8 );
+
+        *cov++ += simdHsum4x32( _mm_add_epi32( mmacc0, mmacc8 ) );
+      }
+
+      const __m128i mmacc0 = _mm_madd_epi16( melocalk0, mylocal0 );
+      const __m128i mmacc8 = _mm_madd_epi16( melocalk8, mylocal8 );
+
+      y[k] += simdHsum4x32( _mm_add_epi32( mmacc0, mmacc8 ) );
+    }
+
+    const __m128i mmacc0 = _mm_madd_epi16( mylocal0, mylocal0 );
+    const __m128i mmacc8 = _mm_madd_epi16( mylocal8, mylocal8 );
+
+    pixAcc += simdHsum4x32( _mm_add_epi32( mmacc0, mmacc8 ) );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdCalcCovNonLin( const int ELocal[MAX_NUM_ALF_LUMA_COEFF][AdaptiveLoopFilter::MaxAlfNumClippingValues], const int yLocal, const double weight, const int numCoeff,
+                               double (**E)[MAX_NUM_ALF_LUMA_COEFF][MAX_NUM_ALF_LUMA_COEFF], double (*y)[MAX_NUM_ALF_LUMA_COEFF], double& pixAcc )
+{
+  constexpr int numBins = AdaptiveLoopFilter::MaxAlfNumClippingValues;
+
+  // transposed copy, so that consecutive coefficients of one clipping bin are adjacent
+  int ET[numBins][MAX_NUM_ALF_LUMA_COEFF];
+
+  for( int k = 0; k < numCoeff; k++ )
+  {
+    for( int b = 0; b < numBins; b++ )
+    {
+      ET[b][k] = ELocal[k][b];
+    }
+  }
+
+  // all products are exact in double, the order of the additions matches the scalar version
+  const __m128d mweight  = _mm_set1_pd( weight );
+#if USE_AVX2
+  const __m256d mweight2 = _mm256_set1_pd( weight );
+#endif
+
+  for( int k = 0; k < numCoeff; k++ )
+  {
+    for( int b0 = 0; b0 < numBins; b0++ )
+    {
+      const __m128i melocalk = _mm_set1_epi32( ELocal[k][b0] );
+
+      for( int b1 = 0; b1 < numBins; b1++ )
+      {
+        double*    cov = E[b0][b1][k];
+        const int* etl = ET[b1];
+        int l = k;
+#if USE_AVX2
+        for( ; l + 3 < numCoeff; l += 4 )
+        {
+          const __m256d mprod = _mm256_cvtepi32_pd( _mm_mullo_epi32( melocalk, _mm_loadu_si128( ( const __m128i* ) &etl[l] ) ) );
+          _mm256_storeu_pd( &cov[l], _mm256_add_pd( _mm256_loadu_pd( &cov[l] ), _mm256_mul_pd( mweight2, mprod ) ) );
+        }
+#endif
+        for( ; l + 1 < numCoeff; l += 2 )
+        {
+          const __m128d mprod = _mm_cvtepi32_pd( _mm_mullo_epi32( melocalk, _mm_loadl_epi64( ( const __m128i* ) &etl[l] ) ) );
+          _mm_storeu_pd( &cov[l], _mm_add_pd( _mm_loadu_pd( &cov[l] ), _mm_mul_pd( mweight, mprod ) ) );
+        }
+        if( l < numCoeff )
+        {
+          cov[l] += weight * ( ELocal[k][b0] * ( double ) etl[l] );
+        }
+      }
+    }
+  }
+
+  const __m128i mylocal = _mm_set1_epi32( yLocal );
+
+  for( int b = 0; b < numBins; b++ )
+  {
+    int k = 0;
+    for( ; k + 1 < numCoeff; k += 2 )
+    {
+      const __m128d mprod = _mm_cvtepi32_pd( _mm_mullo_epi32( mylocal, _mm_loadl_epi64( ( const __m128i* ) &ET[b][k] ) ) );
+      _mm_storeu_pd( &y[b][k], _mm_add_pd( _mm_loadu_pd( &y[b][k] ), _mm_mul_pd( mweight, mprod ) ) );
+    }
+    if( k < numCoeff )
+    {
+      y[b][k] += weight * ( ET[b][k] * ( double ) yLocal );
+    }
+  }
+
+  pixAcc += weight * ( yLocal * ( double ) yLocal );
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+}
+
 template <X86_VEXT vext>
 void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
 {
@@ -1464,6 +1634,9 @@ void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
     m_filter7x7Blk[1] = simdFilter7x7Blk<vext, true>;  // NonLin is On
   }
   m_filterCcAlf  = simdFilterBlkCcAlf<vext>;
+
+  m_calcCovLin4x4 = simdCalcCovLin4x4<vext>;
+  m_calcCovNonLin = simdCalcCovNonLin<vext>;
 }
 
 template void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86<SIMDX86>();
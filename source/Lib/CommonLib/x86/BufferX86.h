@@ -1704,16 +1704,19 @@ void applyLut_SIMD( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const p
 {
 #if USE_AVX2
   // this implementation is only faster on modern CPUs
-  if( ( width & 15 ) == 0 && ( height & 1 ) == 0 )
+  // the gathers read 32 bit per entry, the LUT is allocated with 2 additional entries
+  if( width >= 8 )
   {
     const __m256i vLutShuf = _mm256_setr_epi8( 0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 );
 
-    for( int y = 0; y < height; y += 2 )
+    for( int y = 0; y < height; y++ )
     {
-      for( int x = 0; x < width; x += 16 )
+      int x = 0;
+
+      for( ; x + 16 <= width; x += 16 )
       {
         __m256i vin16    = _mm256_loadu_si256       ( ( const __m256i * ) &src[x] );
-                                                    
+
         __m256i vin32_1  = _mm256_unpacklo_epi16    ( vin16, _mm256_setzero_si256() );
         __m256i vin32_2  = _mm256_unpackhi_epi16    ( vin16, _mm256_setzero_si256() );
 
@@ -1726,25 +1729,27 @@ void applyLut_SIMD( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const p
         __m256i vout16   = _mm256_unpacklo_epi64    ( vout32_1, vout32_2 );
 
         _mm256_storeu_si256( ( __m256i * ) &dst[x], vout16 );
-        
-        vin16            = _mm256_loadu_si256       ( ( const __m256i * ) &src[x + srcStride] );
-                                                    
-        vin32_1          = _mm256_unpacklo_epi16    ( vin16, _mm256_setzero_si256() );
-        vin32_2          = _mm256_unpackhi_epi16    ( vin16, _mm256_setzero_si256() );
-                         
-        vout32_1         = _mm256_i32gather_epi32   ( ( const int * ) lut, vin32_1, 2 );
-        vout32_2         = _mm256_i32gather_epi32   ( ( const int * ) lut, vin32_2, 2 );
+      }
 
-        vout32_1         = _mm256_shuffle_epi8      ( vout32_1, vLutShuf );
-        vout32_2         = _mm256_shuffle_epi8      ( vout32_2, vLutShuf );
+      for( ; x + 8 <= width; x += 8 )
+      {
+        __m256i vin32    = _mm256_cvtepu16_epi32    ( _mm_loadu_si128( ( const __m128i * ) &src[x] ) );
+        __m256i vout32   = _mm256_i32gather_epi32   ( ( const int * ) lut, vin32, 2 );
+
+        vout32           = _mm256_shuffle_epi8      ( vout32, vLutShuf );
 
-        vout16           = _mm256_unpacklo_epi64    ( vout32_1, vout32_2 );
+        __m128i vout16   = _mm_unpacklo_epi64       ( _mm256_castsi256_si128( vout32 ), _mm256_extracti128_si256( vout32, 1 ) );
 
-        _mm256_storeu_si256( ( __m256i * ) &dst[x + dstStride], vout16 );
+        _mm_storeu_si128( ( __m128i * ) &dst[x], vout16 );
       }
 
-      src += ( srcStride << 1 );
-      dst += ( dstStride << 1 );
+      for( ; x < width; x++ )
+      {
+        dst[x] = lut[src[x]];
+      }
+
+      src += srcStride;
+      dst += dstStride;
     }
 
     _mm256_zeroupper();
@@ -1812,6 +1817,566 @@ void fillPtrMap_SIMD( void** ptr, ptrdiff_t ptrStride, int width, int height, vo
   }
 }
 
+static inline uint32_t hsum_epi32( __m128i v )
+{
+  v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0x4e ) );
+  v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0xb1 ) );
+  return (uint32_t) _mm_cvtsi128_si32( v );
+}
+
+#if USE_AVX2
+static inline __m128i reduce_epi32_avx2( __m256i v )
+{
+  return _mm_add_epi32( _mm256_castsi256_si128( v ), _mm256_extracti128_si256( v, 1 ) );
+}
+
+#endif
+template<X86_VEXT vext>
+uint64_t AvgHighPass_SIMD( const int width, const int height, const Pel* pSrc, const int iSrcStride )
+{
+  uint64_t saAct = 0;
+
+  pSrc += iSrcStride;
+  for( int y = 1; y < height - 1; y++ )
+  {
+    __m128i vsum = _mm_setzero_si128();
+    int x = 1;
+#if USE_AVX2
+    if( x + 16 <= width - 1 )
+    {
+      const __m256i vone  = _mm256_set1_epi16( 1 );
+      const __m256i v12   = _mm256_set1_epi16( 12 );
+      __m256i       vsum2 = _mm256_setzero_si256();
+
+      for( ; x + 16 <= width - 1; x += 16 )
+      {
+        const Pel* pC = pSrc + x;
+        __m256i vc    = _mm256_loadu_si256( ( const __m256i* ) ( pC                  ) );
+        __m256i vcrs  = _mm256_add_epi16( _mm256_loadu_si256( ( const __m256i* ) ( pC - 1              ) ),
+                                          _mm256_loadu_si256( ( const __m256i* ) ( pC + 1              ) ) );
+        vcrs          = _mm256_add_epi16( vcrs, _mm256_loadu_si256( ( const __m256i* ) ( pC - iSrcStride ) ) );
+        vcrs          = _mm256_add_epi16( vcrs, _mm256_loadu_si256( ( const __m256i* ) ( pC + iSrcStride ) ) );
+        __m256i vdiag = _mm256_add_epi16( _mm256_loadu_si256( ( const __m256i* ) ( pC - 1 - iSrcStride ) ),
+                                          _mm256_loadu_si256( ( const __m256i* ) ( pC + 1 - iSrcStride ) ) );
+        vdiag         = _mm256_add_epi16( vdiag, _mm256_loadu_si256( ( const __m256i* ) ( pC - 1 + iSrcStride ) ) );
+        vdiag         = _mm256_add_epi16( vdiag, _mm256_loadu_si256( ( const __m256i* ) ( pC + 1 + iSrcStride ) ) );
+
+        __m256i vs    = _mm256_mullo_epi16( vc, v12 );
+        vs            = _mm256_sub_epi16( vs, _mm256_slli_epi16( vcrs, 1 ) );
+        vs            = _mm256_sub_epi16( vs, vdiag );
+        vsum2         = _mm256_add_epi32( vsum2, _mm256_madd_epi16( _mm256_abs_epi16( vs ), vone ) );
+      }
+      vsum = reduce_epi32_avx2( vsum2 );
+    }
+#endif
+    const __m128i vone = _mm_set1_epi16( 1 );
+    const __m128i v12  = _mm_set1_epi16( 12 );
+
+    for( ; x + 8 <= width - 1; x += 8 )
+    {
+      const Pel* pC = pSrc + x;
+      __m128i vc    = _mm_loadu_si128( ( const __m128i* ) ( pC                  ) );
+      __m128i vcrs  = _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) ( pC - 1              ) ),
+                                     _mm_loadu_si128( ( const __m128i* ) ( pC + 1              ) ) );
+      vcrs          = _mm_add_epi16( vcrs, _mm_loadu_si128( ( const __m128i* ) ( pC - iSrcStride ) ) );
+      vcrs          = _mm_add_epi16( vcrs, _mm_loadu_si128( ( const __m128i* ) ( pC + iSrcStride ) ) );
+      __m128i vdiag = _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) ( pC - 1 - iSrcStride ) ),
+                                     _mm_loadu_si128( ( const __m128i* ) ( pC + 1 - iSrcStride ) ) );
+      vdiag         = _mm_add_epi16( vdiag, _mm_loadu_si128( ( const __m128i* ) ( pC - 1 + iSrcStride ) ) );
+      vdiag         = _mm_add_epi16( vdiag, _mm_loadu_si128( ( const __m128i* ) ( pC + 1 + iSrcStride ) ) );
+
+      __m128i vs    = _mm_mullo_epi16( vc, v12 );
+      vs            = _mm_sub_epi16( vs, _mm_slli_epi16( vcrs, 1 ) );
+      vs            = _mm_sub_epi16( vs, vdiag );
+      vsum          = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_abs_epi16( vs ), vone ) );
+    }
+    saAct += hsum_epi32( vsum );
+
+    for( ; x < width - 1; x++ )
+    {
+      const int s = 12 * (int) pSrc[x  ] - 2 * ((int) pSrc[x-1] + (int) pSrc[x+1] + (int) pSrc[x  -iSrcStride] + (int) pSrc[x  +iSrcStride])
+                       - ((int) pSrc[x-1-iSrcStride] + (int) pSrc[x+1-iSrcStride] + (int) pSrc[x-1+iSrcStride] + (int) pSrc[x+1+iSrcStride]);
+      saAct += abs( s );
+    }
+    pSrc += iSrcStride;
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+  return saAct;
+}
+
+template<X86_VEXT vext>
+uint64_t AvgHighPassWithDownsampling_SIMD( const int width, const int height, const Pel* pSrc, const int iSrcStride )
+{
+  const int i2ndStride = iSrcStride * 2;
+  const int i3rdStride = iSrcStride * 3;
+  uint64_t saAct = 0;
+
+  // the 6x6 filter kernel is decomposed into the vertical pair sums A = R(y) + R(y+1), B = R(y-1) + R(y+2) and
+  // D = R(y-2) + R(y+3), which are weighted horizontally in column pairs starting at x-2, x and x+2 (with madd)
+  pSrc += i2ndStride;
+  for( int y = 2; y < height - 2; y += 2 )
+  {
+    __m128i vsum = _mm_setzero_si128();
+    int x = 2;
+#if USE_AVX2
+    if( x + 14 < width - 2 )
+    {
+      const __m256i vwAm = _mm256_setr_epi16( -1, -3, -1, -3, -1, -3, -1, -3, -1, -3, -1, -3, -1, -3, -1, -3 );
+      const __m256i vwA0 = _mm256_set1_epi16( 12 );
+      const __m256i vwAp = _mm256_setr_epi16( -3, -1, -3, -1, -3, -1, -3, -1, -3, -1, -3, -1, -3, -1, -3, -1 );
+      const __m256i vwBm = _mm256_setr_epi16( -1, -2, -1, -2, -1, -2, -1, -2, -1, -2, -1, -2, -1, -2, -1, -2 );
+      const __m256i vwB0 = _mm256_set1_epi16( -3 );
+      const __m256i vwBp = _mm256_setr_epi16( -2, -1, -2, -1, -2, -1, -2, -1, -2, -1, -2, -1, -2, -1, -2, -1 );
+      const __m256i vwDm = _mm256_setr_epi16(  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1 );
+      const __m256i vwD0 = _mm256_set1_epi16( -1 );
+      const __m256i vwDp = _mm256_setr_epi16( -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0 );
+      __m256i vsum2 = _mm256_setzero_si256();
+
+      for( ; x + 14 < width - 2; x += 16 )
+      {
+        __m256i vs = _mm256_setzero_si256();
+
+        for( int o = -2; o <= 2; o += 2 )
+        {
+          const Pel* pC = pSrc + x + o;
+          const __m256i vA = _mm256_add_epi16( _mm256_loadu_si256( ( const __m256i* ) ( pC              ) ),
+                                               _mm256_loadu_si256( ( const __m256i* ) ( pC + iSrcStride ) ) );
+          const __m256i vB = _mm256_add_epi16( _mm256_loadu_si256( ( const __m256i* ) ( pC - iSrcStride ) ),
+                                               _mm256_loadu_si256( ( const __m256i* ) ( pC + i2ndStride ) ) );
+          const __m256i vD = _mm256_add_epi16( _mm256_loadu_si256( ( const __m256i* ) ( pC - i2ndStride ) ),
+                                               _mm256_loadu_si256( ( const __m256i* ) ( pC + i3rdStride ) ) );
+
+          vs = _mm256_add_epi32( vs, _mm256_madd_epi16( vA, o < 0 ? vwAm : o > 0 ? vwAp : vwA0 ) );
+          vs = _mm256_add_epi32( vs, _mm256_madd_epi16( vB, o < 0 ? vwBm : o > 0 ? vwBp : vwB0 ) );
+          vs = _mm256_add_epi32( vs, _mm256_madd_epi16( vD, o < 0 ? vwDm : o > 0 ? vwDp : vwD0 ) );
+        }
+        vsum2 = _mm256_add_epi32( vsum2, _mm256_abs_epi32( vs ) );
+      }
+      vsum = reduce_epi32_avx2( vsum2 );
+    }
+#endif
+    {
+      const __m128i vwAm = _mm_setr_epi16( -1, -3, -1, -3, -1, -3, -1, -3 );
+      const __m128i vwA0 = _mm_set1_epi16( 12 );
+      const __m128i vwAp = _mm_setr_epi16( -3, -1, -3, -1, -3, -1, -3, -1 );
+      const __m128i vwBm = _mm_setr_epi16( -1, -2, -1, -2, -1, -2, -1, -2 );
+      const __m128i vwB0 = _mm_set1_epi16( -3 );
+      const __m128i vwBp = _mm_setr_epi16( -2, -1, -2, -1, -2, -1, -2, -1 );
+      const __m128i vwDm = _mm_setr_epi16(  0, -1,  0, -1,  0, -1,  0, -1 );
+      const __m128i vwD0 = _mm_set1_epi16( -1 );
+      const __m128i vwDp = _mm_setr_epi16( -1,  0, -1,  0, -1,  0, -1,  0 );
+
+      for( ; x + 6 < width - 2; x += 8 )
+      {
+        __m128i vs = _mm_setzero_si128();
+
+        for( int o = -2; o <= 2; o += 2 )
+        {
+          const Pel* pC = pSrc + x + o;
+          const __m128i vA = _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) ( pC              ) ),
+                                            _mm_loadu_si128( ( const __m128i* ) ( pC + iSrcStride ) ) );
+          const __m128i vB = _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) ( pC - iSrcStride ) ),
+                                            _mm_loadu_si128( ( const __m128i* ) ( pC + i2ndStride ) ) );
+          const __m128i vD = _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) ( pC - i2ndStride ) ),
+                                            _mm_loadu_si128( ( const __m128i* ) ( pC + i3rdStride ) ) );
+
+          vs = _mm_add_epi32( vs, _mm_madd_epi16( vA, o < 0 ? vwAm : o > 0 ? vwAp : vwA0 ) );
+          vs = _mm_add_epi32( vs, _mm_madd_epi16( vB, o < 0 ? vwBm : o > 0 ? vwBp : vwB0 ) );
+          vs = _mm_add_epi32( vs, _mm_madd_epi16( vD, o < 0 ? vwDm : o > 0 ? vwDp : vwD0 ) );
+        }
+        vsum = _mm_add_epi32( vsum, _mm_abs_epi32( vs ) );
+      }
+    }
+    saAct += hsum_epi32( vsum );
+
+    for( ; x < width - 2; x += 2 )
+    {
+      const int s = 12 * ((int) pSrc[x             ] + (int) pSrc[x+1           ] + (int) pSrc[x  +iSrcStride] + (int) pSrc[x+1+iSrcStride])
+                   - 3 * ((int) pSrc[x-1           ] + (int) pSrc[x+2           ] + (int) pSrc[x-1+iSrcStride] + (int) pSrc[x+2+iSrcStride]
+                        + (int) pSrc[x  -iSrcStride] + (int) pSrc[x+1-iSrcStride] + (int) pSrc[x  +i2ndStride] + (int) pSrc[x+1+i2ndStride])
+                   - 2 * ((int) pSrc[x-1-iSrcStride] + (int) pSrc[x+2-iSrcStride] + (int) pSrc[x-1+i2ndStride] + (int) pSrc[x+2+i2ndStride])
+                       - ((int) pSrc[x-1-i2ndStride] + (int) pSrc[x  -i2ndStride] + (int) pSrc[x+1-i2ndStride] + (int) pSrc[x+2-i2ndStride]
+                        + (int) pSrc[x-1+i3rdStride] + (int) pSrc[x  +i3rdStride] + (int) pSrc[x+1+i3rdStride] + (int) pSrc[x+2+i3rdStride]
+                        + (int) pSrc[x-2-iSrcStride] + (int) pSrc[x-2           ] + (int) pSrc[x-2+iSrcStride] + (int) pSrc[x-2+i2ndStride]
+                        + (int) pSrc[x+3-iSrcStride] + (int) pSrc[x+3           ] + (int) pSrc[x+3+iSrcStride] + (int) pSrc[x+3+i2ndStride]);
+      saAct += abs( s );
+    }
+    pSrc += i2ndStride;
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+  return saAct;
+}
+
+template<X86_VEXT vext, bool secondOrder>
+uint64_t HDHighPass_SIMD( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const Pel* pSM2, const int iSrcStride, const int iSM1Stride, const int iSM2Stride )
+{
+  uint64_t taAct = 0;
+
+  pSrc += iSrcStride;
+  pSM1 += iSM1Stride;
+  if( secondOrder ) pSM2 += iSM2Stride;
+  for( int y = 1; y < height - 1; y++ )
+  {
+    __m128i vsum = _mm_setzero_si128();
+    int x = 1;
+#if USE_AVX2
+    if( x + 16 <= width - 1 )
+    {
+      const __m256i vone  = _mm256_set1_epi16( 1 );
+      __m256i       vsum2 = _mm256_setzero_si256();
+
+      for( ; x + 16 <= width - 1; x += 16 )
+      {
+        const __m256i vm1 = _mm256_loadu_si256( ( const __m256i* ) &pSM1[x] );
+        __m256i       vt  = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) &pSrc[x] ), vm1 );
+
+        if( secondOrder )
+        {
+          vt = _mm256_abs_epi16( _mm256_add_epi16( _mm256_sub_epi16( vt, vm1 ), _mm256_loadu_si256( ( const __m256i* ) &pSM2[x] ) ) );
+        }
+        else
+        {
+          vt = _mm256_abs_epi16( vt );
+          vt = _mm256_srli_epi16( _mm256_add_epi16( _mm256_add_epi16( vt, _mm256_slli_epi16( vt, 1 ) ), vone ), 1 );
+        }
+        vsum2 = _mm256_add_epi32( vsum2, _mm256_madd_epi16( vt, vone ) );
+      }
+      vsum = reduce_epi32_avx2( vsum2 );
+    }
+#endif
+    const __m128i vone = _mm_set1_epi16( 1 );
+
+    for( ; x + 8 <= width - 1; x += 8 )
+    {
+      const __m128i vm1 = _mm_loadu_si128( ( const __m128i* ) &pSM1[x] );
+      __m128i       vt  = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) &pSrc[x] ), vm1 );
+
+      if( secondOrder )
+      {
+        vt = _mm_abs_epi16( _mm_add_epi16( _mm_sub_epi16( vt, vm1 ), _mm_loadu_si128( ( const __m128i* ) &pSM2[x] ) ) );
+      }
+      else
+      {
+        vt = _mm_abs_epi16( vt );
+        vt = _mm_srli_epi16( _mm_add_epi16( _mm_add_epi16( vt, _mm_slli_epi16( vt, 1 ) ), vone ), 1 );
+      }
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( vt, vone ) );
+    }
+    taAct += hsum_epi32( vsum );
+
+    for( ; x < width - 1; x++ )
+    {
+      if( secondOrder )
+      {
+        taAct += abs( (int) pSrc[x] - 2 * (int) pSM1[x] + (int) pSM2[x] );
+      }
+      else
+      {
+        taAct += (1 + 3 * abs( (int) pSrc[x] - (int) pSM1[x] )) >> 1;
+      }
+    }
+    pSrc += iSrcStride;
+    pSM1 += iSM1Stride;
+    if( secondOrder ) pSM2 += iSM2Stride;
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+  return taAct;
+}
+
+template<X86_VEXT vext>
+uint64_t HDHighPass1_SIMD( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const int iSrcStride, const int iSM1Stride )
+{
+  return HDHighPass_SIMD<vext, false>( width, height, pSrc, pSM1, nullptr, iSrcStride, iSM1Stride, 0 );
+}
+
+template<X86_VEXT vext>
+uint64_t HDHighPass2_SIMD( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const Pel* pSM2, const int iSrcStride, const int iSM1Stride, const int iSM2Stride )
+{
+  return HDHighPass_SIMD<vext, true>( width, height, pSrc, pSM1, pSM2, iSrcStride, iSM1Stride, iSM2Stride );
+}
+
+template<X86_VEXT vext, bool secondOrder>
+uint64_t AvgHighPassWithDownsamplingDiff_SIMD( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const Pel* pSM2, const int iSrcStride, const int iSM1Stride, const int iSM2Stride )
+{
+  uint64_t taAct = 0;
+
+  // the 2x2 sums at the even columns are derived from the vertical pair sums using madd
+  pSrc += iSrcStride * 2;
+  pSM1 += iSM1Stride * 2;
+  if( secondOrder ) pSM2 += iSM2Stride * 2;
+  for( int y = 2; y < height - 2; y += 2 )
+  {
+    __m128i vsum = _mm_setzero_si128();
+    int x = 2;
+#if USE_AVX2
+    if( x + 14 < width - 2 )
+    {
+      const __m256i vone  = _mm256_set1_epi16( 1 );
+      const __m256i vone32= _mm256_set1_epi32( 1 );
+      __m256i       vsum2 = _mm256_setzero_si256();
+
+      for( ; x + 14 < width - 2; x += 16 )
+      {
+        const __m256i vs0 = _mm256_madd_epi16( _mm256_add_epi16( _mm256_loadu_si256( ( const __m256i* ) &pSrc[x] ), _mm256_loadu_si256( ( const __m256i* ) &pSrc[x + iSrcStride] ) ), vone );
+        const __m256i vs1 = _mm256_madd_epi16( _mm256_add_epi16( _mm256_loadu_si256( ( const __m256i* ) &pSM1[x] ), _mm256_loadu_si256( ( const __m256i* ) &pSM1[x + iSM1Stride] ) ), vone );
+        __m256i       vt  = _mm256_sub_epi32( vs0, vs1 );
+
+        if( secondOrder )
+        {
+          const __m256i vs2 = _mm256_madd_epi16( _mm256_add_epi16( _mm256_loadu_si256( ( const __m256i* ) &pSM2[x] ), _mm256_loadu_si256( ( const __m256i* ) &pSM2[x + iSM2Stride] ) ), vone );
+          vt = _mm256_abs_epi32( _mm256_add_epi32( _mm256_sub_epi32( vt, vs1 ), vs2 ) );
+        }
+        else
+        {
+          vt = _mm256_abs_epi32( vt );
+          vt = _mm256_srli_epi32( _mm256_add_epi32( _mm256_add_epi32( vt, _mm256_slli_epi32( vt, 1 ) ), vone32 ), 1 );
+        }
+        vsum2 = _mm256_add_epi32( vsum2, vt );
+      }
+      vsum = reduce_epi32_avx2( vsum2 );
+    }
+#endif
+    const __m128i vone   = _mm_set1_epi16( 1 );
+    const __m128i vone32 = _mm_set1_epi32( 1 );
+
+    for( ; x + 6 < width - 2; x += 8 )
+    {
+      const __m128i vs0 = _mm_madd_epi16( _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) &pSrc[x] ), _mm_loadu_si128( ( const __m128i* ) &pSrc[x + iSrcStride] ) ), vone );
+      const __m128i vs1 = _mm_madd_epi16( _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) &pSM1[x] ), _mm_loadu_si128( ( const __m128i* ) &pSM1[x + iSM1Stride] ) ), vone );
+      __m128i       vt  = _mm_sub_epi32( vs0, vs1 );
+
+      if( secondOrder )
+      {
+        const __m128i vs2 = _mm_madd_epi16( _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) &pSM2[x] ), _mm_loadu_si128( ( const __m128i* ) &pSM2[x + iSM2Stride] ) ), vone );
+        vt = _mm_abs_epi32( _mm_add_epi32( _mm_sub_epi32( vt, vs1 ), vs2 ) );
+      }
+      else
+      {
+        vt = _mm_abs_epi32( vt );
+        vt = _mm_srli_epi32( _mm_add_epi32( _mm_add_epi32( vt, _mm_slli_epi32( vt, 1 ) ), vone32 ), 1 );
+      }
+      vsum = _mm_add_epi32( vsum, vt );
+    }
+    taAct += hsum_epi32( vsum );
+
+    for( ; x < width - 2; x += 2 )
+    {
+      const int s0 = (int) pSrc[x] + (int) pSrc[x+1] + (int) pSrc[x+iSrcStride] + (int) pSrc[x+1+iSrcStride];
+      const int s1 = (int) pSM1[x] + (int) pSM1[x+1] + (int) pSM1[x+iSM1Stride] + (int) pSM1[x+1+iSM1Stride];
+
+      if( secondOrder )
+      {
+        taAct += abs( s0 - 2 * s1 + (int) pSM2[x] + (int) pSM2[x+1] + (int) pSM2[x+iSM2Stride] + (int) pSM2[x+1+iSM2Stride] );
+      }
+      else
+      {
+        taAct += (1 + 3 * abs( s0 - s1 )) >> 1;
+      }
+    }
+    pSrc += iSrcStride * 2;
+    pSM1 += iSM1Stride * 2;
+    if( secondOrder ) pSM2 += iSM2Stride * 2;
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+  return taAct;
+}
+
+template<X86_VEXT vext>
+uint64_t AvgHighPassWithDownsamplingDiff1st_SIMD( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const int iSrcStride, const int iSM1Stride )
+{
+  return AvgHighPassWithDownsamplingDiff_SIMD<vext, false>( width, height, pSrc, pSM1, nullptr, iSrcStride, iSM1Stride, 0 );
+}
+
+template<X86_VEXT vext>
+uint64_t AvgHighPassWithDownsamplingDiff2nd_SIMD( const int width, const int height, const Pel* pSrc, const Pel* pSM1, const Pel* pSM2, const int iSrcStride, const int iSM1Stride, const int iSM2Stride )
+{
+  return AvgHighPassWithDownsamplingDiff_SIMD<vext, true>( width, height, pSrc, pSM1, pSM2, iSrcStride, iSM1Stride, iSM2Stride );
+}
+
+template<X86_VEXT vext>
+int AvgAbsDev4x4_SIMD( const Pel* pSrc, const int iSrcStride, const int width, const int height )
+{
+  if( width == 4 && height == 4 )
+  {
+    const __m128i vone = _mm_set1_epi16( 1 );
+    const __m128i vr01 = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) &pSrc[0             ] ), _mm_loadl_epi64( ( const __m128i* ) &pSrc[    iSrcStride] ) );
+    const __m128i vr23 = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) &pSrc[2 * iSrcStride] ), _mm_loadl_epi64( ( const __m128i* ) &pSrc[3 * iSrcStride] ) );
+    const int     sum  = (int) hsum_epi32( _mm_madd_epi16( _mm_add_epi16( vr01, vr23 ), vone ) );
+    const __m128i vavg = _mm_set1_epi16( (int16_t) ( sum >> 4 ) );
+    const __m128i vdev = _mm_add_epi16( _mm_abs_epi16( _mm_sub_epi16( vr01, vavg ) ), _mm_abs_epi16( _mm_sub_epi16( vr23, vavg ) ) );
+
+    return (int) ( hsum_epi32( _mm_madd_epi16( vdev, vone ) ) >> 4 );
+  }
+
+  int sum = 0;
+  int dev = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      sum += (int) pSrc[y * iSrcStride + x];
+    }
+  }
+  const int size = width * height;
+  const int mean = sum / size;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      dev += abs( mean - (int) pSrc[y * iSrcStride + x] );
+    }
+  }
+  return dev / size;
+}
+
+template<X86_VEXT vext>
+void addSubColSums_SIMD( const Pel* addRow, const Pel* subRow, int* colSum, int* colSumSq, const int width )
+{
+  int x = 0;
+#if USE_AVX2
+  for( ; x + 8 <= width; x += 8 )
+  {
+    __m256i vsum = _mm256_loadu_si256( ( const __m256i* ) &colSum  [x] );
+    __m256i vsq  = _mm256_loadu_si256( ( const __m256i* ) &colSumSq[x] );
+
+    if( addRow )
+    {
+      const __m256i va = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &addRow[x] ) );
+      vsum = _mm256_add_epi32( vsum, va );
+      vsq  = _mm256_add_epi32( vsq,  _mm256_mullo_epi32( va, va ) );
+    }
+    if( subRow )
+    {
+      const __m256i vs = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &subRow[x] ) );
+      vsum = _mm256_sub_epi32( vsum, vs );
+      vsq  = _mm256_sub_epi32( vsq,  _mm256_mullo_epi32( vs, vs ) );
+    }
+
+    _mm256_storeu_si256( ( __m256i* ) &colSum  [x], vsum );
+    _mm256_storeu_si256( ( __m256i* ) &colSumSq[x], vsq  );
+  }
+
+  _mm256_zeroupper();
+#endif
+  for( ; x + 4 <= width; x += 4 )
+  {
+    __m128i vsum = _mm_loadu_si128( ( const __m128i* ) &colSum  [x] );
+    __m128i vsq  = _mm_loadu_si128( ( const __m128i* ) &colSumSq[x] );
+
+    if( addRow )
+    {
+      const __m128i va = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &addRow[x] ) );
+      vsum = _mm_add_epi32( vsum, va );
+      vsq  = _mm_add_epi32( vsq,  _mm_mullo_epi32( va, va ) );
+    }
+    if( subRow )
+    {
+      const __m128i vs = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &subRow[x] ) );
+      vsum = _mm_sub_epi32( vsum, vs );
+      vsq  = _mm_sub_epi32( vsq,  _mm_mullo_epi32( vs, vs ) );
+    }
+
+    _mm_storeu_si128( ( __m128i* ) &colSum  [x], vsum );
+    _mm_storeu_si128( ( __m128i* ) &colSumSq[x], vsq  );
+  }
+
+  for( ; x < width; x++ )
+  {
+    if( addRow )
+    {
+      colSum  [x] += addRow[x];
+      colSumSq[x] += addRow[x] * addRow[x];
+    }
+    if( subRow )
+    {
+      colSum  [x] -= subRow[x];
+      colSumSq[x] -= subRow[x] * subRow[x];
+    }
+  }
+}
+
+template<X86_VEXT vext>
+void sumAndSumSq_SIMD( const Pel* src, const ptrdiff_t srcStride, const int width, const int height, int64_t* sum, int64_t* sumSq )
+{
+  // the 32 bit partial sums are flushed every 1024 samples, which is safe for sample values up to 10 bit
+  const __m128i vone   = _mm_set1_epi16( 1 );
+  __m128i       vsum64 = _mm_setzero_si128();
+  __m128i       vsq64  = _mm_setzero_si128();
+  int64_t       s      = 0;
+  int64_t       sq     = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+
+    while( x + 8 <= width )
+    {
+      const int xEnd = std::min( x + 1024, width & ~7 );
+      __m128i   vsum = _mm_setzero_si128();
+      __m128i   vsq  = _mm_setzero_si128();
+#if USE_AVX2
+      if( x + 16 <= xEnd )
+      {
+        const __m256i vone2 = _mm256_set1_epi16( 1 );
+        __m256i       vsum2 = _mm256_setzero_si256();
+        __m256i       vsq2  = _mm256_setzero_si256();
+
+        for( ; x + 16 <= xEnd; x += 16 )
+        {
+          const __m256i v = _mm256_loadu_si256( ( const __m256i* ) &src[x] );
+          vsum2 = _mm256_add_epi32( vsum2, _mm256_madd_epi16( v, vone2 ) );
+          vsq2  = _mm256_add_epi32( vsq2,  _mm256_madd_epi16( v, v ) );
+        }
+
+        vsum = reduce_epi32_avx2( vsum2 );
+        vsq  = reduce_epi32_avx2( vsq2 );
+      }
+#endif
+      for( ; x < xEnd; x += 8 )
+      {
+        const __m128i v = _mm_loadu_si128( ( const __m128i* ) &src[x] );
+        vsum = _mm_add_epi32( vsum, _mm_madd_epi16( v, vone ) );
+        vsq  = _mm_add_epi32( vsq,  _mm_madd_epi16( v, v ) );
+      }
+
+      vsum64 = _mm_add_epi64( vsum64, _mm_add_epi64( _mm_cvtepi32_epi64( vsum ), _mm_cvtepi32_epi64( _mm_unpackhi_epi64( vsum, vsum ) ) ) );
+      vsq64  = _mm_add_epi64( vsq64,  _mm_add_epi64( _mm_cvtepu32_epi64( vsq  ), _mm_cvtepu32_epi64( _mm_unpackhi_epi64( vsq,  vsq  ) ) ) );
+    }
+
+    for( ; x < width; x++ )
+    {
+      s  += src[x];
+      sq += src[x] * src[x];
+    }
+
+    src += srcStride;
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+
+  int64_t tmp[2];
+  _mm_storeu_si128( ( __m128i* ) tmp, vsum64 );
+  *sum   = s  + tmp[0] + tmp[1];
+  _mm_storeu_si128( ( __m128i* ) tmp, vsq64 );
+  *sumSq = sq + tmp[0] + tmp[1];
+}
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -1860,6 +2425,17 @@ void PelBufferOps::_initPelBufOpsX86()
   applyLut = applyLut_SIMD<vext>;
 
   fillPtrMap = fillPtrMap_SIMD<vext>;
+
+  AvgHighPass                        = AvgHighPass_SIMD<vext>;
+  AvgHighPassWithDownsampling        = AvgHighPassWithDownsampling_SIMD<vext>;
+  HDHighPass                         = HDHighPass1_SIMD<vext>;
+  HDHighPass2                        = HDHighPass2_SIMD<vext>;
+  AvgHighPassWithDownsamplingDiff1st = AvgHighPassWithDownsamplingDiff1st_SIMD<vext>;
+  AvgHighPassWithDownsamplingDiff2nd = AvgHighPassWithDownsamplingDiff2nd_SIMD<vext>;
+  AvgAbsDev4x4                       = AvgAbsDev4x4_SIMD<vext>;
+
+  addSubColSums     = addSubColSums_SIMD<vext>;
+  sumAndSumSq       = sumAndSumSq_SIMD<vext>;
 }
 
 template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
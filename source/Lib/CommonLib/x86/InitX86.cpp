@@ -65,6 +65,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include "MCTF.h"
 #include "TrQuant_EMT.h"
 #include "QuantRDOQ2.h"
+#include "KernelTuningX86.h"
 
 #ifdef TARGET_SIMD_X86
 
@@ -92,6 +93,10 @@ void InterpolationFilter::initInterpolationFilterX86( /*int iBitDepthY, int iBit
   default:
     break;
   }
+  if( g_kernelTuning.isActive() )
+  {
+    g_kernelTuning.apply( *this );
+  }
 }
 #endif
 
@@ -166,6 +171,10 @@ void RdCost::initRdCostX86()
     default:
       break;
   }
+  if( g_kernelTuning.isActive() )
+  {
+    g_kernelTuning.apply( *this );
+  }
 }
 #endif
 
@@ -0,0 +1,668 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+/** \file     KernelTuningX86.cpp
+    \brief    Runtime selection of the fastest SIMD extension per kernel and block width
+*/
+
+#include "KernelTuningX86.h"
+
+#include "Unit.h"
+#include "RdCost.h"
+#include "TrQuant_EMT.h"
+#include "InterpolationFilter.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#if defined( _WIN32 ) && !defined( __MINGW32__ )
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+KernelTuning g_kernelTuning;
+
+struct TunedKernelInfo
+{
+  const char* name;
+  int         numWidths;              // number of dispatch entries by block width, 0: one entry for all widths
+  int         widths[TK_NUM_WIDTHS];  // block width of each entry, the last one also serves all larger widths
+};
+
+static const TunedKernelInfo g_tunedKernelInfo[NUM_TUNED_KERNELS] =
+{
+  { "AddAvg",   3, {   4,   8,  16 } },
+  { "Sub",      2, {   4,   8 } },
+  { "Reco",     2, {   4,   8 } },
+  { "CopyClip", 2, {   4,   8 } },
+  { "LinTf",    2, {   4,   8 } },
+  { "WghtAvg",  2, {   4,   8 } },
+  { "InvTrafo", 2, {   4,   8 } },
+  { "FwdTrafo", 2, {   4,   8 } },
+  { "SAD",      6, {   4,   8,  16,  32,  64, 128 } },
+  { "SSE",      6, {   4,   8,  16,  32,  64, 128 } },
+  { "HAD",      0, {} },
+  { "McIfHor",  0, {} },
+  { "McIfVer",  0, {} },
+  { "McIfBlk",  3, {   4,   8,  16 } },
+};
+
+static const X86_VEXT g_tuningCandidates[] = { SSE41, AVX, AVX2 };
+static const int      NUM_TUNING_CANDIDATES = sizeof( g_tuningCandidates ) / sizeof( g_tuningCandidates[0] );
+
+static const char* vextName( X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case SSE41: return "SSE41";
+  case SSE42: return "SSE42";
+  case AVX:   return "AVX";
+  case AVX2:  return "AVX2";
+  case AVX512:return "AVX512";
+  default:    return "SCALAR";
+  }
+}
+
+// the extension the dispatch tables are initialized with if no tuning is done, see InitX86.cpp
+static X86_VEXT baseVext( X86_VEXT vext )
+{
+  return vext >= AVX2 ? AVX2 : vext == AVX ? AVX : vext >= SSE41 ? SSE41 : SCALAR;
+}
+
+static int widthIdx( TunedKernel kernel, int width )
+{
+  const TunedKernelInfo& info = g_tunedKernelInfo[kernel];
+  int idx = 0;
+  while( idx + 1 < info.numWidths && info.widths[idx] < width )
+  {
+    idx++;
+  }
+  return idx;
+}
+
+#define INIT_TABLE_X86( table, initFunc, vext )         \
+  switch( vext )                                        \
+  {                                                     \
+  case AVX2: ( table ).initFunc<AVX2>();  break;        \
+  case AVX:  ( table ).initFunc<AVX>();   break;        \
+  default:   ( table ).initFunc<SSE41>(); break;        \
+  }
+
+// ====================================================================================================================
+// calibration
+// ====================================================================================================================
+
+namespace
+{
+struct Candidate
+{
+  Candidate( X86_VEXT _vext ) : vext( _vext )
+  {
+#if ENABLE_SIMD_OPT_BUFFER
+    INIT_TABLE_X86( pelBufOps,    _initPelBufOpsX86,           vext );
+#endif
+#if ENABLE_SIMD_TRAFO
+    INIT_TABLE_X86( tCoeffOps,    _initTCoeffOpsX86,           vext );
+#endif
+#if ENABLE_SIMD_OPT_DIST
+    INIT_TABLE_X86( rdCost,       _initRdCostX86,              vext );
+#endif
+#if ENABLE_SIMD_OPT_MCIF
+    INIT_TABLE_X86( interpFilter, _initInterpolationFilterX86, vext );
+#endif
+  }
+
+  X86_VEXT            vext;
+  PelBufferOps        pelBufOps;
+  TCoeffOps           tCoeffOps;
+  RdCost              rdCost;
+  InterpolationFilter interpFilter;
+};
+
+struct Workspace
+{
+  static const int stride = MAX_CU_SIZE + 32;
+  static const int height = MAX_CU_SIZE + 16;
+
+  Workspace()
+  {
+    for( int i = 0; i < 4; i++ )
+    {
+      pel[i] = ( Pel* ) xMalloc( Pel, stride * height );
+    }
+    for( int i = 0; i < 2; i++ )
+    {
+      coeff[i] = ( TCoeff* ) xMalloc( TCoeff, MAX_TB_SIZEY * MAX_TB_SIZEY );
+    }
+    mat = ( TMatrixCoeff* ) xMalloc( TMatrixCoeff, MAX_TB_SIZEY * MAX_TB_SIZEY );
+
+    uint32_t seed = 0x9e3779b9;
+    auto rnd = [&]( int range ) { seed = seed * 1664525 + 1013904223; return int( ( seed >> 8 ) % range ); };
+
+    for( int i = 0; i < stride * height; i++ )
+    {
+      pel[0][i] = Pel( rnd( 1024 ) );
+      pel[1][i] = Pel( rnd( 1024 ) );
+      pel[2][i] = Pel( rnd( 2047 ) - 1023 );
+      pel[3][i] = 0;
+    }
+    for( int i = 0; i < MAX_TB_SIZEY * MAX_TB_SIZEY; i++ )
+    {
+      coeff[0][i] = TCoeff( rnd( 2047 ) - 1023 );
+      coeff[1][i] = 0;
+      mat     [i] = TMatrixCoeff( rnd( 181 ) - 90 );
+    }
+  }
+
+  ~Workspace()
+  {
+    for( int i = 0; i < 4; i++ ) xFree( pel[i] );
+    for( int i = 0; i < 2; i++ ) xFree( coeff[i] );
+    xFree( mat );
+  }
+
+  // block origin with room for the interpolation filter taps
+  Pel* blk( int i ) { return pel[i] + 8 * stride + 16; }
+
+  Pel*          pel  [4];
+  TCoeff*       coeff[2];
+  TMatrixCoeff* mat;
+};
+
+// runs one call of the kernel of the given candidate on a block of the given width, width 0 runs a mix of block sizes
+void runKernel( TunedKernel kernel, int width, Candidate& c, Workspace& ws )
+{
+  static const ClpRng clpRng = { 0, 1023, 10, 0 };
+  static const int    strd   = Workspace::stride;
+
+  const int w = width;
+  const int h = std::min( width, 32 );
+  const int shift  = IF_INTERNAL_PREC - clpRng.bd + 1;
+  const int offset = ( 1 << ( shift - 1 ) ) + 2 * IF_INTERNAL_OFFS;
+
+  Pel* src0 = ws.blk( 0 );
+  Pel* src1 = ws.blk( 1 );
+  Pel* resi = ws.blk( 2 );
+  Pel* dst  = ws.blk( 3 );
+
+  switch( kernel )
+  {
+#if ENABLE_SIMD_OPT_BUFFER
+  case TK_ADD_AVG:
+    ( w >= 16 ? c.pelBufOps.addAvg16 : w == 8 ? c.pelBufOps.addAvg8 : c.pelBufOps.addAvg4 )( src0, strd, src1, strd, dst, strd, w, h, shift, offset, clpRng );
+    break;
+  case TK_SUB:
+    ( w >= 8 ? c.pelBufOps.sub8 : c.pelBufOps.sub4 )( src0, strd, src1, strd, dst, strd, w, h );
+    break;
+  case TK_RECO:
+    ( w >= 8 ? c.pelBufOps.reco8 : c.pelBufOps.reco4 )( src0, strd, resi, strd, dst, strd, w, h, clpRng );
+    break;
+  case TK_COPY_CLIP:
+    ( w >= 8 ? c.pelBufOps.copyClip8 : c.pelBufOps.copyClip4 )( resi, strd, dst, strd, w, h, clpRng );
+    break;
+  case TK_LIN_TF:
+    ( w >= 8 ? c.pelBufOps.linTf8 : c.pelBufOps.linTf4 )( resi, strd, dst, strd, w, h, 1 << 11, 11, 1 << 10, clpRng, true );
+    break;
+  case TK_WGHT_AVG:
+    ( w >= 8 ? c.pelBufOps.wghtAvg8 : c.pelBufOps.wghtAvg4 )( src0, strd, src1, strd, dst, strd, w, h, shift + 2, ( 1 << ( shift + 1 ) ) + ( IF_INTERNAL_OFFS << 3 ), 5, 3, clpRng );
+    break;
+#endif
+#if ENABLE_SIMD_TRAFO
+  case TK_INV_TRAFO:
+    for( int trSize = w; trSize <= ( w == 4 ? 4 : 32 ); trSize <<= 1 )
+    {
+      ( w == 4 ? c.tCoeffOps.fastInvCore4 : c.tCoeffOps.fastInvCore8 )( ws.mat, ws.coeff[0], ws.coeff[1], trSize, trSize, trSize, trSize );
+      ( w == 4 ? c.tCoeffOps.roundClip4   : c.tCoeffOps.roundClip8   )( ws.coeff[1], trSize, trSize, trSize, -32768, 32767, 1 << 6, 7 );
+    }
+    break;
+  case TK_FWD_TRAFO:
+    for( int trSize = w; trSize <= ( w == 4 ? 4 : 32 ); trSize <<= 1 )
+    {
+      ( w == 4 ? c.tCoeffOps.fastFwdCore4_2D : c.tCoeffOps.fastFwdCore8_2D )( ws.mat, ws.coeff[0], ws.coeff[1], trSize, trSize, trSize, trSize, 7 );
+    }
+    break;
+#endif
+#if ENABLE_SIMD_OPT_DIST
+  case TK_SAD:
+  case TK_SSE:
+  {
+    DistParam dp = c.rdCost.setDistParam( CPelBuf( src0, strd, w, h ), CPelBuf( src1, strd, w, h ), clpRng.bd, kernel == TK_SAD ? DF_SAD : DF_SSE );
+    dp.distFunc( dp );
+    break;
+  }
+  case TK_HAD:
+    for( int size = 8; size <= 32; size <<= 1 )
+    {
+      DistParam dp = c.rdCost.setDistParam( CPelBuf( src0, strd, size, size ), CPelBuf( src1, strd, size, size ), clpRng.bd, DF_HAD );
+      dp.distFunc( dp );
+    }
+    break;
+#endif
+#if ENABLE_SIMD_OPT_MCIF
+  case TK_MCIF_HOR:
+    for( int size = 8; size <= 32; size <<= 1 )
+    {
+      c.interpFilter.filterHor( COMP_Y, src0, strd, dst, strd, size, size, 5, false, CHROMA_420, clpRng );
+    }
+    break;
+  case TK_MCIF_VER:
+    for( int size = 8; size <= 32; size <<= 1 )
+    {
+      c.interpFilter.filterVer( COMP_Y, src0, strd, dst, strd, size, size, 11, true, false, CHROMA_420, clpRng );
+    }
+    break;
+  case TK_MCIF_BLK:
+    if     ( w == 4 ) c.interpFilter.filter4x4  ( COMP_Y, src0, strd, dst, strd,  4,  4, 5, 11, false, CHROMA_420, clpRng );
+    else if( w == 8 ) c.interpFilter.filter8x8  ( COMP_Y, src0, strd, dst, strd,  8,  8, 5, 11, false, CHROMA_420, clpRng );
+    else              c.interpFilter.filter16x16( COMP_Y, src0, strd, dst, strd, 16, 16, 5, 11, false, CHROMA_420, clpRng );
+    break;
+#endif
+  default:
+    break;
+  }
+}
+} // namespace
+
+KernelTuning::KernelTuning()
+  : m_active ( false )
+  , m_maxVext( SCALAR )
+{
+  for( auto& k : m_vext ) for( auto& v : k ) v = SCALAR;
+}
+
+X86_VEXT KernelTuning::getVext( TunedKernel kernel, int width ) const
+{
+  return m_vext[kernel][widthIdx( kernel, width )];
+}
+
+void KernelTuning::calibrate()
+{
+  typedef std::chrono::steady_clock Clock;
+
+  std::vector<std::unique_ptr<Candidate>> candidates;
+  for( X86_VEXT vext : g_tuningCandidates )
+  {
+    if( vext <= m_maxVext )
+    {
+      candidates.push_back( std::unique_ptr<Candidate>( new Candidate( vext ) ) );
+    }
+  }
+
+  Workspace ws;
+
+  for( int k = 0; k < NUM_TUNED_KERNELS; k++ )
+  {
+    const TunedKernel      kernel = TunedKernel( k );
+    const TunedKernelInfo& info   = g_tunedKernelInfo[k];
+
+    for( int idx = 0; idx < std::max( info.numWidths, 1 ); idx++ )
+    {
+      const int width      = info.numWidths ? info.widths[idx] : 0;
+      const int numSamples = width ? width * std::min( width, 32 ) : 1344;
+      const int iters      = std::max( 4, ( 1 << 14 ) / numSamples );
+
+      // interleave the candidates over several rounds and keep the best round of each,
+      // so frequency changes during the calibration affect all candidates alike
+      std::vector<Clock::duration> best( candidates.size(), Clock::duration::max() );
+      for( int round = 0; round < 5; round++ )
+      {
+        for( size_t c = 0; c < candidates.size(); c++ )
+        {
+          runKernel( kernel, width, *candidates[c], ws );
+
+          const Clock::time_point start = Clock::now();
+          for( int i = 0; i < iters; i++ )
+          {
+            runKernel( kernel, width, *candidates[c], ws );
+          }
+          best[c] = std::min( best[c], Clock::now() - start );
+        }
+      }
+
+      // only move away from the default extension for a clear gain
+      size_t sel = 0;
+      for( size_t c = 0; c < candidates.size(); c++ )
+      {
+        if( candidates[c]->vext == baseVext( m_maxVext ) ) sel = c;
+      }
+      for( size_t c = 0; c < candidates.size(); c++ )
+      {
+        if( best[c] * 100 < best[sel] * 95 ) sel = c;
+      }
+
+      m_vext[k][idx] = candidates[sel]->vext;
+    }
+  }
+}
+
+// ====================================================================================================================
+// cache file
+// ====================================================================================================================
+
+std::string KernelTuning::cpuId() const
+{
+  int regs[4] = { 0, 0, 0, 0 };
+  char brand[49];
+  memset( brand, 0, sizeof( brand ) );
+
+#if defined( _WIN32 ) && !defined( __MINGW32__ )
+  __cpuid( regs, 0x80000000 );
+#else
+  __get_cpuid( 0x80000000, ( unsigned* ) &regs[0], ( unsigned* ) &regs[1], ( unsigned* ) &regs[2], ( unsigned* ) &regs[3] );
+#endif
+  if( ( unsigned ) regs[0] >= 0x80000004 )
+  {
+    for( int i = 0; i < 3; i++ )
+    {
+#if defined( _WIN32 ) && !defined( __MINGW32__ )
+      __cpuid( regs, 0x80000002 + i );
+#else
+      __get_cpuid( 0x80000002 + i, ( unsigned* ) &regs[0], ( unsigned* ) &regs[1], ( unsigned* ) &regs[2], ( unsigned* ) &regs[3] );
+#endif
+      memcpy( brand + 16 * i, regs, 16 );
+    }
+  }
+
+  std::stringstream css;
+  css << brand << " [" << vextName( m_maxVext ) << "]";
+  std::string id = css.str();
+  id.erase( 0, id.find_first_not_of( ' ' ) );
+  return id;
+}
+
+bool KernelTuning::readCache( const std::string& cacheFile )
+{
+  std::ifstream file( cacheFile );
+  if( !file.is_open() )
+  {
+    return false;
+  }
+
+  std::string line;
+  if( !std::getline( file, line ) || line != "# vvenc SIMD kernel tuning" || !std::getline( file, line ) || line != "cpu " + cpuId() )
+  {
+    return false;
+  }
+
+  bool found[NUM_TUNED_KERNELS][TK_NUM_WIDTHS];
+  memset( found, 0, sizeof( found ) );
+
+  while( std::getline( file, line ) )
+  {
+    std::istringstream iss( line );
+    std::string name, ext;
+    int width = -1;
+    if( !( iss >> name >> width >> ext ) )
+    {
+      return false;
+    }
+
+    int k = 0;
+    while( k < NUM_TUNED_KERNELS && name != g_tunedKernelInfo[k].name ) k++;
+    X86_VEXT vext = SCALAR;
+    for( X86_VEXT cand : g_tuningCandidates )
+    {
+      if( ext == vextName( cand ) ) vext = cand;
+    }
+    if( k == NUM_TUNED_KERNELS || vext == SCALAR || vext > m_maxVext )
+    {
+      return false;
+    }
+
+    const TunedKernelInfo& info = g_tunedKernelInfo[k];
+    const int idx = widthIdx( TunedKernel( k ), width );
+    if( ( info.numWidths && info.widths[idx] != width ) || ( !info.numWidths && width != 0 ) )
+    {
+      return false;
+    }
+
+    m_vext[k][idx] = vext;
+    found [k][idx] = true;
+  }
+
+  for( int k = 0; k < NUM_TUNED_KERNELS; k++ )
+  {
+    for( int idx = 0; idx < std::max( g_tunedKernelInfo[k].numWidths, 1 ); idx++ )
+    {
+      if( !found[k][idx] ) return false;
+    }
+  }
+  return true;
+}
+
+void KernelTuning::writeCache( const std::string& cacheFile ) const
+{
+  std::ofstream file( cacheFile, std::ios::trunc );
+  if( !file.is_open() )
+  {
+    msg( VVENC_WARNING, "Warning: cannot write SIMD kernel tuning file %s\n", cacheFile.c_str() );
+    return;
+  }
+
+  file << "# vvenc SIMD kernel tuning\n";
+  file << "cpu " << cpuId() << "\n";
+  for( int k = 0; k < NUM_TUNED_KERNELS; k++ )
+  {
+    const TunedKernelInfo& info = g_tunedKernelInfo[k];
+    for( int idx = 0; idx < std::max( info.numWidths, 1 ); idx++ )
+    {
+      file << info.name << " " << ( info.numWidths ? info.widths[idx] : 0 ) << " " << vextName( m_vext[k][idx] ) << "\n";
+    }
+  }
+}
+
+bool KernelTuning::init( const std::string& cacheFile )
+{
+  static std::mutex initMutex;
+  std::lock_guard<std::mutex> lock( initMutex );
+
+  const X86_VEXT maxVext = read_x86_extension_flags();
+  if( maxVext < SSE41 )
+  {
+    return false;
+  }
+  if( m_active && m_maxVext == maxVext )
+  {
+    return true;
+  }
+
+  m_maxVext = maxVext;
+
+  if( cacheFile.empty() || !readCache( cacheFile ) )
+  {
+    calibrate();
+
+    if( !cacheFile.empty() )
+    {
+      writeCache( cacheFile );
+    }
+  }
+
+  m_active = true;
+
+  for( int k = 0; k < NUM_TUNED_KERNELS; k++ )
+  {
+    const TunedKernelInfo& info = g_tunedKernelInfo[k];
+    for( int idx = 0; idx < std::max( info.numWidths, 1 ); idx++ )
+    {
+      msg( VVENC_DETAILS, "SIMD tuning: %-8s %3d %s\n", info.name, info.numWidths ? info.widths[idx] : 0, vextName( m_vext[k][idx] ) );
+    }
+  }
+
+  return true;
+}
+
+// ====================================================================================================================
+// apply the selection to the dispatch tables
+// ====================================================================================================================
+
+#define TUNE_SET( kernel, width, dst, src ) if( getVext( kernel, width ) == cand.vext ) { dst = src; }
+
+void KernelTuning::apply( PelBufferOps& ops ) const
+{
+#if ENABLE_SIMD_OPT_BUFFER
+  for( X86_VEXT vext : g_tuningCandidates )
+  {
+    if( vext > m_maxVext ) continue;
+
+    struct { X86_VEXT vext; PelBufferOps ops; } cand;
+    cand.vext = vext;
+    INIT_TABLE_X86( cand.ops, _initPelBufOpsX86, vext );
+
+    TUNE_SET( TK_ADD_AVG,   4, ops.addAvg4,   cand.ops.addAvg4 );
+    TUNE_SET( TK_ADD_AVG,   8, ops.addAvg8,   cand.ops.addAvg8 );
+    TUNE_SET( TK_ADD_AVG,  16, ops.addAvg16,  cand.ops.addAvg16 );
+    TUNE_SET( TK_SUB,       4, ops.sub4,      cand.ops.sub4 );
+    TUNE_SET( TK_SUB,       8, ops.sub8,      cand.ops.sub8 );
+    TUNE_SET( TK_RECO,      4, ops.reco4,     cand.ops.reco4 );
+    TUNE_SET( TK_RECO,      8, ops.reco8,     cand.ops.reco8 );
+    TUNE_SET( TK_COPY_CLIP, 4, ops.copyClip4, cand.ops.copyClip4 );
+    TUNE_SET( TK_COPY_CLIP, 8, ops.copyClip8, cand.ops.copyClip8 );
+    TUNE_SET( TK_LIN_TF,    4, ops.linTf4,    cand.ops.linTf4 );
+    TUNE_SET( TK_LIN_TF,    8, ops.linTf8,    cand.ops.linTf8 );
+#if ENABLE_SIMD_OPT_BCW
+    TUNE_SET( TK_WGHT_AVG,  4, ops.wghtAvg4,  cand.ops.wghtAvg4 );
+    TUNE_SET( TK_WGHT_AVG,  8, ops.wghtAvg8,  cand.ops.wghtAvg8 );
+#endif
+  }
+#endif
+}
+
+void KernelTuning::apply( TCoeffOps& ops ) const
+{
+#if ENABLE_SIMD_TRAFO
+  for( X86_VEXT vext : g_tuningCandidates )
+  {
+    if( vext > m_maxVext ) continue;
+
+    struct { X86_VEXT vext; TCoeffOps ops; } cand;
+    cand.vext = vext;
+    INIT_TABLE_X86( cand.ops, _initTCoeffOpsX86, vext );
+
+    TUNE_SET( TK_INV_TRAFO, 4, ops.fastInvCore4,    cand.ops.fastInvCore4 );
+    TUNE_SET( TK_INV_TRAFO, 4, ops.roundClip4,      cand.ops.roundClip4 );
+    TUNE_SET( TK_INV_TRAFO, 8, ops.fastInvCore8,    cand.ops.fastInvCore8 );
+    TUNE_SET( TK_INV_TRAFO, 8, ops.roundClip8,      cand.ops.roundClip8 );
+    TUNE_SET( TK_FWD_TRAFO, 4, ops.fastFwdCore4_2D, cand.ops.fastFwdCore4_2D );
+    TUNE_SET( TK_FWD_TRAFO, 8, ops.fastFwdCore8_2D, cand.ops.fastFwdCore8_2D );
+  }
+#endif
+}
+
+void KernelTuning::apply( RdCost& rdCost ) const
+{
+#if ENABLE_SIMD_OPT_DIST
+  for( X86_VEXT vext : g_tuningCandidates )
+  {
+    if( vext > m_maxVext ) continue;
+
+    struct { X86_VEXT vext; RdCost rdCost; } cand;
+    cand.vext = vext;
+    INIT_TABLE_X86( cand.rdCost, _initRdCostX86, vext );
+
+    for( int log2Width = 2; log2Width <= MAX_CU_DEPTH; log2Width++ )
+    {
+      TUNE_SET( TK_SAD, 1 << log2Width, rdCost.m_afpDistortFunc[0][DF_SAD + log2Width], cand.rdCost.m_afpDistortFunc[0][DF_SAD + log2Width] );
+      TUNE_SET( TK_SSE, 1 << log2Width, rdCost.m_afpDistortFunc[0][DF_SSE + log2Width], cand.rdCost.m_afpDistortFunc[0][DF_SSE + log2Width] );
+    }
+    TUNE_SET( TK_HAD, 0, rdCost.m_afpDistortFunc[0][DF_HAD], cand.rdCost.m_afpDistortFunc[0][DF_HAD] );
+  }
+#endif
+}
+
+void KernelTuning::apply( InterpolationFilter& interpFilter ) const
+{
+#if ENABLE_SIMD_OPT_MCIF
+  for( X86_VEXT vext : g_tuningCandidates )
+  {
+    if( vext > m_maxVext ) continue;
+
+    struct { X86_VEXT vext; InterpolationFilter interpFilter; } cand;
+    cand.vext = vext;
+    INIT_TABLE_X86( cand.interpFilter, _initInterpolationFilterX86, vext );
+
+    if( getVext( TK_MCIF_HOR, 0 ) == vext )
+    {
+      memcpy( interpFilter.m_filterHor, cand.interpFilter.m_filterHor, sizeof( interpFilter.m_filterHor ) );
+    }
+    if( getVext( TK_MCIF_VER, 0 ) == vext )
+    {
+      memcpy( interpFilter.m_filterVer, cand.interpFilter.m_filterVer, sizeof( interpFilter.m_filterVer ) );
+    }
+    if( getVext( TK_MCIF_BLK, 4 ) == vext )
+    {
+      memcpy( interpFilter.m_filter4x4, cand.interpFilter.m_filter4x4, sizeof( interpFilter.m_filter4x4 ) );
+    }
+    if( getVext( TK_MCIF_BLK, 8 ) == vext )
+    {
+      memcpy( interpFilter.m_filter8x8, cand.interpFilter.m_filter8x8, sizeof( interpFilter.m_filter8x8 ) );
+    }
+    if( getVext( TK_MCIF_BLK, 16 ) == vext )
+    {
+      memcpy( interpFilter.m_filter16x16, cand.interpFilter.m_filter16x16, sizeof( interpFilter.m_filter16x16 ) );
+    }
+  }
+#endif
+}
+
+#undef TUNE_SET
+
+} // namespace vvenc
+
+//! \}
+
+#endif // TARGET_SIMD_X86
@@ -0,0 +1,130 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+/** \file     KernelTuningX86.h
+    \brief    Runtime selection of the fastest SIMD extension per kernel and block width
+*/
+
+#pragma once
+
+#include "CommonDefX86.h"
+
+#include <string>
+
+#ifdef TARGET_SIMD_X86
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+struct PelBufferOps;
+struct TCoeffOps;
+class  RdCost;
+class  InterpolationFilter;
+
+enum TunedKernel
+{
+  TK_ADD_AVG = 0,   // PelBufferOps::addAvg4/8/16
+  TK_SUB,           // PelBufferOps::sub4/8
+  TK_RECO,          // PelBufferOps::reco4/8
+  TK_COPY_CLIP,     // PelBufferOps::copyClip4/8
+  TK_LIN_TF,        // PelBufferOps::linTf4/8
+  TK_WGHT_AVG,      // PelBufferOps::wghtAvg4/8
+  TK_INV_TRAFO,     // TCoeffOps::fastInvCore4/8 and roundClip4/8
+  TK_FWD_TRAFO,     // TCoeffOps::fastFwdCore4_2D/8_2D
+  TK_SAD,           // RdCost DF_SAD4 .. DF_SAD128
+  TK_SSE,           // RdCost DF_SSE4 .. DF_SSE128
+  TK_HAD,           // RdCost DF_HAD, one function for all block sizes
+  TK_MCIF_HOR,      // InterpolationFilter::m_filterHor, one function for all block sizes
+  TK_MCIF_VER,      // InterpolationFilter::m_filterVer, one function for all block sizes
+  TK_MCIF_BLK,      // InterpolationFilter::m_filter4x4/8x8/16x16
+  NUM_TUNED_KERNELS
+};
+
+static const int TK_NUM_WIDTHS = MAX_CU_DEPTH - 1;   // 4 .. 128, index log2( width ) - 2
+
+/**
+  Times the SIMD implementations of the kernel dispatch tables for all extensions up to the one selected by
+  read_x86_extension_flags() and remembers the fastest one per kernel and block width. Only kernels with bit exact
+  implementations over all extensions are tuned, so the tuning never changes the encoder output.
+  The dispatch tables pick up the selection in their init functions.
+*/
+class KernelTuning
+{
+public:
+  KernelTuning();
+
+  // reads the selection from the cache file if it matches this CPU, otherwise calibrates and writes the cache file.
+  // returns false if no tuning is possible for the selected SIMD extension
+  bool init          ( const std::string& cacheFile );
+  bool isActive      () const { return m_active; }
+
+  X86_VEXT getVext   ( TunedKernel kernel, int width ) const;
+
+  void apply         ( PelBufferOps&        ops ) const;
+  void apply         ( TCoeffOps&           ops ) const;
+  void apply         ( RdCost&              rdCost ) const;
+  void apply         ( InterpolationFilter& interpFilter ) const;
+
+private:
+  void calibrate     ();
+  bool readCache     ( const std::string& cacheFile );
+  void writeCache    ( const std::string& cacheFile ) const;
+  std::string cpuId  () const;
+
+  bool     m_active;
+  X86_VEXT m_maxVext;
+  X86_VEXT m_vext[NUM_TUNED_KERNELS][TK_NUM_WIDTHS];
+};
+
+extern KernelTuning g_kernelTuning;
+
+} // namespace vvenc
+
+//! \}
+
+#endif // TARGET_SIMD_X86
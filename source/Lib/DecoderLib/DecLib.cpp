@@ -166,20 +166,28 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
 
                   CHECK( expectedPoc != poc, "mismatch in POC - check encoder configuration" );
 
-                  if( poc != debugPOC )
+                  for( int i = 0; i < pic->slices.size(); i++ )
                   {
-                    for( int i = 0; i < pic->slices.size(); i++ )
+                    if( pcEncPic->slices.size() <= i )
                     {
-                      if( pcEncPic->slices.size() <= i )
+                      // additional slices share the parameters of the first slice, they only differ in the covered ctu's
+                      Slice* slice = pcEncPic->allocateNewSlice();
+                      *slice       = *pcEncPic->slices[ 0 ];
+                      for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
                       {
-                        pcEncPic->slices.push_back( new Slice );
-                        pcEncPic->slices.back()->pps = pcEncPic->slices[0]->pps;
-                        pcEncPic->slices.back()->sps = pcEncPic->slices[0]->sps;
-                        pcEncPic->slices.back()->vps = pcEncPic->slices[0]->vps;
-                        pcEncPic->slices.back()->pic = pcEncPic->slices[0]->pic;
+                        if( pcEncPic->slices[ 0 ]->rpl[ l ] == &pcEncPic->slices[ 0 ]->rplLocal[ l ] )
+                        {
+                          slice->rpl[ l ] = &slice->rplLocal[ l ];
+                        }
                       }
+                    }
+                    if( poc != debugPOC )
+                    {
                       pcEncPic->slices[i]->copySliceInfo( pic->slices[i], false );
                     }
+                    pcEncPic->slices[i]->independentSliceIdx = pic->slices[i]->independentSliceIdx;
+                    pcEncPic->slices[i]->sliceSubPicId       = pic->slices[i]->sliceSubPicId;
+                    pcEncPic->slices[i]->sliceMap            = pic->slices[i]->sliceMap;
                   }
 
                   pcEncPic->cs->slice = pcEncPic->slices.back();
@@ -235,7 +243,8 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
                   pcEncPic->cs->picHeader->copyPicInfo( pic->cs->picHeader, false );
                   for( auto& cu: pcEncPic->cs->cus)
                   {
-                    cu->slice = pcEncPic->cs->slice;
+                    const CodingUnit* decCu = pic->cs->getCU( cu->blocks[ cu->chType ].pos(), cu->chType, TREE_D );
+                    cu->slice = pcEncPic->slices[ decCu->slice->independentSliceIdx ];
                   }
                   goOn = false; // exit the loop return
                   bRet = true;
@@ -459,7 +459,156 @@ void HLSyntaxReader::parsePPS( PPS* pcPPS, ParameterSetManager *parameterSetMana
 
   if(!pcPPS->noPicPartition)
   {
-    THROW("no support");
+    pcPPS->resetTileSliceInfo();
+    READ_CODE( 2, uiCode, "pps_log2_ctu_size_minus5" );         pcPPS->log2CtuSize = uiCode + 5;
+    pcPPS->ctuSize        = 1 << pcPPS->log2CtuSize;
+    pcPPS->picWidthInCtu  = ( pcPPS->picWidthInLumaSamples  + pcPPS->ctuSize - 1 ) >> pcPPS->log2CtuSize;
+    pcPPS->picHeightInCtu = ( pcPPS->picHeightInLumaSamples + pcPPS->ctuSize - 1 ) >> pcPPS->log2CtuSize;
+
+    READ_UVLC( uiCode, "pps_num_exp_tile_columns_minus1" );       pcPPS->numExpTileCols = uiCode + 1;
+    READ_UVLC( uiCode, "pps_num_exp_tile_rows_minus1" );          pcPPS->numExpTileRows = uiCode + 1;
+    CHECK( pcPPS->numExpTileCols > MAX_TILE_COLS, "Number of explicit tile columns exceeds valid range" );
+    CHECK( pcPPS->numExpTileRows > MAX_TILE_ROWS, "Number of explicit tile rows exceeds valid range" );
+    for( int colIdx = 0; colIdx < pcPPS->numExpTileCols; colIdx++ )
+    {
+      READ_UVLC( uiCode, "pps_tile_column_width_minus1[i]" );     pcPPS->tileColWidth.push_back( uiCode + 1 );
+    }
+    for( int rowIdx = 0; rowIdx < pcPPS->numExpTileRows; rowIdx++ )
+    {
+      READ_UVLC( uiCode, "pps_tile_row_height_minus1[i]" );       pcPPS->tileRowHeight.push_back( uiCode + 1 );
+    }
+    pcPPS->initTiles();
+
+    const uint32_t numTiles = pcPPS->numTileCols * pcPPS->numTileRows;
+    pcPPS->rectSlice = true;
+    if( numTiles > 1 )
+    {
+      READ_FLAG( pcPPS->loopFilterAcrossTilesEnabled, "pps_loop_filter_across_tiles_enabled_flag" );
+      READ_FLAG( pcPPS->rectSlice,                    "pps_rect_slice_flag" );
+    }
+    CHECK( !pcPPS->rectSlice, "raster-scan slices not supported" );
+    READ_FLAG( pcPPS->singleSlicePerSubPic, "pps_single_slice_per_subpic_flag" );
+    pcPPS->numSlicesInPic = 1;
+    if( !pcPPS->singleSlicePerSubPic )
+    {
+      READ_UVLC( uiCode, "pps_num_slices_in_pic_minus1" );        pcPPS->numSlicesInPic = uiCode + 1;
+      pcPPS->tileIdxDeltaPresent = false;
+      if( pcPPS->numSlicesInPic - 1 > 1 )
+      {
+        READ_FLAG( pcPPS->tileIdxDeltaPresent, "pps_tile_idx_delta_present_flag" );
+      }
+    }
+    pcPPS->initRectSlices();
+
+    if( !pcPPS->singleSlicePerSubPic )
+    {
+      RectSlice& lastSlice = pcPPS->rectSlices[ pcPPS->numSlicesInPic - 1 ];
+      lastSlice.tileIdx            = 0;
+      lastSlice.sliceWidthInTiles  = pcPPS->numTileCols;
+      lastSlice.sliceHeightInTiles = pcPPS->numTileRows;
+      lastSlice.numSlicesInTile    = 1;
+      lastSlice.sliceHeightInCtu   = pcPPS->tileRowHeight[ 0 ];
+
+      int tileIdx = 0;
+      for( int i = 0; i < (int)pcPPS->numSlicesInPic - 1; i++ )
+      {
+        RectSlice& rectSlice     = pcPPS->rectSlices[ i ];
+        const uint32_t tileX     = tileIdx % pcPPS->numTileCols;
+        const uint32_t tileY     = tileIdx / pcPPS->numTileCols;
+        rectSlice.tileIdx            = tileIdx;
+        rectSlice.sliceWidthInTiles  = 1;
+        rectSlice.sliceHeightInTiles = 1;
+        rectSlice.numSlicesInTile    = 1;
+        rectSlice.sliceHeightInCtu   = pcPPS->tileRowHeight[ tileY ];
+        if( tileX != pcPPS->numTileCols - 1 )
+        {
+          READ_UVLC( uiCode, "pps_slice_width_in_tiles_minus1[i]" );  rectSlice.sliceWidthInTiles = uiCode + 1;
+        }
+        if( tileY != pcPPS->numTileRows - 1 && ( pcPPS->tileIdxDeltaPresent || tileX == 0 ) )
+        {
+          READ_UVLC( uiCode, "pps_slice_height_in_tiles_minus1[i]" ); rectSlice.sliceHeightInTiles = uiCode + 1;
+        }
+        else if( tileY != pcPPS->numTileRows - 1 && i > 0 )
+        {
+          rectSlice.sliceHeightInTiles = pcPPS->rectSlices[ i - 1 ].sliceHeightInTiles;
+        }
+
+        // multiple slices within a single tile
+        if( rectSlice.sliceWidthInTiles == 1 && rectSlice.sliceHeightInTiles == 1 && pcPPS->tileRowHeight[ tileY ] > 1 )
+        {
+          READ_UVLC( uiCode, "pps_num_exp_slices_in_tile[i]" );
+          const uint32_t numExpSlicesInTile = uiCode;
+          if( numExpSlicesInTile > 0 )
+          {
+            uint32_t remTileRowHeight = pcPPS->tileRowHeight[ tileY ];
+            uint32_t sliceHeight      = 0;
+            int j = 0;
+            for( ; j < (int)numExpSlicesInTile; j++ )
+            {
+              READ_UVLC( uiCode, "pps_exp_slice_height_in_ctus_minus1[i]" );
+              sliceHeight = uiCode + 1;
+              CHECK( sliceHeight > remTileRowHeight || i + j >= (int)pcPPS->numSlicesInPic, "Invalid slice height in tile" );
+              pcPPS->rectSlices[ i + j ].sliceHeightInCtu = sliceHeight;
+              remTileRowHeight -= sliceHeight;
+            }
+            while( remTileRowHeight > 0 )
+            {
+              CHECK( i + j >= (int)pcPPS->numSlicesInPic, "Invalid number of slices in tile" );
+              pcPPS->rectSlices[ i + j ].sliceHeightInCtu = std::min( sliceHeight, remTileRowHeight );
+              remTileRowHeight -= pcPPS->rectSlices[ i + j ].sliceHeightInCtu;
+              j++;
+            }
+            for( int k = 0; k < j; k++ )
+            {
+              pcPPS->rectSlices[ i + k ].tileIdx            = tileIdx;
+              pcPPS->rectSlices[ i + k ].sliceWidthInTiles  = 1;
+              pcPPS->rectSlices[ i + k ].sliceHeightInTiles = 1;
+              pcPPS->rectSlices[ i + k ].numSlicesInTile    = j;
+            }
+            i += j - 1;
+          }
+        }
+
+        if( i < (int)pcPPS->numSlicesInPic - 1 )
+        {
+          if( pcPPS->tileIdxDeltaPresent )
+          {
+            READ_SVLC( iCode, "pps_tile_idx_delta_val[i]" );
+            tileIdx += iCode;
+          }
+          else
+          {
+            tileIdx += rectSlice.sliceWidthInTiles;
+            if( tileIdx % pcPPS->numTileCols == 0 )
+            {
+              tileIdx += ( rectSlice.sliceHeightInTiles - 1 ) * pcPPS->numTileCols;
+            }
+          }
+          CHECK( tileIdx < 0 || tileIdx >= (int)numTiles, "Invalid tile index" );
+          // the last slice of the picture covers the remaining tiles
+          lastSlice.tileIdx            = tileIdx;
+          lastSlice.sliceWidthInTiles  = pcPPS->numTileCols - tileIdx % pcPPS->numTileCols;
+          lastSlice.sliceHeightInTiles = pcPPS->numTileRows - tileIdx / pcPPS->numTileCols;
+          lastSlice.numSlicesInTile    = 1;
+          lastSlice.sliceHeightInCtu   = pcPPS->tileRowHeight[ tileIdx / pcPPS->numTileCols ];
+        }
+      }
+    }
+    else
+    {
+      RectSlice& rectSlice = pcPPS->rectSlices[ 0 ];
+      rectSlice.tileIdx            = 0;
+      rectSlice.sliceWidthInTiles  = pcPPS->numTileCols;
+      rectSlice.sliceHeightInTiles = pcPPS->numTileRows;
+      rectSlice.numSlicesInTile    = 1;
+      rectSlice.sliceHeightInCtu   = pcPPS->picHeightInCtu;
+    }
+    pcPPS->initRectSliceMap();
+
+    if( !pcPPS->rectSlice || pcPPS->singleSlicePerSubPic || pcPPS->numSlicesInPic > 1 )
+    {
+      READ_FLAG( pcPPS->loopFilterAcrossSlicesEnabled, "pps_loop_filter_across_slices_enabled_flag" );
+    }
   }
 
   READ_FLAG( pcPPS->cabacInitPresent,   "pps_cabac_init_present_flag" );
@@ -1959,6 +2108,11 @@ void HLSyntaxReader::parsePictureHeader( PicHeader* picHeader, ParameterSetManag
   else 
   {
     CHECK(pps->ctuSize != sps->CTUSize, "PPS CTU size does not match CTU size in SPS");
+    CHECK(pps->numSubPics>=2, "error, multiple sub pictures not supported");
+    pps->subPics.clear();
+    pps->subPics.resize(1);
+    pps->subPics[0].init( pps->picWidthInCtu, pps->picHeightInCtu, pps->picWidthInLumaSamples, pps->picHeightInLumaSamples);
+    pps->subPics[0].numSlicesInSubPic = pps->numSlicesInPic;
   }
 
   if( pps->wrapAroundEnabled )
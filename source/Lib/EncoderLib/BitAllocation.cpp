@@ -51,6 +51,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BitAllocation.h"
 #include "CommonLib/Picture.h"
+#include "Utilities/NoMallocThreadPool.h"
 #include <math.h>
 
 #include "vvenc/vvencCfg.h"
@@ -63,6 +64,8 @@ namespace vvenc {
 
 // static functions
 
+static const int QPA_ACT_BAND_HEIGHT = 64; // rows per activity task, must be even for the downsampling high-pass
+
 static inline int apprI3Log2 (const double d) // rounded 3*log2(d)
 {
   return d < 1.5e-13 ? -128 : int (floor (3.0 * log (d) / log (2.0) + 0.5));
@@ -80,158 +83,130 @@ static inline int lumaDQPOffset (const uint32_t avgLumaValue, const uint32_t bit
 #endif
 }
 
+struct ActivityTask // one band of center rows, the band start is even to support downsampling
+{
+  const Pel* pSrc; int iSrcStride;
+  const Pel* pSM1; int iSM1Stride;
+  const Pel* pSM2; int iSM2Stride;
+  int width, rowBeg, rowEnd;
+  bool isUHD, use2ndOrder;
+  uint64_t saAct, taAct;
+};
+
+static void calculateActivitySums (ActivityTask& t)
+{
+  const int border = (t.isUHD ? 2 : 1);
+  const int offset = t.rowBeg - border;
+  const int height = t.rowEnd - t.rowBeg + 2 * border;
+  const Pel* pSrc  = t.pSrc + offset * t.iSrcStride;
+  const Pel* pSM1  = t.pSM1 + offset * t.iSM1Stride;
+  const Pel* pSM2  = (t.use2ndOrder ? t.pSM2 + offset * t.iSM2Stride : nullptr);
+
+  if (t.isUHD) // high-pass with downsampling
+  {
+    t.saAct = g_pelBufOP.AvgHighPassWithDownsampling (t.width, height, pSrc, t.iSrcStride);
+    t.taAct = (t.use2ndOrder ? g_pelBufOP.AvgHighPassWithDownsamplingDiff2nd (t.width, height, pSrc, pSM1, pSM2, t.iSrcStride, t.iSM1Stride, t.iSM2Stride)
+                             : g_pelBufOP.AvgHighPassWithDownsamplingDiff1st (t.width, height, pSrc, pSM1, t.iSrcStride, t.iSM1Stride));
+  }
+  else // HD high-pass without downsampling
+  {
+    t.saAct = g_pelBufOP.AvgHighPass (t.width, height, pSrc, t.iSrcStride);
+    t.taAct = (t.use2ndOrder ? g_pelBufOP.HDHighPass2 (t.width, height, pSrc, pSM1, pSM2, t.iSrcStride, t.iSM1Stride, t.iSM2Stride)
+                             : g_pelBufOP.HDHighPass  (t.width, height, pSrc, pSM1, t.iSrcStride, t.iSM1Stride));
+  }
+}
+
 static double filterAndCalculateAverageActivity (const Pel* pSrc, const int iSrcStride, const int height, const int width,
                                                  const Pel* pSM1, const int iSM1Stride, const Pel* pSM2, const int iSM2Stride,
-                                                 uint32_t frameRate, const uint32_t bitDepth, const bool isUHD)
+                                                 uint32_t frameRate, const uint32_t bitDepth, const bool isUHD,
+                                                 NoMallocThreadPool* threadPool = nullptr)
 {
-  double meanAct = 0.0;
-  uint64_t saAct = 0;   // spatial absolute activity sum
-  uint64_t taAct = 0;  // temporal absolute activity sum
-  const Pel* pS0 = pSrc;
+  const int border = (isUHD ? 2 : 1);
 
   if (pSrc == nullptr || iSrcStride <= 0) return 0.0;
   // force 1st-order delta if only prev. frame available
   if (pSM2 == nullptr || iSM2Stride <= 0) frameRate = 24;
 
-  // skip first row as there may be a black border frame
-  pSrc += iSrcStride;
-  // center rows
-  if (isUHD) // high-pass with downsampling
-  {
-    const int i2ndStride = iSrcStride * 2;
-    const int i3rdStride = iSrcStride * 3;
+  CHECK (pSM1 == nullptr || iSM1Stride <= 0 || iSM1Stride < width, "Pel buffer pointer pSM1 must not be null!");
+  CHECK (frameRate > 31 && (pSM2 == nullptr || iSM2Stride <= 0 || iSM2Stride < width), "Pel buffer pointer pSM2 must not be null!");
 
-    pSrc += iSrcStride;
-    for (int y = 2; y < height - 2; y += 2)
-    {
-      for (int x = 2; x < width - 2; x += 2) // cnt cols
-      {
-        const int s = 12 * ((int) pSrc[x             ] + (int) pSrc[x+1           ] + (int) pSrc[x  +iSrcStride] + (int) pSrc[x+1+iSrcStride])
-                     - 3 * ((int) pSrc[x-1           ] + (int) pSrc[x+2           ] + (int) pSrc[x-1+iSrcStride] + (int) pSrc[x+2+iSrcStride]
-                          + (int) pSrc[x  -iSrcStride] + (int) pSrc[x+1-iSrcStride] + (int) pSrc[x  +i2ndStride] + (int) pSrc[x+1+i2ndStride])
-                     - 2 * ((int) pSrc[x-1-iSrcStride] + (int) pSrc[x+2-iSrcStride] + (int) pSrc[x-1+i2ndStride] + (int) pSrc[x+2+i2ndStride])
-                         - ((int) pSrc[x-1-i2ndStride] + (int) pSrc[x  -i2ndStride] + (int) pSrc[x+1-i2ndStride] + (int) pSrc[x+2-i2ndStride]
-                          + (int) pSrc[x-1+i3rdStride] + (int) pSrc[x  +i3rdStride] + (int) pSrc[x+1+i3rdStride] + (int) pSrc[x+2+i3rdStride]
-                          + (int) pSrc[x-2-iSrcStride] + (int) pSrc[x-2           ] + (int) pSrc[x-2+iSrcStride] + (int) pSrc[x-2+i2ndStride]
-                          + (int) pSrc[x+3-iSrcStride] + (int) pSrc[x+3           ] + (int) pSrc[x+3+iSrcStride] + (int) pSrc[x+3+i2ndStride]);
-        saAct += abs (s);
-      }
-      pSrc += i2ndStride;
-    }
+  // skip first row as there may be a black border frame, the band sums are exact, so the result is independent of the split
+  const int rowBeg = border;
+  const int rowEnd = std::max (rowBeg, height - border);
+  const int nBands = (threadPool && threadPool->numThreads() > 1 && rowEnd - rowBeg >= 2 * QPA_ACT_BAND_HEIGHT ? (rowEnd - rowBeg + QPA_ACT_BAND_HEIGHT - 1) / QPA_ACT_BAND_HEIGHT : 1);
+  std::vector<ActivityTask> bands (nBands, ActivityTask { pSrc, iSrcStride, pSM1, iSM1Stride, pSM2, iSM2Stride, width, rowBeg, rowEnd, isUHD, frameRate > 31, 0, 0 });
 
-    meanAct = double (saAct) / double ((width - 4) * (height - 4));
-  }
-  else // HD high-pass without downsampling
+  for (int n = 0; n < nBands; n++)
   {
-    for (int y = 1; y < height - 1; y++)
-    {
-      for (int x = 1; x < width - 1; x++) // center cols
-      {
-        const int s = 12 * (int) pSrc[x  ] - 2 * ((int) pSrc[x-1] + (int) pSrc[x+1] + (int) pSrc[x  -iSrcStride] + (int) pSrc[x  +iSrcStride])
-                         - ((int) pSrc[x-1-iSrcStride] + (int) pSrc[x+1-iSrcStride] + (int) pSrc[x-1+iSrcStride] + (int) pSrc[x+1+iSrcStride]);
-        saAct += abs (s);
-      }
-      pSrc += iSrcStride;
-    }
-
-    meanAct = double (saAct) / double ((width - 2) * (height - 2));
+    bands[n].rowBeg = rowBeg + n * QPA_ACT_BAND_HEIGHT;
+    if (n + 1 < nBands) bands[n].rowEnd = bands[n].rowBeg + QPA_ACT_BAND_HEIGHT;
   }
-
-  // skip first row as there may be a black border frame
-  pSrc = pS0 + iSrcStride;
-  // center rows
-  if (isUHD) // high-pass with downsampling
+  if (nBands > 1)
   {
-    const int i2M0Stride = iSrcStride * 2;
-    const int i2M1Stride = iSM1Stride * 2;
+    WaitCounter taskCounter;
 
-    CHECK (pSM1 == nullptr || iSM1Stride <= 0 || iSM1Stride < width, "Pel buffer pointer pSM1 must not be null!");
-
-    pSrc += iSrcStride;
-    pSM1 += i2M1Stride;
-    if (frameRate <= 31) // 1st-order delta
-    {
-      for (int y = 2; y < height - 2; y += 2)
-      {
-        for (int x = 2; x < width - 2; x += 2) // c cols
-        {
-          const int t = (int) pSrc[x] + (int) pSrc[x+1] + (int) pSrc[x+iSrcStride] + (int) pSrc[x+1+iSrcStride]
-                     - ((int) pSM1[x] + (int) pSM1[x+1] + (int) pSM1[x+iSM1Stride] + (int) pSM1[x+1+iSM1Stride]);
-          taAct += (1 + 3 * abs (t)) >> 1;
-        }
-        pSrc += i2M0Stride;
-        pSM1 += i2M1Stride;
-      }
-    }
-    else // 2nd-order delta (diff of diffs)
+    for (auto& band : bands)
     {
-      const int i2M2Stride = iSM2Stride * 2;
-
-      CHECK (pSM2 == nullptr || iSM2Stride <= 0 || iSM2Stride < width, "Pel buffer pointer pSM2 must not be null!");
+      static auto task = [] (int, ActivityTask* t) { calculateActivitySums (*t); return true; };
 
-      pSM2 += i2M2Stride;
-      for (int y = 2; y < height - 2; y += 2)
-      {
-        for (int x = 2; x < width - 2; x += 2) // c cols
-        {
-          const int t = (int) pSrc[x] + (int) pSrc[x+1] + (int) pSrc[x+iSrcStride] + (int) pSrc[x+1+iSrcStride]
-                 - 2 * ((int) pSM1[x] + (int) pSM1[x+1] + (int) pSM1[x+iSM1Stride] + (int) pSM1[x+1+iSM1Stride])
-                      + (int) pSM2[x] + (int) pSM2[x+1] + (int) pSM2[x+iSM2Stride] + (int) pSM2[x+1+iSM2Stride];
-          taAct += abs (t);
-        }
-        pSrc += i2M0Stride;
-        pSM1 += i2M1Stride;
-        pSM2 += i2M2Stride;
-      }
+      threadPool->addBarrierTask<ActivityTask> (task, &band, &taskCounter);
     }
-
-    meanAct += (2.0 * taAct) / double ((width - 4) * (height - 4));
+    taskCounter.wait();
   }
-  else // HD high-pass without downsampling
+  else
   {
-    CHECK (pSM1 == nullptr || iSM1Stride <= 0 || iSM1Stride < width, "Pel buffer pointer pSM1 must not be null!");
-
-    pSM1 += iSM1Stride;
-    if (frameRate <= 31) // 1st-order delta
-    {
-      for (int y = 1; y < height - 1; y++)
-      {
-        for (int x = 1; x < width - 1; x++)  // cnt cols
-        {
-          const int t = (int) pSrc[x] - (int) pSM1[x];
-
-          taAct += (1 + 3 * abs (t)) >> 1;
-        }
-        pSrc += iSrcStride;
-        pSM1 += iSM1Stride;
-      }
-    }
-    else // 2nd-order delta (diff of diffs)
-    {
-      CHECK (pSM2 == nullptr || iSM2Stride <= 0 || iSM2Stride < width, "Pel buffer pointer pSM2 must not be null!");
-
-      pSM2 += iSM2Stride;
-      for (int y = 1; y < height - 1; y++)
-      {
-        for (int x = 1; x < width - 1; x++)  // cnt cols
-        {
-          const int t = (int) pSrc[x] - 2 * (int) pSM1[x] + (int) pSM2[x];
+    calculateActivitySums (bands[0]);
+  }
 
-          taAct += abs (t);
-        }
-        pSrc += iSrcStride;
-        pSM1 += iSM1Stride;
-        pSM2 += iSM2Stride;
-      }
-    }
+  uint64_t saAct = 0;   // spatial absolute activity sum
+  uint64_t taAct = 0;  // temporal absolute activity sum
 
-    meanAct += (2.0 * taAct) / double ((width - 2) * (height - 2));
+  for (const auto& band : bands)
+  {
+    saAct += band.saAct;
+    taAct += band.taAct;
   }
 
+  const double meanAct = double (saAct) / double ((width - 2 * border) * (height - 2 * border)) + (2.0 * taAct) / double ((width - 2 * border) * (height - 2 * border));
+
   // lower limit, compensate for high-pass amplification
   return std::max (meanAct, double (1 << (bitDepth - 6)));
 }
 
+struct CtuActivityTask // one row of CTUs
+{
+  Picture* pic;
+  uint32_t frameRate;
+  int      bitDepth;
+  bool     isHighResolution;
+  uint32_t ctuStartAddr, ctuBoundingAddr;
+};
+
+static void calculateCtuActivity (const CtuActivityTask& t)
+{
+  Picture* const pic      = t.pic;
+  const PreCalcValues& pcv = *pic->cs->pcv;
+  const PosType guardSize = (t.isHighResolution ? 2 : 1);
+
+  for (uint32_t ctuTsAddr = t.ctuStartAddr; ctuTsAddr < t.ctuBoundingAddr; ctuTsAddr++)
+  {
+    const uint32_t ctuRsAddr = /*tileMap.getCtuBsToRsAddrMap*/ (ctuTsAddr);
+    const Position pos ((ctuRsAddr % pcv.widthInCtus) * pcv.maxCUSize, (ctuRsAddr / pcv.widthInCtus) * pcv.maxCUSize);
+    const CompArea ctuArea   = clipArea (CompArea (COMP_Y, pic->chromaFormat, Area (pos.x, pos.y, pcv.maxCUSize, pcv.maxCUSize)), pic->Y());
+    const SizeType fltWidth  = pcv.maxCUSize + guardSize * (pos.x > 0 ? 2 : 1);
+    const SizeType fltHeight = pcv.maxCUSize + guardSize * (pos.y > 0 ? 2 : 1);
+    const CompArea fltArea   = clipArea (CompArea (COMP_Y, pic->chromaFormat, Area (pos.x > 0 ? pos.x - guardSize : 0, pos.y > 0 ? pos.y - guardSize : 0, fltWidth, fltHeight)), pic->Y());
+    const CPelBuf  picOrig   = pic->getOrigBuf (fltArea);
+    const CPelBuf  picPrv1   = pic->getOrigBufPrev (fltArea, false);
+    const CPelBuf  picPrv2   = pic->getOrigBufPrev (fltArea, true );
+
+    pic->ctuQpaLambda[ctuRsAddr] = filterAndCalculateAverageActivity (picOrig.buf, picOrig.stride, picOrig.height, picOrig.width,
+                                                                      picPrv1.buf, picPrv1.stride, picPrv2.buf, picPrv2.stride, t.frameRate,
+                                                                      t.bitDepth, t.isHighResolution); // temporary backup of CTU mean visual activity
+    pic->ctuAdaptedQP[ctuRsAddr] = pic->getOrigBuf (ctuArea).getAvg(); // and mean luma value
+  }
+}
+
 static double getAveragePictureActivity (const uint32_t picWidth,  const uint32_t picHeight,
                                          const int scaledAverageGopActivity,
                                          const bool tempFiltering, const uint32_t bitDepth)
@@ -314,7 +289,8 @@ static int getGlaringColorQPOffsetSubCtu (Picture* const pic, const CompArea& lu
 // public functions
 
 int BitAllocation::applyQPAdaptationChroma (const Slice* slice, const VVEncCfg* encCfg, const int sliceQP,
-                                            std::vector<int>& ctuPumpRedQP, int optChromaQPOffset[2], double* picVisActY /*= nullptr*/)
+                                            std::vector<int>& ctuPumpRedQP, int optChromaQPOffset[2], double* picVisActY /*= nullptr*/,
+                                            NoMallocThreadPool* threadPool /*= nullptr*/)
 {
   Picture* const pic          = (slice != nullptr ? slice->pic : nullptr);
   double hpEner[MAX_NUM_COMP] = {0.0, 0.0, 0.0};
@@ -338,7 +314,7 @@ int BitAllocation::applyQPAdaptationChroma (const Slice* slice, const VVEncCfg*
 
     hpEner[comp] = filterAndCalculateAverageActivity (picOrig.buf, picOrig.stride, picOrig.height, picOrig.width,
                                                       picPrv1.buf, picPrv1.stride, picPrv2.buf, picPrv2.stride, encCfg->m_FrameRate,
-                                                      bitDepth, isHighResolution && (isLuma (compID) || pic->chromaFormat == CHROMA_444));
+                                                      bitDepth, isHighResolution && (isLuma (compID) || pic->chromaFormat == CHROMA_444), threadPool);
     if (isChroma (compID))
     {
       const int adaptChromaQPOffset = 2.0 * hpEner[comp] <= hpEner[0] ? 0 : apprI3Log2 (2.0 * hpEner[comp] / hpEner[0]);
@@ -379,7 +355,8 @@ int BitAllocation::applyQPAdaptationChroma (const Slice* slice, const VVEncCfg*
 
 int BitAllocation::applyQPAdaptationLuma (const Slice* slice, const VVEncCfg* encCfg, const int savedQP, const double lambda,
                                           std::vector<int>& ctuPumpRedQP, std::vector<uint8_t>* ctuRCQPMemory,
-                                          const uint32_t ctuStartAddr, const uint32_t ctuBoundingAddr)
+                                          const uint32_t ctuStartAddr, const uint32_t ctuBoundingAddr,
+                                          NoMallocThreadPool* threadPool /*= nullptr*/)
 {
   Picture* const pic          = (slice != nullptr ? slice->pic : nullptr);
   double hpEnerPic, hpEnerAvg = 0.0;
@@ -397,25 +374,35 @@ int BitAllocation::applyQPAdaptationLuma (const Slice* slice, const VVEncCfg* en
 
   if (!useFrameWiseQPA || (savedQP < 0)) // mean visual activity value and luma value in each CTU
   {
-    const PosType guardSize = (isHighResolution ? 2 : 1);
-    for (uint32_t ctuTsAddr = ctuStartAddr; ctuTsAddr < ctuBoundingAddr; ctuTsAddr++)
+    const uint32_t ctuRowSize = pcv.widthInCtus;
+    const uint32_t numCtuRows = (ctuBoundingAddr - ctuStartAddr + ctuRowSize - 1) / ctuRowSize;
+    std::vector<CtuActivityTask> ctuRows (numCtuRows, CtuActivityTask { pic, (uint32_t) encCfg->m_FrameRate, bitDepth, isHighResolution, ctuStartAddr, ctuBoundingAddr });
+
+    for (uint32_t n = 0; n < numCtuRows; n++)
     {
-      const uint32_t ctuRsAddr = /*tileMap.getCtuBsToRsAddrMap*/ (ctuTsAddr);
-      const Position pos ((ctuRsAddr % pcv.widthInCtus) * pcv.maxCUSize, (ctuRsAddr / pcv.widthInCtus) * pcv.maxCUSize);
-      const CompArea ctuArea   = clipArea (CompArea (COMP_Y, pic->chromaFormat, Area (pos.x, pos.y, pcv.maxCUSize, pcv.maxCUSize)), pic->Y());
-      const SizeType fltWidth  = pcv.maxCUSize + guardSize * (pos.x > 0 ? 2 : 1);
-      const SizeType fltHeight = pcv.maxCUSize + guardSize * (pos.y > 0 ? 2 : 1);
-      const CompArea fltArea   = clipArea (CompArea (COMP_Y, pic->chromaFormat, Area (pos.x > 0 ? pos.x - guardSize : 0, pos.y > 0 ? pos.y - guardSize : 0, fltWidth, fltHeight)), pic->Y());
-      const CPelBuf  picOrig   = pic->getOrigBuf (fltArea);
-      const CPelBuf  picPrv1   = pic->getOrigBufPrev (fltArea, false);
-      const CPelBuf  picPrv2   = pic->getOrigBufPrev (fltArea, true );
-
-      hpEnerPic = filterAndCalculateAverageActivity (picOrig.buf, picOrig.stride, picOrig.height, picOrig.width,
-                                                     picPrv1.buf, picPrv1.stride, picPrv2.buf, picPrv2.stride, encCfg->m_FrameRate,
-                                                     bitDepth, isHighResolution);
-      hpEnerAvg += hpEnerPic;
-      pic->ctuQpaLambda[ctuRsAddr] = hpEnerPic; // temporary backup of CTU mean visual activity
-      pic->ctuAdaptedQP[ctuRsAddr] = pic->getOrigBuf (ctuArea).getAvg(); // and mean luma value
+      ctuRows[n].ctuStartAddr    = ctuStartAddr + n * ctuRowSize;
+      ctuRows[n].ctuBoundingAddr = std::min (ctuBoundingAddr, ctuRows[n].ctuStartAddr + ctuRowSize);
+    }
+    if (threadPool && threadPool->numThreads() > 1 && numCtuRows > 1)
+    {
+      WaitCounter taskCounter;
+
+      for (auto& ctuRow : ctuRows)
+      {
+        static auto task = [] (int, CtuActivityTask* t) { calculateCtuActivity (*t); return true; };
+
+        threadPool->addBarrierTask<CtuActivityTask> (task, &ctuRow, &taskCounter);
+      }
+      taskCounter.wait();
+    }
+    else
+    {
+      for (auto& ctuRow : ctuRows) calculateCtuActivity (ctuRow);
+    }
+
+    for (uint32_t ctuTsAddr = ctuStartAddr; ctuTsAddr < ctuBoundingAddr; ctuTsAddr++) // sum up in CTU order
+    {
+      hpEnerAvg += pic->ctuQpaLambda[/*tileMap.getCtuBsToRsAddrMap*/ (ctuTsAddr)];
     }
 
     hpEnerAvg /= double (ctuBoundingAddr - ctuStartAddr);
@@ -630,7 +617,7 @@ int BitAllocation::getCtuPumpingReducingQP (const Slice* slice, const CPelBuf& o
   return pumpingReducQP;
 }
 
-double BitAllocation::getPicVisualActivity (const Slice* slice, const VVEncCfg* encCfg)
+double BitAllocation::getPicVisualActivity (const Slice* slice, const VVEncCfg* encCfg, NoMallocThreadPool* threadPool /*= nullptr*/)
 {
   Picture* const pic    = (slice != nullptr ? slice->pic : nullptr);
 
@@ -643,7 +630,7 @@ double BitAllocation::getPicVisualActivity (const Slice* slice, const VVEncCfg*
 
   return filterAndCalculateAverageActivity (picOrig.buf, picOrig.stride, picOrig.height, picOrig.width,
                                             picPrv1.buf, picPrv1.stride, picPrv2.buf, picPrv2.stride, encCfg->m_FrameRate,
-                                            slice->sps->bitDepths[CH_L], isHighRes);
+                                            slice->sps->bitDepths[CH_L], isHighRes, threadPool);
 }
 
 } // namespace vvenc
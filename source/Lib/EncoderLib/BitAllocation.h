@@ -59,18 +59,22 @@ THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace vvenc {
 
+  class NoMallocThreadPool;
+
   // BitAllocation functions
   namespace BitAllocation
   {
     int applyQPAdaptationChroma (const Slice* slice, const VVEncCfg* encCfg, const int sliceQP,
-                                 std::vector<int>& ctuPumpRedQP, int optChromaQPOffset[2], double* picVisActY = nullptr);
+                                 std::vector<int>& ctuPumpRedQP, int optChromaQPOffset[2], double* picVisActY = nullptr,
+                                 NoMallocThreadPool* threadPool = nullptr);
     int applyQPAdaptationLuma   (const Slice* slice, const VVEncCfg* encCfg, const int savedQP, const double lambda,
                                  std::vector<int>& ctuPumpRedQP, std::vector<uint8_t>* ctuRCQPMemory,
-                                 const uint32_t ctuStartAddr, const uint32_t ctuBoundingAddr);
+                                 const uint32_t ctuStartAddr, const uint32_t ctuBoundingAddr,
+                                 NoMallocThreadPool* threadPool = nullptr);
     int applyQPAdaptationSubCtu (const Slice* slice, const VVEncCfg* encCfg, const Area& lumaArea);
     int getCtuPumpingReducingQP (const Slice* slice, const CPelBuf& origY, const Distortion uiSadBestForQPA,
                                  std::vector<int>& ctuPumpRedQP, const uint32_t ctuRsAddr, const int baseQP);
-    double getPicVisualActivity (const Slice* slice, const VVEncCfg* encCfg);
+    double getPicVisualActivity (const Slice* slice, const VVEncCfg* encCfg, NoMallocThreadPool* threadPool = nullptr);
   }
 
 } // namespace vvenc
@@ -165,7 +165,8 @@ void CABACWriter::coding_tree_unit( CodingStructure& cs, const UnitArea& area, i
 
   if( !skipSao )
   {
-    sao( *cs.slice, ctuRsAddr );
+    // the picture cs may be shared by all slices, the ctu belongs to the slice of its cu's
+    sao( *cs.getCU( area.lumaPos(), CH_L, TREE_D )->slice, ctuRsAddr );
   }
 
   if (!skipAlf)
@@ -419,7 +420,8 @@ void CABACWriter::coding_tree(const CodingStructure& cs, Partitioner& partitione
     }
   }
 
-  determineNeighborCus( cs, partitioner.currArea(), partitioner.chType, partitioner.treeType );
+  // with multiple slices, the slice of the cu is used, since cs may be shared by all slices of the picture
+  determineNeighborCus( cs, partitioner.currArea(), partitioner.chType, partitioner.treeType, cu.slice );
 
   const PartSplit splitMode = CU::getSplitAtDepth( cu, partitioner.currDepth );
 
@@ -1480,6 +1480,9 @@ void EncAdaptiveLoopFilter::getStatisticsCTU( Picture& pic, CodingStructure& cs,
   int rasterSliceAlfPad = 0;
   if( isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
   {
+    // the shared m_tempBuf2 cannot be used, ctus are processed concurrently
+    PelStorage tempBuf;
+    tempBuf.create( cs.area.chromaFormat, Area( 0, 0, m_maxCUWidth + ( MAX_ALF_PADDING_SIZE << 1 ), m_maxCUHeight + ( MAX_ALF_PADDING_SIZE << 1 ) ), m_maxCUWidth, MAX_ALF_PADDING_SIZE, 0, false );
     int yStart = yPos;
     for( int i = 0; i <= numHorVirBndry; i++ )
     {
@@ -1499,7 +1502,7 @@ void EncAdaptiveLoopFilter::getStatisticsCTU( Picture& pic, CodingStructure& cs,
 
         const int wBuf = w + ( clipL ? 0 : MAX_ALF_PADDING_SIZE ) + ( clipR ? 0 : MAX_ALF_PADDING_SIZE );
         const int hBuf = h + ( clipT ? 0 : MAX_ALF_PADDING_SIZE ) + ( clipB ? 0 : MAX_ALF_PADDING_SIZE );
-        PelUnitBuf  dstBuf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
+        PelUnitBuf  dstBuf = tempBuf.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
         CPelUnitBuf srcBuf = recYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - ( clipL ? 0 : MAX_ALF_PADDING_SIZE ), yStart - ( clipT ? 0 : MAX_ALF_PADDING_SIZE ), wBuf, hBuf ) ) );
         dstBuf.copyFrom( srcBuf );
         // pad top-left unavailable samples for raster slice
@@ -1674,7 +1677,8 @@ void EncAdaptiveLoopFilter::deriveFilter( Picture& pic, CodingStructure& cs, con
   if ( !layerIdx && ( cs.slice->pendingRasInit || cs.slice->isIDRorBLA() || ( cs.slice->nalUnitType == VVENC_NAL_UNIT_CODED_SLICE_CRA && m_encCfg->m_craAPSreset ) ) )
   {
     memset(cs.slice->alfAps, 0, sizeof(*cs.slice->alfAps)*ALF_CTB_MAX_NUM_APS);
-    m_apsIdStart = ALF_CTB_MAX_NUM_APS;
+    // frame parallel temporal prediction: keep the APS id reserved for this picture
+    m_apsIdStart = m_encCfg->m_maxParallelFrames && m_encCfg->m_alfTempPred ? m_apsIdStart : ALF_CTB_MAX_NUM_APS;
     m_apsMap->clearActive();
     for (int i = 0; i < ALF_CTB_MAX_NUM_APS; i++)
     {
@@ -1873,6 +1877,9 @@ void EncAdaptiveLoopFilter::reconstructCTU( Picture& pic, CodingStructure& cs, c
     int rasterSliceAlfPad = 0;
     if( isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
     {
+      // the shared m_tempBuf2 cannot be used, ctus are processed concurrently
+      PelStorage tempBuf;
+      tempBuf.create( cs.area.chromaFormat, Area( 0, 0, m_maxCUWidth + ( MAX_ALF_PADDING_SIZE << 1 ), m_maxCUHeight + ( MAX_ALF_PADDING_SIZE << 1 ) ), m_maxCUWidth, MAX_ALF_PADDING_SIZE, 0, false );
       int yStart = yPos;
       for( int i = 0; i <= numHorVirBndry; i++ )
       {
@@ -1891,8 +1898,17 @@ void EncAdaptiveLoopFilter::reconstructCTU( Picture& pic, CodingStructure& cs, c
 
           const int wBuf = w + ( clipL ? 0 : MAX_ALF_PADDING_SIZE ) + ( clipR ? 0 : MAX_ALF_PADDING_SIZE );
           const int hBuf = h + ( clipT ? 0 : MAX_ALF_PADDING_SIZE ) + ( clipB ? 0 : MAX_ALF_PADDING_SIZE );
-          PelUnitBuf  dstBuf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
-          dstBuf.copyFrom( recExtBufCTU );
+          PelUnitBuf  dstBuf = tempBuf.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
+          // the extended ctu buffer includes the padding area, copy the block including the available padding samples
+          const int xOffset = xStart - xPos - ( clipL ? 0 : MAX_ALF_PADDING_SIZE );
+          const int yOffset = yStart - yPos - ( clipT ? 0 : MAX_ALF_PADDING_SIZE );
+          for( int compIdx = 0; compIdx < getNumberValidComponents( cs.area.chromaFormat ); compIdx++ )
+          {
+            const int scaleX    = getComponentScaleX( ComponentID( compIdx ), cs.area.chromaFormat );
+            const int scaleY    = getComponentScaleY( ComponentID( compIdx ), cs.area.chromaFormat );
+            const CPelBuf& src  = recExtBufCTU.bufs[ compIdx ];
+            dstBuf.bufs[ compIdx ].copyFrom( CPelBuf( src.bufAt( xOffset >> scaleX, yOffset >> scaleY ), src.stride, wBuf >> scaleX, hBuf >> scaleY ) );
+          }
           // pad top-left unavailable samples for raster slice
           if( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
           {
@@ -3117,94 +3133,7 @@ void EncAdaptiveLoopFilter::getPreBlkStats(AlfCovariance* alfCovariance, const A
         }
         else
         {
-#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_ALF
-          if( read_x86_extension_flags() > SCALAR )
-          {
-            const __m128i mylocal0 = _mm_loadu_si128( ( const __m128i* ) &yLocal[0][0] );
-            const __m128i mylocal8 = _mm_loadu_si128( ( const __m128i* ) &yLocal[2][0] );
-
-            for( int k = 0; k < shape.numCoeff; k++ )
-            {
-              const Pel* Elocalk = &ELocal[k << 4];
-              double* cov = &alfCovariance[classIdx].E[0][0][k][k];
-
-              const __m128i melocalk0 = _mm_loadu_si128( ( const __m128i* ) &Elocalk[0] );
-              const __m128i melocalk8 = _mm_loadu_si128( ( const __m128i* ) &Elocalk[8] );
-
-              for( int l = k; l < shape.numCoeff; l++ )
-              {
-                const Pel* Elocall = &ELocal[l << 4];
-                
-                const __m128i melocall0 = _mm_loadu_si128( ( const __m128i* ) &Elocall[0] );
-                const __m128i melocall8 = _mm_loadu_si128( ( const __m128i* ) &Elocall[8] );
-
-                const __m128i mmacc0 = _mm_madd_epi16( melocalk0, melocall0 );
-                const __m128i mmacc8 = _mm_madd_epi16( melocalk8, melocall8 );
-                
-                __m128i mmacc = _mm_add_epi32( mmacc0, mmacc8 );
-                mmacc = _mm_hadd_epi32( mmacc, mmacc );
-                mmacc = _mm_hadd_epi32( mmacc, mmacc );
-
-                *cov++ += _mm_extract_epi32( mmacc, 0 );
-              }
-
-              const __m128i mmacc0 = _mm_madd_epi16( melocalk0, mylocal0 );
-              const __m128i mmacc8 = _mm_madd_epi16( melocalk8, mylocal8 );
-
-              __m128i mmacc = _mm_add_epi32( mmacc0, mmacc8 );
-              mmacc = _mm_hadd_epi32( mmacc, mmacc );
-              mmacc = _mm_hadd_epi32( mmacc, mmacc );
-
-              alfCovariance[classIdx].y[0][k] += _mm_extract_epi32( mmacc, 0 );
-            }
-
-            const __m128i mmacc0 = _mm_madd_epi16( mylocal0, mylocal0 );
-            const __m128i mmacc8 = _mm_madd_epi16( mylocal8, mylocal8 );
-
-            __m128i mmacc = _mm_add_epi32( mmacc0, mmacc8 );
-            mmacc = _mm_hadd_epi32( mmacc, mmacc );
-            mmacc = _mm_hadd_epi32( mmacc, mmacc );
-
-            alfCovariance[classIdx].pixAcc += _mm_extract_epi32( mmacc, 0 );
-          }
-          else
-#endif
-          {
-            for( int k = 0; k < shape.numCoeff; k++ )
-            {
-              const Pel* Elocalk = &ELocal[k << 4];
-              double* cov = &alfCovariance[classIdx].E[0][0][k][k];
-
-              for( int l = k; l < shape.numCoeff; l++ )
-              {
-                const Pel* Elocall = &ELocal[l << 4];
-
-                int64_t sum = 0;
-                for( int ii = 0; ii < 4; ii++ ) for( int jj = 0; jj < 4; jj++ )
-                {
-                  sum += int( Elocall[(ii << 2) + jj] ) * Elocalk[(ii << 2) + jj];
-                }
-
-                *cov++ += sum;
-              }
-
-              int64_t sum = 0;
-              for( int ii = 0; ii < 4; ii++ ) for( int jj = 0; jj < 4; jj++ )
-              {
-                sum += int( Elocalk[(ii << 2) + jj] ) * yLocal[ii][jj];
-              }
-
-              alfCovariance[classIdx].y[0][k] += sum;
-            }
-
-            int64_t sum = 0;
-            for( int ii = 0; ii < 4; ii++ ) for( int jj = 0; jj < 4; jj++ )
-            {
-              sum += int( yLocal[ii][jj] ) * yLocal[ii][jj];
-            }
-
-            alfCovariance[classIdx].pixAcc += sum;
-          }
+          m_calcCovLin4x4( ELocal, &yLocal[0][0], shape.numCoeff, alfCovariance[classIdx].E[0][0], alfCovariance[classIdx].y[0], alfCovariance[classIdx].pixAcc );
         }
 
         alfCovariance[classIdx].all0 = false;
@@ -3255,97 +3184,9 @@ void EncAdaptiveLoopFilter::getPreBlkStats(AlfCovariance* alfCovariance, const A
         //      std::memset( ELocal, 0, sizeof( ELocal ) );
         calcCovariance( ELocal, rec + j, recStride, shape, transposeIdx, channel, vbDistance );
 
-        if( m_alfWSSD )
-        {
-          double weight = m_lumaLevelToWeightPLUT[org[j]];
+        const double weight = m_alfWSSD ? m_lumaLevelToWeightPLUT[org[j]] : 1.0;
 
-          for( int k = 0; k < shape.numCoeff; k++ )
-          {
-            for( int l = k; l < shape.numCoeff; l++ )
-            {
-              int Elocalkb0 = ELocal[k][0];
-              int Elocalkb1 = ELocal[k][1];
-              int Elocalkb2 = ELocal[k][2];
-              int Elocalkb3 = ELocal[k][3];
-
-              int Elocallb0 = ELocal[l][0];
-              int Elocallb1 = ELocal[l][1];
-              int Elocallb2 = ELocal[l][2];
-              int Elocallb3 = ELocal[l][3];
-
-              alfCovariance[classIdx].E[0][0][k][l] += weight * (Elocalkb0 * ( double ) Elocallb0);
-              alfCovariance[classIdx].E[0][1][k][l] += weight * (Elocalkb0 * ( double ) Elocallb1);
-              alfCovariance[classIdx].E[0][2][k][l] += weight * (Elocalkb0 * ( double ) Elocallb2);
-              alfCovariance[classIdx].E[0][3][k][l] += weight * (Elocalkb0 * ( double ) Elocallb3);
-
-              alfCovariance[classIdx].E[1][0][k][l] += weight * (Elocalkb1 * ( double ) Elocallb0);
-              alfCovariance[classIdx].E[1][1][k][l] += weight * (Elocalkb1 * ( double ) Elocallb1);
-              alfCovariance[classIdx].E[1][2][k][l] += weight * (Elocalkb1 * ( double ) Elocallb2);
-              alfCovariance[classIdx].E[1][3][k][l] += weight * (Elocalkb1 * ( double ) Elocallb3);
-
-              alfCovariance[classIdx].E[2][0][k][l] += weight * (Elocalkb2 * ( double ) Elocallb0);
-              alfCovariance[classIdx].E[2][1][k][l] += weight * (Elocalkb2 * ( double ) Elocallb1);
-              alfCovariance[classIdx].E[2][2][k][l] += weight * (Elocalkb2 * ( double ) Elocallb2);
-              alfCovariance[classIdx].E[2][3][k][l] += weight * (Elocalkb2 * ( double ) Elocallb3);
-
-              alfCovariance[classIdx].E[3][0][k][l] += weight * (Elocalkb3 * ( double ) Elocallb0);
-              alfCovariance[classIdx].E[3][1][k][l] += weight * (Elocalkb3 * ( double ) Elocallb1);
-              alfCovariance[classIdx].E[3][2][k][l] += weight * (Elocalkb3 * ( double ) Elocallb2);
-              alfCovariance[classIdx].E[3][3][k][l] += weight * (Elocalkb3 * ( double ) Elocallb3);
-            }
-
-            for( int b = 0; b < numBins; b++ )
-            {
-              alfCovariance[classIdx].y[b][k] += weight * (ELocal[k][b] * ( double ) yLocal);
-            }
-          }
-
-          alfCovariance[classIdx].pixAcc += weight * (yLocal * ( double ) yLocal);
-        }
-        else
-        {
-          for( int k = 0; k < shape.numCoeff; k++ )
-          {
-            for( int l = k; l < shape.numCoeff; l++ )
-            {
-              int Elocalkb0 = ELocal[k][0];
-              int Elocalkb1 = ELocal[k][1];
-              int Elocalkb2 = ELocal[k][2];
-              int Elocalkb3 = ELocal[k][3];
-
-              int Elocallb0 = ELocal[l][0];
-              int Elocallb1 = ELocal[l][1];
-              int Elocallb2 = ELocal[l][2];
-              int Elocallb3 = ELocal[l][3];
-
-              alfCovariance[classIdx].E[0][0][k][l] += Elocalkb0 * Elocallb0;
-              alfCovariance[classIdx].E[0][1][k][l] += Elocalkb0 * Elocallb1;
-              alfCovariance[classIdx].E[0][2][k][l] += Elocalkb0 * Elocallb2;
-              alfCovariance[classIdx].E[0][3][k][l] += Elocalkb0 * Elocallb3;
-
-              alfCovariance[classIdx].E[1][0][k][l] += Elocalkb1 * Elocallb0;
-              alfCovariance[classIdx].E[1][1][k][l] += Elocalkb1 * Elocallb1;
-              alfCovariance[classIdx].E[1][2][k][l] += Elocalkb1 * Elocallb2;
-              alfCovariance[classIdx].E[1][3][k][l] += Elocalkb1 * Elocallb3;
-
-              alfCovariance[classIdx].E[2][0][k][l] += Elocalkb2 * Elocallb0;
-              alfCovariance[classIdx].E[2][1][k][l] += Elocalkb2 * Elocallb1;
-              alfCovariance[classIdx].E[2][2][k][l] += Elocalkb2 * Elocallb2;
-              alfCovariance[classIdx].E[2][3][k][l] += Elocalkb2 * Elocallb3;
-
-              alfCovariance[classIdx].E[3][0][k][l] += Elocalkb3 * Elocallb0;
-              alfCovariance[classIdx].E[3][1][k][l] += Elocalkb3 * Elocallb1;
-              alfCovariance[classIdx].E[3][2][k][l] += Elocalkb3 * Elocallb2;
-              alfCovariance[classIdx].E[3][3][k][l] += Elocalkb3 * Elocallb3;
-            }
-            for( int b = 0; b < numBins; b++ )
-            {
-              alfCovariance[classIdx].y[b][k] += ELocal[k][b] * yLocal;
-            }
-          }
-
-          alfCovariance[classIdx].pixAcc += yLocal * yLocal;
-        }
+        m_calcCovNonLin( ELocal, yLocal, weight, shape.numCoeff, alfCovariance[classIdx].E, alfCovariance[classIdx].y, alfCovariance[classIdx].pixAcc );
 
         alfCovariance[classIdx].all0 = false;
       }
@@ -4329,6 +4170,14 @@ void  EncAdaptiveLoopFilter::alfEncoderCtb( CodingStructure& cs, AlfParam& alfPa
   {
     newApsIdChroma = newApsId;
   }
+  else if( ( alfParamNewFiltersBest.alfEnabled[COMP_Cb] || alfParamNewFiltersBest.alfEnabled[COMP_Cr] ) && m_encCfg->m_maxParallelFrames && m_encCfg->m_alfTempPred )
+  {
+    // frame parallel temporal prediction: only the APS id reserved for this picture may be written
+    if( std::find( bestApsIds.begin(), bestApsIds.end(), newApsId ) == bestApsIds.end() )
+    {
+      newApsIdChroma = newApsId;
+    }
+  }
   else if (alfParamNewFiltersBest.alfEnabled[COMP_Cb] || alfParamNewFiltersBest.alfEnabled[COMP_Cr])
   {
     int curId = m_apsIdStart;
@@ -5312,8 +5161,9 @@ void EncAdaptiveLoopFilter::getBlkStatsCcAlf(AlfCovariance &alfCovariance, const
   int        recStride = recYuv.get(COMP_Y).stride;
   const Pel* rec       = recYuv.get(COMP_Y).bufAt(area.lumaPos());
   
+  // the reconstruction may be a local copy of the block, thus use the local area
   int        slfStride = recYuv.get(compID).stride;
-  const Pel* slf       = recYuv.get(compID).bufAt(compArea);
+  const Pel* slf       = recYuv.get(compID).bufAt(area.block(compID));
 
   int        orgStride = orgYuv.get(compID).stride;
   const Pel *org       = orgYuv.get(compID).bufAt(compArea);
@@ -5336,12 +5186,15 @@ void EncAdaptiveLoopFilter::getBlkStatsCcAlf(AlfCovariance &alfCovariance, const
   Pel yLocal[4][4];
   double weight[4][4];
 
+  // the block might not start at the ctu top, if split by a slice boundary
+  const int yLuma = areaDst.lumaPos().y;
+
   for (int i = 0; i < compArea.height; i += 4)
   {
-    int vbDistance0 = (((i+0) << getComponentScaleX(compID, m_chromaFormat)) % vbCTUHeight) - vbPos;
-    int vbDistance1 = (((i+1) << getComponentScaleX(compID, m_chromaFormat)) % vbCTUHeight) - vbPos;
-    int vbDistance2 = (((i+2) << getComponentScaleX(compID, m_chromaFormat)) % vbCTUHeight) - vbPos;
-    int vbDistance3 = (((i+3) << getComponentScaleX(compID, m_chromaFormat)) % vbCTUHeight) - vbPos;
+    int vbDistance0 = ((yLuma + ((i+0) << getComponentScaleX(compID, m_chromaFormat))) % vbCTUHeight) - vbPos;
+    int vbDistance1 = ((yLuma + ((i+1) << getComponentScaleX(compID, m_chromaFormat))) % vbCTUHeight) - vbPos;
+    int vbDistance2 = ((yLuma + ((i+2) << getComponentScaleX(compID, m_chromaFormat))) % vbCTUHeight) - vbPos;
+    int vbDistance3 = ((yLuma + ((i+3) << getComponentScaleX(compID, m_chromaFormat))) % vbCTUHeight) - vbPos;
 
     const Pel* recLine[4] = { &rec[0], &rec[effStride], &rec[2 * effStride], &rec[3 * effStride] };
     const Pel* orgLine[4] = { &org[0], &org[orgStride], &org[2 * orgStride], &org[3 * orgStride] };
@@ -5396,87 +5249,7 @@ void EncAdaptiveLoopFilter::getBlkStatsCcAlf(AlfCovariance &alfCovariance, const
       }
       else
       {
-#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_ALF
-        if (read_x86_extension_flags() > SCALAR)
-        {
-          const __m128i mylocal0 = _mm_loadu_si128((const __m128i*) & yLocal[0][0]);
-          const __m128i mylocal8 = _mm_loadu_si128((const __m128i*) & yLocal[2][0]);
-
-          for (int k = 0; k < shape.numCoeff; k++)
-          {
-            const Pel* Elocalk = &ELocal[k][0];
-            double* cov = &alfCovariance.E[0][0][k][k];
-
-            const __m128i melocalk0 = _mm_loadu_si128((const __m128i*) & Elocalk[0]);
-            const __m128i melocalk8 = _mm_loadu_si128((const __m128i*) & Elocalk[8]);
-
-            for (int l = k; l < shape.numCoeff; l++)
-            {
-              const Pel* Elocall = &ELocal[l][0];
-
-              const __m128i melocall0 = _mm_loadu_si128((const __m128i*) & Elocall[0]);
-              const __m128i melocall8 = _mm_loadu_si128((const __m128i*) & Elocall[8]);
-
-              const __m128i mmacc0 = _mm_madd_epi16(melocalk0, melocall0);
-              const __m128i mmacc8 = _mm_madd_epi16(melocalk8, melocall8);
-
-              __m128i mmacc = _mm_add_epi32(mmacc0, mmacc8);
-              mmacc = _mm_hadd_epi32(mmacc, mmacc);
-              mmacc = _mm_hadd_epi32(mmacc, mmacc);
-
-              *cov++ += _mm_extract_epi32(mmacc, 0);
-            }
-
-            const __m128i mmacc0 = _mm_madd_epi16(melocalk0, mylocal0);
-            const __m128i mmacc8 = _mm_madd_epi16(melocalk8, mylocal8);
-
-            __m128i mmacc = _mm_add_epi32(mmacc0, mmacc8);
-            mmacc = _mm_hadd_epi32(mmacc, mmacc);
-            mmacc = _mm_hadd_epi32(mmacc, mmacc);
-
-            alfCovariance.y[0][k] += _mm_extract_epi32(mmacc, 0);
-          }
-
-          const __m128i mmacc0 = _mm_madd_epi16(mylocal0, mylocal0);
-          const __m128i mmacc8 = _mm_madd_epi16(mylocal8, mylocal8);
-
-          __m128i mmacc = _mm_add_epi32(mmacc0, mmacc8);
-          mmacc = _mm_hadd_epi32(mmacc, mmacc);
-          mmacc = _mm_hadd_epi32(mmacc, mmacc);
-
-          alfCovariance.pixAcc += _mm_extract_epi32(mmacc, 0);
-        }
-        else
-#endif
-        {
-          for( int k = 0; k < ( shape.numCoeff - 1 ); k++ )
-          {
-            for( int l = k; l < ( shape.numCoeff - 1 ); l++ )
-            {
-              int sum = 0;
-              for (int ii = 0; ii < 4; ii++) for (int jj = 0; jj < 4; jj++)
-              {
-                sum += int( ELocal[k][(ii << 2) + jj] ) * ELocal[l][(ii << 2) + jj];
-              }
-              alfCovariance.E[0][0][k][l] += sum;
-            }
-
-            int sum = 0;
-            for (int ii = 0; ii < 4; ii++) for (int jj = 0; jj < 4; jj++)
-            {
-              sum += int( ELocal[k][(ii << 2) + jj] ) * yLocal[ii][jj];
-            }
-            alfCovariance.y[0][k] += sum;
-          } 
-
-
-          int sum = 0;
-          for (int ii = 0; ii < 4; ii++) for (int jj = 0; jj < 4; jj++)
-          {
-            sum += int( yLocal[ii][jj] ) * yLocal[ii][jj];
-          }
-          alfCovariance.pixAcc += sum;
-        }
+        m_calcCovLin4x4( &ELocal[0][0], &yLocal[0][0], shape.numCoeff - 1, alfCovariance.E[0][0], alfCovariance.y[0], alfCovariance.pixAcc );
       }
     }
     
@@ -0,0 +1,207 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     EncAnalysis.cpp
+\brief    saving and loading of the coding decisions for accelerated re-encodes
+*/
+
+#include "EncAnalysis.h"
+
+#include "CommonLib/Slice.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+static const char     ANALYSIS_FILE_MAGIC[4] = { 'V', 'V', 'A', 'N' };
+static const uint32_t ANALYSIS_FILE_VERSION  = 1;
+
+template<typename T> static inline void writeValue( std::ofstream& file, const T value )
+{
+  file.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+}
+
+template<typename T> static inline T readValue( std::ifstream& file )
+{
+  T value = T( 0 );
+  file.read( reinterpret_cast<char*>( &value ), sizeof( T ) );
+  return value;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+void EncAnalysis::init( const VVEncCfg& encCfg )
+{
+  m_pcEncCfg = &encCfg;
+
+  // the file header holds the parameters the partitioning depends on, all values in native byte order
+  const int32_t header[] = { encCfg.m_PadSourceWidth, encCfg.m_PadSourceHeight, (int32_t)encCfg.m_CTUSize };
+
+  if( encCfg.m_AnalysisSaveFile[0] != '\0' )
+  {
+    m_saveFile.open( encCfg.m_AnalysisSaveFile, std::ios::binary | std::ios::trunc );
+    CHECK( !m_saveFile.is_open(), "cannot open analysis file " << encCfg.m_AnalysisSaveFile << " for writing" );
+
+    m_saveFile.write( ANALYSIS_FILE_MAGIC, sizeof( ANALYSIS_FILE_MAGIC ) );
+    writeValue<uint32_t>( m_saveFile, ANALYSIS_FILE_VERSION );
+    m_saveFile.write( reinterpret_cast<const char*>( header ), sizeof( header ) );
+  }
+
+  if( encCfg.m_AnalysisLoadFile[0] != '\0' )
+  {
+    m_loadFile.open( encCfg.m_AnalysisLoadFile, std::ios::binary );
+    CHECK( !m_loadFile.is_open(), "cannot open analysis file " << encCfg.m_AnalysisLoadFile );
+
+    char    magic[ sizeof( ANALYSIS_FILE_MAGIC ) ];
+    int32_t fileHeader[ sizeof( header ) / sizeof( header[ 0 ] ) ];
+    m_loadFile.read( magic, sizeof( magic ) );
+    CHECK( !m_loadFile.good() || !std::equal( magic, magic + sizeof( magic ), ANALYSIS_FILE_MAGIC ), "not an analysis file: " << encCfg.m_AnalysisLoadFile );
+    const uint32_t version = readValue<uint32_t>( m_loadFile );
+    CHECK( version != ANALYSIS_FILE_VERSION, "unsupported analysis file version " << version << ", expected " << ANALYSIS_FILE_VERSION );
+    m_loadFile.read( reinterpret_cast<char*>( fileHeader ), sizeof( fileHeader ) );
+    CHECK( !m_loadFile.good() || !std::equal( header, header + sizeof( header ) / sizeof( header[ 0 ] ), fileHeader ), "analysis file " << encCfg.m_AnalysisLoadFile << " does not match the picture or CTU size" );
+  }
+}
+
+void EncAnalysis::uninit()
+{
+  if( m_saveFile.is_open() )
+  {
+    m_saveFile.close();
+  }
+  if( m_loadFile.is_open() )
+  {
+    m_loadFile.close();
+  }
+}
+
+void EncAnalysis::savePicture( const Picture& pic )
+{
+  if( !m_saveFile.is_open() )
+  {
+    return;
+  }
+
+  const PicAnalysis& analysis = pic.analysis;
+  CHECK( analysis.poc != pic.poc, "no analysis stored for POC " << pic.poc );
+
+  writeValue<int32_t> ( m_saveFile, analysis.poc );
+  writeValue<uint32_t>( m_saveFile, (uint32_t)analysis.cus.size() );
+
+  for( const AnalysisCu& aCu : analysis.cus )
+  {
+    writeValue<uint16_t>( m_saveFile, aCu.x );
+    writeValue<uint16_t>( m_saveFile, aCu.y );
+    writeValue<uint8_t> ( m_saveFile, aCu.width );
+    writeValue<uint8_t> ( m_saveFile, aCu.height );
+    writeValue<uint8_t> ( m_saveFile, aCu.depth );
+    writeValue<uint8_t> ( m_saveFile, aCu.predMode );
+    writeValue<uint8_t> ( m_saveFile, aCu.flags );
+    writeValue<uint8_t> ( m_saveFile, aCu.intraDir );
+    writeValue<uint8_t> ( m_saveFile, aCu.interDir );
+    for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+    {
+      writeValue<int32_t>( m_saveFile, aCu.refPoc[ l ] );
+      writeValue<int32_t>( m_saveFile, aCu.mv[ l ].hor );
+      writeValue<int32_t>( m_saveFile, aCu.mv[ l ].ver );
+    }
+    writeValue<SplitSeries>( m_saveFile, aCu.splitSeries );
+  }
+
+  CHECK( !m_saveFile.good(), "failed to write analysis file " << m_pcEncCfg->m_AnalysisSaveFile );
+}
+
+void EncAnalysis::loadPicture( Picture& pic )
+{
+  pic.analysis.reset();
+  if( !m_loadFile.is_open() )
+  {
+    return;
+  }
+
+  // the pictures are stored in coding order, a shorter file leaves the remaining pictures without analysis
+  const int      poc    = readValue<int32_t> ( m_loadFile );
+  const uint32_t numCus = readValue<uint32_t>( m_loadFile );
+  if( !m_loadFile.good() )
+  {
+    m_loadFile.close();
+    return;
+  }
+  CHECK( poc != pic.poc, "analysis file " << m_pcEncCfg->m_AnalysisLoadFile << " has POC " << poc << " where POC " << pic.poc << " is coded, the GOP structure differs" );
+
+  pic.analysis.poc = poc;
+  pic.analysis.cus.resize( numCus );
+  for( AnalysisCu& aCu : pic.analysis.cus )
+  {
+    aCu.x        = readValue<uint16_t>( m_loadFile );
+    aCu.y        = readValue<uint16_t>( m_loadFile );
+    aCu.width    = readValue<uint8_t> ( m_loadFile );
+    aCu.height   = readValue<uint8_t> ( m_loadFile );
+    aCu.depth    = readValue<uint8_t> ( m_loadFile );
+    aCu.predMode = readValue<uint8_t> ( m_loadFile );
+    aCu.flags    = readValue<uint8_t> ( m_loadFile );
+    aCu.intraDir = readValue<uint8_t> ( m_loadFile );
+    aCu.interDir = readValue<uint8_t> ( m_loadFile );
+    for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+    {
+      aCu.refPoc[ l ] = readValue<int32_t>( m_loadFile );
+      const int hor   = readValue<int32_t>( m_loadFile );
+      const int ver   = readValue<int32_t>( m_loadFile );
+      aCu.mv[ l ].set( hor, ver );
+    }
+    aCu.splitSeries = readValue<SplitSeries>( m_loadFile );
+  }
+  CHECK( !m_loadFile.good(), "analysis file " << m_pcEncCfg->m_AnalysisLoadFile << " is truncated" );
+
+  pic.analysis.buildMap( pic.lumaSize() );
+}
+
+} // namespace vvenc
+
+//! \}
+
@@ -296,10 +296,9 @@ EncCu::~EncCu()
 // Public member functions
 // ====================================================================================================================
 
-void EncCu::encodeCtu( Picture* pic, int (&prevQP)[MAX_NUM_CH], uint32_t ctuXPosInCtus, uint32_t ctuYPosInCtus )
+void EncCu::encodeCtu( Picture* pic, Slice* slice, int (&prevQP)[MAX_NUM_CH], uint32_t ctuXPosInCtus, uint32_t ctuYPosInCtus )
 {
   CodingStructure&     cs          = *pic->cs;
-  Slice*               slice       = cs.slice;
   const PreCalcValues& pcv         = *cs.pcv;
   const uint32_t       widthInCtus = pcv.widthInCtus;
 
@@ -315,12 +314,13 @@ void EncCu::encodeCtu( Picture* pic, int (&prevQP)[MAX_NUM_CH], uint32_t ctuXPos
   const int ctuRsAddr                 = ctuYPosInCtus * pcv.widthInCtus + ctuXPosInCtus;
   const uint32_t firstCtuRsAddrOfTile = 0;
   const uint32_t tileXPosInCtus       = firstCtuRsAddrOfTile % widthInCtus;
+  const bool     isFirstCtuOfSlice    = ctuRsAddr == slice->sliceMap.ctuAddrInSlice[ 0 ];
 
   const Position pos (ctuXPosInCtus * pcv.maxCUSize, ctuYPosInCtus * pcv.maxCUSize);
   const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, pcv.maxCUSize, pcv.maxCUSize ) );
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
 
-  if ((cs.slice->sliceType != VVENC_I_SLICE || cs.sps->IBC) && ctuXPosInCtus == tileXPosInCtus)
+  if ((slice->sliceType != VVENC_I_SLICE || cs.sps->IBC) && ctuXPosInCtus == tileXPosInCtus)
   {
     cs.motionLutBuf[ctuYPosInCtus].lut.resize(0);
     cs.motionLutBuf[ctuYPosInCtus].lutIbc.resize(0);
@@ -333,14 +333,14 @@ void EncCu::encodeCtu( Picture* pic, int (&prevQP)[MAX_NUM_CH], uint32_t ctuXPos
       m_CABACEstimator->initCtxModels( *slice );
     }
 
-    if( m_pcEncCfg->m_entropyCodingSyncEnabled && ctuYPosInCtus )
+    if( m_pcEncCfg->m_entropyCodingSyncEnabled && ctuYPosInCtus && ! isFirstCtuOfSlice )
     {
       m_CABACEstimator->getCtx() = m_syncPicCtx[ctuYPosInCtus-1];
     }
 
     prevQP[CH_L] = prevQP[CH_C] = slice->sliceQp; // hlm: call CU::predictQP() here!
   }
-  else if (ctuRsAddr == firstCtuRsAddrOfTile )
+  else if (ctuRsAddr == firstCtuRsAddrOfTile || isFirstCtuOfSlice )
   {
     m_CABACEstimator->initCtxModels( *slice );
     prevQP[CH_L] = prevQP[CH_C] = slice->sliceQp; // hlm: call CU::predictQP() here!
@@ -358,7 +358,7 @@ void EncCu::encodeCtu( Picture* pic, int (&prevQP)[MAX_NUM_CH], uint32_t ctuXPos
     prevQP[CH_L] = prevQP[CH_C] = slice->sliceQp; // hlm: call CU::predictQP() here!
   }
 
-  xCompressCtu( cs, ctuArea, ctuRsAddr, prevQP );
+  xCompressCtu( cs, slice, ctuArea, ctuRsAddr, prevQP );
 
   m_CABACEstimator->resetBits();
   m_CABACEstimator->coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr, true, true );
@@ -377,7 +377,7 @@ void EncCu::encodeCtu( Picture* pic, int (&prevQP)[MAX_NUM_CH], uint32_t ctuXPos
 // Protected member functions
 // ====================================================================================================================
 
-void EncCu::xCompressCtu( CodingStructure& cs, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[] )
+void EncCu::xCompressCtu( CodingStructure& cs, Slice* slice, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[] )
 {
   m_modeCtrl.initCTUEncoding( *cs.slice );
 
@@ -399,6 +399,8 @@ void EncCu::xCompressCtu( CodingStructure& cs, const UnitArea& area, const unsig
   CodingStructure *bestCS =  m_pBestCS [0];
   cs.initSubStructure( *tempCS, partitioner->chType, partitioner->currArea(), false, orgBuffer, rspBuffer );
   cs.initSubStructure( *bestCS, partitioner->chType, partitioner->currArea(), false, orgBuffer, rspBuffer );
+  // with multiple slices, the picture cs refers to the first slice, the cu's are assigned to the slice of the ctu
+  tempCS->slice = bestCS->slice = slice;
   m_CABACEstimator->determineNeighborCus( *tempCS, partitioner->currArea(), partitioner->chType, partitioner->treeType );
 
   // copy the relevant area
@@ -438,6 +440,7 @@ void EncCu::xCompressCtu( CodingStructure& cs, const UnitArea& area, const unsig
 
     cs.initSubStructure( *tempCS, partitioner->chType, partitioner->currArea(), false, orgBuffer, rspBuffer );
     cs.initSubStructure( *bestCS, partitioner->chType, partitioner->currArea(), false, orgBuffer, rspBuffer );
+    tempCS->slice = bestCS->slice = slice;
     m_CABACEstimator->determineNeighborCus( *tempCS, partitioner->currArea(), partitioner->chType, partitioner->treeType );
     tempCS->currQP[CH_C] = bestCS->currQP[CH_C] =
     tempCS->baseQP       = bestCS->baseQP       = cs.slice->sliceQp;
@@ -529,7 +532,7 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
           pic->ctuAdaptedQP[ ctuRsAddr ] += pic->encRCPic->picQPOffsetQPA;
           pic->ctuAdaptedQP[ ctuRsAddr ] = Clip3( 0, MAX_QP, (int)pic->ctuAdaptedQP[ ctuRsAddr ] );
           pic->ctuQpaLambda[ ctuRsAddr ] *= pic->encRCPic->picLambdaOffsetQPA;
-          pic->ctuQpaLambda[ ctuRsAddr ] = Clip3( m_pcRateCtrl->encRCGOP->minEstLambda, m_pcRateCtrl->encRCGOP->maxEstLambda, pic->ctuQpaLambda[ ctuRsAddr ] );
+          pic->ctuQpaLambda[ ctuRsAddr ] = Clip3( pic->encRCPic->getRCGOP()->minEstLambda, pic->encRCPic->getRCGOP()->maxEstLambda, pic->ctuQpaLambda[ ctuRsAddr ] );
         }
         m_tempQpDiff = pic->ctuAdaptedQP[ctuRsAddr] - BitAllocation::applyQPAdaptationSubCtu (&slice, m_pcEncCfg, lumaArea );
       }
@@ -229,10 +229,10 @@ public:
   void  setUpLambda           ( Slice& slice, const double dLambda, const int iQP, const bool setSliceLambda, const bool saveUnadjusted);
   void  updateLambda          ( const Slice& slice, const double ctuLambda, const int ctuQP, const int newQP, const bool saveUnadjusted);
 
-  void encodeCtu              ( Picture* pic, int (&prevQP)[MAX_NUM_CH], uint32_t ctuXPosInCtus, uint32_t ctuYPosInCtus );
+  void encodeCtu              ( Picture* pic, Slice* slice, int (&prevQP)[MAX_NUM_CH], uint32_t ctuXPosInCtus, uint32_t ctuYPosInCtus );
 
 private:
-  void  xCompressCtu          ( CodingStructure& cs, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[] );
+  void  xCompressCtu          ( CodingStructure& cs, Slice* slice, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[] );
 
   void xCalDebCost            ( CodingStructure& cs, Partitioner& partitioner );
   Distortion xGetDistortionDb ( CodingStructure& cs, CPelBuf& org, CPelBuf& reco, const CompArea& compArea, bool beforeDb );
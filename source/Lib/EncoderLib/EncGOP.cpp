@@ -250,8 +250,14 @@ EncGOP::EncGOP()
   , m_pcRateCtrl         ( nullptr )
   , m_pcEncHRD           ( nullptr )
   , m_gopApsMap          ( MAX_NUM_APS * MAX_NUM_APS_TYPE )
+  , m_useAlfApsHist      ( false )
+  , m_reconfigPending    ( false )
   , m_threadPool         ( nullptr )
+  , m_sliceCallback      ( nullptr )
+  , m_numSliceBytes      ( 0 )
 {
+  std::fill_n( m_alfApsWriterIdx, ALF_CTB_MAX_NUM_APS, -1 );
+  std::fill_n( m_cabacTableIdx, VVENC_MAX_TLAYER, VVENC_I_SLICE );
 }
 
 
@@ -285,6 +291,15 @@ void EncGOP::init( const VVEncCfg& encCfg, const SPS& sps, const PPS& pps, RateC
   m_seiEncoder.init( encCfg, encHrd );
   m_Reshaper.init  ( encCfg );
 
+  // analysis of the final encoding only, not of a rate control first pass
+  if( rateCtrl.rcIsFinalPass )
+  {
+    m_Analysis.init( encCfg );
+    m_SpeedCtrl.init( encCfg );
+  }
+
+  m_useAlfApsHist = encCfg.m_maxParallelFrames && encCfg.m_alfTempPred && sps.alfEnabled;
+
   m_appliedSwitchDQQ = 0;
   const int maxPicEncoder = ( encCfg.m_maxParallelFrames ) ? encCfg.m_maxParallelFrames : 1;
   for ( int i = 0; i < maxPicEncoder; i++ )
@@ -305,46 +320,6 @@ void EncGOP::init( const VVEncCfg& encCfg, const SPS& sps, const PPS& pps, RateC
 // Class interface
 // ====================================================================================================================
 
-void EncGOP::xGetProcessingLists( std::list<Picture*>& procList, std::list<Picture*>& rcUpdateList )
-{
-  // in lockstep mode, process only pics of same temporal layer
-  const bool lockStepMode  = m_pcEncCfg->m_RCTargetBitrate > 0 && m_pcEncCfg->m_maxParallelFrames > 0;
-  if( lockStepMode )
-  {
-    // start new parallel chunk only, if next output picture is not reconstructed
-    if( m_gopEncListOutput.empty() || ! m_gopEncListOutput.front()->isReconstructed )
-    {
-      const int procTL         = m_gopEncListInput.size() ? m_gopEncListInput.front()->TLayer                      : -1;
-      const int gopId          = m_gopEncListInput.size() ? m_gopEncListInput.front()->poc / m_pcEncCfg->m_GOPSize : -1;
-      const int rcIdxInGop     = m_gopEncListInput.size() ? m_gopEncListInput.front()->rcIdxInGop                  : -1;
-      const int minSerialDepth = m_pcEncCfg->m_maxParallelFrames > 2 ? 1 : 2;  // up to this temporal layer encode pictures only in serial mode
-      const int maxSize        = procTL <= minSerialDepth ? 1 : m_pcEncCfg->m_maxParallelFrames;
-      for( auto pic : m_gopEncListInput )
-      {
-        if( pic->poc / m_pcEncCfg->m_GOPSize == gopId
-            && pic->TLayer == procTL
-            && pic->slices[ 0 ]->checkRefPicsReconstructed() )
-        {
-          procList.push_back    ( pic );
-          rcUpdateList.push_back( pic );
-          // map all pics in a parallel chunk to the same index, improves RC performance
-          pic->rcIdxInGop = rcIdxInGop;
-        }
-        if( (int)procList.size() >= maxSize )
-          break;
-      }
-    }
-  }
-  else
-  {
-    procList = m_gopEncListInput;
-    if( ! m_gopEncListOutput.empty() )
-      rcUpdateList.push_back( m_gopEncListOutput.front() );
-  }
-  CHECK( ! rcUpdateList.empty() && m_gopEncListOutput.empty(),                                                         "first picture in RC update and in output list have to be the same" );
-  CHECK( ! rcUpdateList.empty() && ! m_gopEncListOutput.empty() && rcUpdateList.front() != m_gopEncListOutput.front(), "first picture in RC update and in output list have to be the same" );
-}
-
 void EncGOP::encodePictures( const std::vector<Picture*>& encList, PicList& picList, AccessUnitList& au, bool isEncodeLtRef )
 {
   CHECK( encList.size() == 0 && m_gopEncListOutput.size() == 0, "error: no pictures to be encoded given" );
@@ -355,13 +330,14 @@ void EncGOP::encodePictures( const std::vector<Picture*>& encList, PicList& picL
     xInitPicsInCodingOrder( encList, picList, isEncodeLtRef );
   }
 
-  // get list of pictures to be encoded and used for RC update
-  std::list<Picture*> procList;
-  std::list<Picture*> rcUpdateList;
-  xGetProcessingLists( procList, rcUpdateList );
+  // get list of pictures to be encoded
+  std::list<Picture*> procList = m_gopEncListInput;
 
-  // in lockstep mode, process all pictures in processing list
-  const bool lockStepMode = m_pcEncCfg->m_RCTargetBitrate > 0 && m_pcEncCfg->m_maxParallelFrames > 0;
+  // with rate control in FPP mode, pictures are started in coding order up to max parallel frames ahead of the output picture,
+  // all pictures in this range are started before the output picture is written and its rate control update is done,
+  // therefore each picture sees the same rate control state, independent of the encoding progress of the other pictures
+  const bool rcCodingOrder  = m_pcEncCfg->m_RCTargetBitrate > 0 && m_pcEncCfg->m_maxParallelFrames > 0;
+  const int  rcMaxCodingIdx = rcCodingOrder ? m_gopEncListOutput.front()->codingOrderIdx + m_pcEncCfg->m_maxParallelFrames - 1 : -1;
 
   // encode one picture in serial mode / multiple pictures in FPP mode
   while( true )
@@ -374,16 +350,42 @@ void EncGOP::encodePictures( const std::vector<Picture*>& encList, PicList& picL
       std::unique_lock<std::mutex> lock( m_gopEncMutex, std::defer_lock );
       if( m_pcEncCfg->m_numThreads > 0) lock.lock();
 
-      // in non-lockstep mode, check encoding of output picture done
-      // in lockstep mode, check all pictures encoded
-      if( ( ! lockStepMode && ( m_gopEncListOutput.empty() || m_gopEncListOutput.front()->isReconstructed ) )
-          || ( lockStepMode && procList.empty() && (int)m_freePicEncoderList.size() >= m_pcEncCfg->m_maxParallelFrames ) )
+      // check encoding of output picture done
+      // with rate control, check all pictures up to max coding order index started
+      if( ( m_gopEncListOutput.empty() || m_gopEncListOutput.front()->isReconstructed )
+          && ( ! rcCodingOrder || procList.empty() || procList.front()->codingOrderIdx > rcMaxCodingIdx ) )
       {
         break;
       }
 
       // get next picture ready to be encoded
-      auto picItr             = find_if( procList.begin(), procList.end(), []( auto pic ) { return pic->slices[ 0 ]->checkRefPicsReconstructed(); } );
+      auto picItr = procList.end();
+      if( ! rcCodingOrder )
+      {
+        picItr = find_if( procList.begin(), procList.end(), []( auto pic ) { return pic->slices[ 0 ]->checkRefPicsReconstructed(); } );
+      }
+      else if( ! procList.empty() && procList.front()->codingOrderIdx <= rcMaxCodingIdx && procList.front()->slices[ 0 ]->checkRefPicsReconstructed() )
+      {
+        picItr = procList.begin();
+      }
+
+      // with a pending reconfiguration, the first picture of the next GOP is started after all previous pictures have been finished,
+      // the new configuration is applied in between
+      if( m_reconfigPending && picItr != procList.end() )
+      {
+        auto gopStartItr = find_if( procList.begin(), procList.end(), []( auto pic ) { return pic->rcIdxInGop == 0 && pic->codingOrderIdx > 0; } );
+        if( gopStartItr != procList.end() && (*picItr)->codingOrderIdx >= (*gopStartItr)->codingOrderIdx )
+        {
+          if( picItr == procList.begin() && gopStartItr == procList.begin() && (int)m_freePicEncoderList.size() >= std::max( 1, m_pcEncCfg->m_maxParallelFrames ) )
+          {
+            xApplyReconfig();
+          }
+          else
+          {
+            picItr = procList.end();
+          }
+        }
+      }
       const bool nextPicReady = picItr != procList.end();
 
       // check at least one picture and one pic encoder ready
@@ -419,12 +421,23 @@ void EncGOP::encodePictures( const std::vector<Picture*>& encList, PicList& picL
 
     if( m_pcEncCfg->m_alfTempPred )
     {
-      xSyncAlfAps( *pic, pic->picApsMap, m_gopApsMap );
+      if( m_pcEncCfg->m_maxParallelFrames )
+      {
+        xLoadAlfApsHist( *pic );
+      }
+      else
+      {
+        xSyncAlfAps( *pic, pic->picApsMap, m_gopApsMap );
+      }
     }
     
     // compress next picture
     if( pic->encPic )
     {
+      if( m_SpeedCtrl.isActive() )
+      {
+        m_SpeedCtrl.initPicture( *pic );
+      }
       picEncoder->compressPicture( *pic, *this );
     }
     else
@@ -439,6 +452,10 @@ void EncGOP::encodePictures( const std::vector<Picture*>& encList, PicList& picL
         param->picEncoder->finalizePicture( *param->pic );
         {
           std::lock_guard<std::mutex> lock( param->gopEncoder->m_gopEncMutex );
+          if( param->gopEncoder->m_useAlfApsHist )
+          {
+            param->gopEncoder->xStoreAlfApsHist( *param->pic );
+          }
           param->pic->isReconstructed = true;
           param->gopEncoder->m_freePicEncoderList.push_back( param->picEncoder );
           param->gopEncoder->m_gopEncCond.notify_one();
@@ -452,6 +469,11 @@ void EncGOP::encodePictures( const std::vector<Picture*>& encList, PicList& picL
     else
     {
       picEncoder->finalizePicture( *pic );
+      if( m_useAlfApsHist )
+      {
+        std::lock_guard<std::mutex> lock( m_gopEncMutex );
+        xStoreAlfApsHist( *pic );
+      }
       pic->isReconstructed = true;
       m_freePicEncoderList.push_back( picEncoder );
     }
@@ -469,29 +491,33 @@ void EncGOP::encodePictures( const std::vector<Picture*>& encList, PicList& picL
     xWritePicture( *outPic, au, isEncodeLtRef );
   }
 
-  if( m_pcEncCfg->m_alfTempPred )
+  if( outPic->encPic )
   {
-    xSyncAlfAps( *outPic, m_gopApsMap, outPic->picApsMap );
+    m_Analysis.savePicture( *outPic );
+    if( m_SpeedCtrl.isActive() )
+    {
+      m_SpeedCtrl.finishPicture( *outPic );
+    }
   }
 
-  // update pending RC
-  // first pic has been written to bitstream
-  // therefore we have at least for this picture a valid total bit and head bit count
-  for( auto pic : rcUpdateList )
+  if( m_pcEncCfg->m_alfTempPred )
   {
-    if( pic != outPic )
-    {
-      pic->actualHeadBits  = outPic->actualHeadBits;
-      pic->actualTotalBits = pic->sliceDataStreams[0].getNumberOfWrittenBits();
-    }
-    xUpdateAfterPicRC( pic );
+    xSyncAlfAps( *outPic, m_gopApsMap, outPic->picApsMap );
   }
 
+  // update RC, the picture has been written to bitstream, replace the predicted by the actual bit count
+  xUpdateAfterPicRC( outPic );
+
   if( m_pcEncCfg->m_useAMaxBT )
   {
     m_BlkStat.updateMaxBT( *outPic->slices[0], outPic->picBlkStat );
   }
 
+  if( outPic->encPic && ! outPic->slices[0]->isIntra() )
+  {
+    m_cabacTableIdx[ outPic->TLayer ] = outPic->cabacTableIdxEst;
+  }
+
   outPic->slices[ 0 ]->updateRefPicCounter( -1 );
   outPic->isFinished = true;
 }
@@ -719,6 +745,7 @@ void EncGOP::xInitPicsInCodingOrder( const std::vector<Picture*>& encList, PicLi
       pic->encTime.startTimer();
 
       xInitFirstSlice( *pic, picList, isEncodeLtRef );
+      m_Analysis.loadPicture( *pic );
 
       pic->encTime.stopTimer();
 
@@ -729,6 +756,41 @@ void EncGOP::xInitPicsInCodingOrder( const std::vector<Picture*>& encList, PicLi
 }
 
 
+void EncGOP::reconfig( const VVEncCfg& encCfg )
+{
+  m_reconfigCfg     = encCfg;
+  m_reconfigPending = true;
+}
+
+
+void EncGOP::xApplyReconfig()
+{
+  // no picture is being encoded, therefore the configuration can be changed in place
+  VVEncCfg& encCfg  = const_cast<VVEncCfg&>( *m_pcEncCfg );
+  const int deltaQP = m_reconfigCfg.m_QP - encCfg.m_QP;
+  encCfg = m_reconfigCfg;
+
+  // pictures waiting for encoding have been initialized with the previous base QP
+  if( deltaQP != 0 )
+  {
+    for( auto pic : m_gopEncListInput )
+    {
+      pic->seqBaseQp += deltaQP;
+    }
+  }
+  if( encCfg.m_RCTargetBitrate > 0 && encCfg.m_RCTargetBitrate != m_pcRateCtrl->encRCSeq->targetRate )
+  {
+    m_pcRateCtrl->encRCSeq->setTargetRate( encCfg.m_RCTargetBitrate );
+  }
+  if( m_threadPool )
+  {
+    m_threadPool->setNumActiveThreads( encCfg.m_numThreads );
+  }
+
+  m_reconfigPending = false;
+}
+
+
 void EncGOP::xInitFirstSlice( Picture& pic, PicList& picList, bool isEncodeLtRef )
 {
   const int curPoc      = pic.getPOC();
@@ -741,8 +803,9 @@ void EncGOP::xInitFirstSlice( Picture& pic, PicList& picList, bool isEncodeLtRef
   SliceType sliceType   = ( curPoc % (unsigned)(m_pcEncCfg->m_IntraPeriod) == 0 || m_pcEncCfg->m_GOPList[ gopId ].m_sliceType== 'I' ) ? ( VVENC_I_SLICE ) : ( m_pcEncCfg->m_GOPList[ gopId ].m_sliceType== 'P' ? VVENC_P_SLICE : VVENC_B_SLICE );
   vvencNalUnitType naluType  = xGetNalUnitType( curPoc, m_lastIDR );
 
-  pic.rcIdxInGop = std::max( 0, m_codingOrderIdx - 1 ) % m_pcEncCfg->m_GOPSize;
-  m_codingOrderIdx += 1;
+  pic.rcIdxInGop     = std::max( 0, m_codingOrderIdx - 1 ) % m_pcEncCfg->m_GOPSize;
+  pic.codingOrderIdx = m_codingOrderIdx;
+  m_codingOrderIdx  += 1;
 
   // update IRAP
   if ( naluType == VVENC_NAL_UNIT_CODED_SLICE_IDR_W_RADL
@@ -760,6 +823,7 @@ void EncGOP::xInitFirstSlice( Picture& pic, PicList& picList, bool isEncodeLtRef
   }
 
   slice->picHeader                 = pic.cs->picHeader;
+  slice->pictureHeaderInSliceHeader = slice->pps->numSlicesInPic <= 1;
   slice->independentSliceIdx       = 0;
   slice->sliceType                 = sliceType;
   slice->poc                       = curPoc;
@@ -877,6 +941,10 @@ void EncGOP::xInitFirstSlice( Picture& pic, PicList& picList, bool isEncodeLtRef
   // update RAS
   xUpdateRasInit( slice );
 
+  // CABAC init table from the last finished picture of the same temporal layer, pictures are finished in coding order,
+  // thus independent of the number of pictures encoded in parallel, and independently encoded chunks stay bit-equal
+  slice->encCABACTableIdx = ! slice->pps->cabacInitPresent || slice->pendingRasInit ? slice->sliceType : m_cabacTableIdx[ slice->TLayer ];
+
   if ( m_pcEncCfg->m_useAMaxBT )
   {
     m_BlkStat.setSliceMaxBT( *slice );
@@ -944,6 +1012,10 @@ void EncGOP::xInitFirstSlice( Picture& pic, PicList& picList, bool isEncodeLtRef
       alfAPS->ccAlfParam.reset();
     }
   }
+  if( m_useAlfApsHist )
+  {
+    xInitAlfApsDeps( pic );
+  }
   CHECK( slice->enableDRAPSEI && m_pcEncCfg->m_maxParallelFrames, "Dependent Random Access Point is not supported by Frame Parallel Processing" );
 
   if( pic.poc == m_pcEncCfg->m_switchPOC ) 
@@ -1329,6 +1401,126 @@ void EncGOP::xSyncAlfAps( Picture& pic, ParameterSetMap<APS>& dst, const Paramet
   }
 }
 
+void EncGOP::xInitAlfApsDeps( Picture& pic )
+{
+  // frame parallel ALF temporal prediction: each picture writes new filters only into its own APS slot (assigned in coding order),
+  // and a slot can only be reused, if the last picture assigned to it is a (transitive) reference, thus finished before this picture starts
+  const Slice& slice = *pic.slices[ 0 ];
+  pic.refAncestorMask = 0;
+  for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+  {
+    for( int refIdx = 0; refIdx < slice.numRefIdx[ refList ]; refIdx++ )
+    {
+      const Picture* refPic = slice.refPicList[ refList ][ refIdx ];
+      const int dist        = pic.codingOrderIdx - refPic->codingOrderIdx;
+      CHECK( dist <= 0, "reference picture has to precede current picture in coding order" );
+      if( dist <= 64 ) pic.refAncestorMask |= 1ull << ( dist - 1 );
+      if( dist <  64 ) pic.refAncestorMask |= refPic->refAncestorMask << dist;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock( m_gopEncMutex );
+
+  for( int i = 0; i < ALF_CTB_MAX_NUM_APS; i++ )
+  {
+    const int writerIdx  = m_alfApsWriterIdx[ i ];
+    const int dist       = pic.codingOrderIdx - writerIdx;
+    const bool isRef     = writerIdx >= 0 && dist <= 64 && ( ( pic.refAncestorMask >> ( dist - 1 ) ) & 1 );
+    pic.alfApsSrcIdx[ i ] = isRef ? writerIdx : -1;
+    if( isRef )
+    {
+      m_alfApsHist[ writerIdx ].numUsers += 1;
+    }
+  }
+
+  // APS reset on IRAP and pending RAS (see EncAdaptiveLoopFilter::deriveFilter) invalidates all slots for following pictures
+  if( slice.pendingRasInit || slice.isIDRorBLA() || ( slice.nalUnitType == VVENC_NAL_UNIT_CODED_SLICE_CRA && m_pcEncCfg->m_craAPSreset ) )
+  {
+    std::fill_n( m_alfApsWriterIdx, ALF_CTB_MAX_NUM_APS, pic.codingOrderIdx );
+  }
+  m_alfApsWriterIdx[ pic.codingOrderIdx % ALF_CTB_MAX_NUM_APS ] = pic.codingOrderIdx;
+  m_alfApsHist[ pic.codingOrderIdx ];
+
+  xPruneAlfApsHist();
+}
+
+void EncGOP::xLoadAlfApsHist( Picture& pic )
+{
+  std::lock_guard<std::mutex> lock( m_gopEncMutex );
+
+  ParameterSetMap<APS>& apsMap = pic.picApsMap;
+  apsMap.clearActive();
+  for( int i = 0; i < ALF_CTB_MAX_NUM_APS; i++ )
+  {
+    const int apsMapIdx = ( i << NUM_APS_TYPE_LEN ) + ALF_APS;
+    const int srcIdx    = pic.alfApsSrcIdx[ i ];
+    APS* alfAPS         = apsMap.getPS( apsMapIdx );
+    if( srcIdx >= 0 )
+    {
+      auto histItr = m_alfApsHist.find( srcIdx );
+      CHECK( histItr == m_alfApsHist.end() || ! histItr->second.isStored, "ALF APS of reference picture not available" );
+      if( ! alfAPS )
+      {
+        alfAPS = apsMap.allocatePS( apsMapIdx );
+      }
+      *alfAPS = histItr->second.alfAps[ i ];
+      histItr->second.numUsers -= 1;
+    }
+    else if( alfAPS )
+    {
+      alfAPS->alfParam.reset();
+      alfAPS->ccAlfParam.reset();
+    }
+    if( alfAPS )
+    {
+      apsMap.clearChangedFlag( apsMapIdx );
+    }
+  }
+  // start APS id search behind the slot of the picture, so that new filters are written into this slot
+  apsMap.setApsIdStart( ( pic.codingOrderIdx + 1 ) % ALF_CTB_MAX_NUM_APS );
+
+  xPruneAlfApsHist();
+}
+
+void EncGOP::xStoreAlfApsHist( const Picture& pic )
+{
+  AlfApsHistEntry& hist = m_alfApsHist[ pic.codingOrderIdx ];
+  hist.isStored         = true;
+  for( int i = 0; i < ALF_CTB_MAX_NUM_APS; i++ )
+  {
+    const APS* alfAPS = pic.picApsMap.getPS( ( i << NUM_APS_TYPE_LEN ) + ALF_APS );
+    if( alfAPS )
+    {
+      hist.alfAps[ i ] = *alfAPS;
+    }
+    else
+    {
+      hist.alfAps[ i ]         = APS();
+      hist.alfAps[ i ].apsId   = i;
+      hist.alfAps[ i ].apsType = ALF_APS;
+      hist.alfAps[ i ].alfParam.reset();
+      hist.alfAps[ i ].ccAlfParam.reset();
+    }
+  }
+}
+
+void EncGOP::xPruneAlfApsHist()
+{
+  // drop stored APS states, which are neither used by a pending picture nor by a current slot writer
+  for( auto histItr = m_alfApsHist.begin(); histItr != m_alfApsHist.end(); )
+  {
+    const bool isWriter = std::find( m_alfApsWriterIdx, m_alfApsWriterIdx + ALF_CTB_MAX_NUM_APS, histItr->first ) != m_alfApsWriterIdx + ALF_CTB_MAX_NUM_APS;
+    if( histItr->second.isStored && histItr->second.numUsers == 0 && ! isWriter )
+    {
+      histItr = m_alfApsHist.erase( histItr );
+    }
+    else
+    {
+      histItr++;
+    }
+  }
+}
+
 void EncGOP::xWritePicture( Picture& pic, AccessUnitList& au, bool isEncodeLtRef )
 {
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "bsfinal", 1 ) );
@@ -1342,14 +1534,20 @@ void EncGOP::xWritePicture( Picture& pic, AccessUnitList& au, bool isEncodeLtRef
     au.sliceType = pic.slices[ 0 ]->sliceType;
   }
 
-  pic.actualTotalBits += xWriteParameterSets( pic, au, m_HLSWriter );
-  xWriteLeadingSEIs( pic, au );
-  pic.actualTotalBits += xWritePictureSlices( pic, au, m_HLSWriter );
+  // slices already written during encoding (slice streaming) precede the remaining slices
+  au.splice( au.end(), m_streamAu );
+  while( pic.numSlicesWritten < (int)pic.slices.size() )
+  {
+    xWritePictureSlice( pic, au, m_HLSWriter );
+  }
 
   pic.encTime.stopTimer();
 
   std::string digestStr;
-  xWriteTrailingSEIs( pic, au, digestStr );
+  AccessUnitList trailingAu;
+  xWriteTrailingSEIs( pic, trailingAu, digestStr );
+  xSliceCallback    ( pic, trailingAu, false );
+  au.splice( au.end(), trailingAu );
   xPrintPictureInfo ( pic, au, digestStr, m_pcEncCfg->m_printFrameMSE, isEncodeLtRef );
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "bsfinal", 0 ) );
 }
@@ -1440,39 +1638,91 @@ int EncGOP::xWriteParameterSets( Picture& pic, AccessUnitList& accessUnit, HLSWr
 }
 
 
-int EncGOP::xWritePictureSlices( Picture& pic, AccessUnitList& accessUnit, HLSWriter& hlsWriter )
+void EncGOP::xWritePictureSlice( Picture& pic, AccessUnitList& accessUnit, HLSWriter& hlsWriter )
 {
-  Slice* slice        = pic.slices[ 0 ];
+  const int sliceIdx  = pic.numSlicesWritten;
   const int numSlices = (int)( pic.slices.size() );
-  unsigned  numBytes  = 0;
+  Slice* slice        = pic.slices[ sliceIdx ];
+  AccessUnitList sliceAu;
 
-  for ( int sliceIdx = 0; sliceIdx < numSlices; sliceIdx++ )
+  if( sliceIdx == 0 )
   {
-    slice = pic.slices[ sliceIdx ];
+    m_numSliceBytes = 0;
+
+    // parameter sets, leading SEI messages and picture header precede the first slice
+    pic.actualTotalBits += xWriteParameterSets( pic, sliceAu, hlsWriter );
+    xWriteLeadingSEIs( pic, sliceAu );
 
-    if ( sliceIdx > 0 && slice->sliceType != VVENC_I_SLICE )
+    if( ! slice->pictureHeaderInSliceHeader )
     {
-      slice->checkColRefIdx( sliceIdx, &pic );
+      OutputNALUnit nalu( VVENC_NAL_UNIT_PH, slice->TLayer );
+      hlsWriter.setBitstream( &nalu.m_Bitstream );
+      int bitsBeforeWriting = hlsWriter.getNumberOfWrittenBits();
+      hlsWriter.codePictureHeader( slice->picHeader, true );
+      pic.actualHeadBits += ( hlsWriter.getNumberOfWrittenBits() - bitsBeforeWriting );
+      sliceAu.push_back( new NALUnitEBSP( nalu ) );
+      pic.actualTotalBits += (int)( sliceAu.back()->m_nalUnitData.str().size() ) * 8;
     }
+  }
+  else if( slice->sliceType != VVENC_I_SLICE )
+  {
+    slice->checkColRefIdx( sliceIdx, &pic );
+  }
 
-    // start slice NALUnit
-    OutputNALUnit nalu( slice->nalUnitType, slice->TLayer );
-    hlsWriter.setBitstream( &nalu.m_Bitstream );
+  // start slice NALUnit
+  OutputNALUnit nalu( slice->nalUnitType, slice->TLayer );
+  hlsWriter.setBitstream( &nalu.m_Bitstream );
 
-    // slice header and data
-    int bitsBeforeWriting = hlsWriter.getNumberOfWrittenBits();
-    hlsWriter.codeSliceHeader( slice );
-    pic.actualHeadBits += ( hlsWriter.getNumberOfWrittenBits() - bitsBeforeWriting );
-    hlsWriter.codeTilesWPPEntryPoint( slice );
-    xAttachSliceDataToNalUnit( nalu, &pic.sliceDataStreams[ sliceIdx ] );
+  // slice header and data
+  int bitsBeforeWriting = hlsWriter.getNumberOfWrittenBits();
+  hlsWriter.codeSliceHeader( slice );
+  pic.actualHeadBits += ( hlsWriter.getNumberOfWrittenBits() - bitsBeforeWriting );
+  hlsWriter.codeTilesWPPEntryPoint( slice );
+  xAttachSliceDataToNalUnit( nalu, &pic.sliceDataStreams[ sliceIdx ] );
 
-    accessUnit.push_back( new NALUnitEBSP( nalu ) );
-    numBytes += unsigned( accessUnit.back()->m_nalUnitData.str().size() );
+  sliceAu.push_back( new NALUnitEBSP( nalu ) );
+  const unsigned numBytes = unsigned( sliceAu.back()->m_nalUnitData.str().size() );
+  pic.actualTotalBits    += numBytes * 8;
+  m_numSliceBytes        += numBytes;
+
+  if( sliceIdx == numSlices - 1 )
+  {
+    xCabacZeroWordPadding( pic, slice, pic.sliceDataNumBins, m_numSliceBytes, sliceAu.back()->m_nalUnitData );
   }
 
-  xCabacZeroWordPadding( pic, slice, pic.sliceDataNumBins, numBytes, accessUnit.back()->m_nalUnitData );
+  pic.numSlicesWritten += 1;
+  xSliceCallback( pic, sliceAu, sliceIdx == 0 );
+  accessUnit.splice( accessUnit.end(), sliceAu );
+}
+
+void EncGOP::xSliceCallback( const Picture& pic, AccessUnitList& sliceAu, bool isAuStart )
+{
+  if( ! m_sliceCallback || ! m_pcRateCtrl->rcIsFinalPass || sliceAu.empty() )
+  {
+    return;
+  }
+
+  sliceAu.poc           = pic.poc;
+  sliceAu.temporalLayer = pic.TLayer;
+  sliceAu.refPic        = pic.isReferenced;
+  sliceAu.sliceType     = pic.slices[ 0 ]->sliceType;
+
+  m_sliceCallback( sliceAu, isAuStart );
+}
+
+bool EncGOP::isSliceStreamingEnabled() const
+{
+  // slices can be written while the picture is encoded, when no filter has to be derived for the whole picture (ALF),
+  // and the pictures are written in coding order without any other picture being encoded in between
+  return m_sliceCallback && m_pcRateCtrl->rcIsFinalPass && ! m_pcEncCfg->m_alf && m_pcEncCfg->m_maxParallelFrames <= 1;
+}
+
+void EncGOP::writeStreamingSlice( Picture& pic, int sliceIdx )
+{
+  CHECK( sliceIdx != pic.numSlicesWritten, "slices have to be written in order" );
+  CHECK( sliceIdx == 0 && ! m_streamAu.empty(), "NAL units of the previous picture have not been output" );
 
-  return numBytes * 8;
+  xWritePictureSlice( pic, m_streamAu, m_HLSWriter );
 }
 
 void EncGOP::xWriteLeadingSEIs( const Picture& pic, AccessUnitList& accessUnit )
@@ -1724,7 +1974,7 @@ void EncGOP::picInitRateControl( int gopId, Picture& pic, Slice* slice, EncPictu
 
   const int frameLevel = (slice->isIntra() ? 0 : slice->TLayer + 1);
   EncRCPic* encRCPic   = pic.encRCPic;
-  double lambda = (m_pcEncCfg->m_RCNumPasses != 2 ? encRCPic->finalLambda : m_pcRateCtrl->encRCGOP->maxEstLambda);
+  double lambda = (m_pcEncCfg->m_RCNumPasses != 2 ? encRCPic->finalLambda : encRCPic->getRCGOP()->maxEstLambda);
   int   sliceQP = (m_pcEncCfg->m_RCNumPasses != 2 ? m_pcEncCfg->m_RCInitialQP : MAX_QP);
 
   if ((m_pcEncCfg->m_RCNumPasses != 2) && ((slice->poc == 0 && m_pcEncCfg->m_RCInitialQP > 0) || (frameLevel == 0 && m_pcEncCfg->m_RCForceIntraQP))) // QP is specified
@@ -1782,8 +2032,15 @@ void EncGOP::picInitRateControl( int gopId, Picture& pic, Slice* slice, EncPictu
           d = firstPassSliceQP - (105.0 / 128.0) * sqrt ((double) std::max (1, firstPassSliceQP)) * log (d) / log (2.0);
           sliceQP = int (0.5 + d + 0.125 * log2HeightMinus7 * std::max (0.0, 24.0 + 0.001/*log2HeightMinus7*/ * (log ((double) visAct) / log (2.0) - 0.5 * encRCSeq->bitDepth - 3.0) - d) + encRCSeq->qpCorrection[frameLevel]);
           encRCPic->clipTargetQP (m_pcRateCtrl->getPicList(), sliceQP);  // temp. level based
-          lambda  = it->lambda * pow (2.0, double (sliceQP - firstPassSliceQP) / 3.0);
-          lambda  = Clip3 (m_pcRateCtrl->encRCGOP->minEstLambda, m_pcRateCtrl->encRCGOP->maxEstLambda, lambda);
+          if (it->lambda > 0.0)
+          {
+            lambda = it->lambda * pow (2.0, double (sliceQP - firstPassSliceQP) / 3.0);
+          }
+          else // statistics estimated by the lookahead, derive lambda from the initial slice lambda
+          {
+            lambda = slice->getLambdas()[0] * pow (2.0, double (sliceQP - slice->sliceQp) / 3.0);
+          }
+          lambda  = Clip3 (encRCPic->getRCGOP()->minEstLambda, encRCPic->getRCGOP()->maxEstLambda, lambda);
 
           if (it->isIntra) // update history, for parameter clipping in subsequent key frames
           {
@@ -1823,6 +2080,8 @@ void EncGOP::picInitRateControl( int gopId, Picture& pic, Slice* slice, EncPictu
 
   picEncoder->getEncSlice()->resetQP (&pic, sliceQP, lambda);
   encRCPic->finalLambda = lambda;
+  encRCPic->updateBeforePicture( sliceQP, lambda, slice->isIRAP() );
+  encRCPic->addToPictureList( m_pcRateCtrl->getPicList() );
 }
 
 void EncGOP::xUpdateAfterPicRC( const Picture* pic )
@@ -1838,20 +2097,6 @@ void EncGOP::xUpdateAfterPicRC( const Picture* pic )
     encRCPic->calPicMSE();
   }
   encRCPic->updateAfterPicture( pic->actualHeadBits, pic->actualTotalBits, pic->slices[ 0 ]->sliceQp, pic->slices[ 0 ]->lambdas[ COMP_Y ], pic->slices[ 0 ]->isIRAP() );
-  encRCPic->addToPictureList( m_pcRateCtrl->getPicList() );
-
-  m_pcRateCtrl->encRCSeq->updateAfterPic( pic->actualTotalBits, encRCPic->tmpTargetBits );
-  if (!m_pcRateCtrl->encRCSeq->twoPass)
-  {
-    if ( !pic->slices[ 0 ]->isIRAP() )
-    {
-      m_pcRateCtrl->encRCGOP->updateAfterPicture( pic->actualTotalBits );
-    }
-    else    // for intra picture, the estimated bits are used to update the current status in the GOP
-    {
-      m_pcRateCtrl->encRCGOP->updateAfterPicture( encRCPic->estimatedBits );
-    }
-  }
 
   return;
 }
@@ -1928,7 +2173,7 @@ void EncGOP::xCalculateAddPSNR( const Picture* pic, CPelUnitBuf cPicD, AccessUni
 
   if ((m_pcEncCfg->m_RCNumPasses == 2) && (m_pcRateCtrl->rcPass < m_pcRateCtrl->rcMaxPass))
   {
-    visualActivity = (pic->picVisActY > 0.0 ? pic->picVisActY : BitAllocation::getPicVisualActivity (slice, m_pcEncCfg));
+    visualActivity = (pic->picVisActY > 0.0 ? pic->picVisActY : BitAllocation::getPicVisualActivity (slice, m_pcEncCfg, m_threadPool));
   }
   m_pcRateCtrl->addRCPassStats (slice->poc, slice->sliceQp, slice->getLambdas()[0], ClipBD (uint16_t (0.5 + visualActivity), m_pcEncCfg->m_internalBitDepth[CH_L]),
                                 uibits, dPSNR[COMP_Y], slice->isIntra(), slice->TLayer);
@@ -2024,6 +2269,13 @@ void EncGOP::xCalculateAddPSNR( const Picture* pic, CPelUnitBuf cPicD, AccessUni
       accessUnit.InfoString.append( cEncTime );
       msg(VVENC_NOTICE, cEncTime.c_str() );
 
+      if( m_SpeedCtrl.isActive() )
+      {
+        std::string cSpeedLevel = print(" [SL %d]", pic->speedLevel );
+        accessUnit.InfoString.append( cSpeedLevel );
+        msg(VVENC_NOTICE, cSpeedLevel.c_str() );
+      }
+
       std::string cRefPics;
       for( int iRefList = 0; iRefList < 2; iRefList++ )
       {
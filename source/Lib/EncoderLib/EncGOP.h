@@ -56,6 +56,8 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include "Analyze.h"
 #include "EncPicture.h"
 #include "EncReshape.h"
+#include "EncAnalysis.h"
+#include "EncSpeedCtrl.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Nal.h"
@@ -63,6 +65,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <vector>
 #include <list>
+#include <map>
 #include <stdlib.h>
 #include <atomic>
 
@@ -70,6 +73,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include "Utilities/NoMallocThreadPool.h"
 #include <mutex>
 #include <condition_variable>
+#include <functional>
 
 //! \ingroup EncoderLib
 //! \{
@@ -116,6 +120,16 @@ struct FinishTaskParam {
 
 // ====================================================================================================================
 
+struct AlfApsHistEntry
+{
+  int  numUsers;
+  bool isStored;
+  APS  alfAps[ ALF_CTB_MAX_NUM_APS ];
+  AlfApsHistEntry() : numUsers( 0 ), isStored( false ) {}
+};
+
+// ====================================================================================================================
+
 class EncGOP
 {
 private:
@@ -142,20 +156,33 @@ private:
   SEIEncoder                m_seiEncoder;
   EncReshape                m_Reshaper;
   BlkStat                   m_BlkStat;
+  EncAnalysis               m_Analysis;
+  EncSpeedCtrl              m_SpeedCtrl;
   FFwdDecoder               m_ffwdDecoder;
   RateCtrl*                 m_pcRateCtrl;
   EncHRD*                   m_pcEncHRD;
   ParameterSetMap<APS>      m_gopApsMap;
+  int                       m_alfApsWriterIdx[ ALF_CTB_MAX_NUM_APS ];
+  SliceType                 m_cabacTableIdx[ VVENC_MAX_TLAYER ];
+  std::map<int, AlfApsHistEntry> m_alfApsHist;
+  bool                      m_useAlfApsHist;
 
   std::list<EncPicture*>    m_freePicEncoderList;
   std::list<Picture*>       m_gopEncListInput;
 
   std::vector<int>          m_globalCtuQpVector;
 
+  bool                      m_reconfigPending;
+  VVEncCfg                  m_reconfigCfg;
+
   NoMallocThreadPool*       m_threadPool;
   std::mutex                m_gopEncMutex;
   std::condition_variable   m_gopEncCond;
 
+  std::function<void( AccessUnitList&, bool )> m_sliceCallback;
+  AccessUnitList            m_streamAu;                   ///< NAL units of the slices written while the picture is encoded
+  unsigned                  m_numSliceBytes;
+
 public:
   std::list<Picture*>       m_gopEncListOutput;
 
@@ -167,11 +194,16 @@ public:
   void encodePictures     ( const std::vector<Picture*>& encList, PicList& picList, AccessUnitList& au, bool isEncodeLtRef );
   void printOutSummary    ( int numAllPicCoded, const bool printMSEBasedSNR, const bool printSequenceMSE, const bool printHexPsnr, const BitDepths &bitDepths );
   void picInitRateControl ( int gopId, Picture& pic, Slice* slice, EncPicture *picEncoder );
+  void reconfig           ( const VVEncCfg& encCfg );
   ParameterSetMap<APS>&       getSharedApsMap()       { return m_gopApsMap; }
   const ParameterSetMap<APS>& getSharedApsMap() const { return m_gopApsMap; }
   bool                        anyFramesInOutputQueue() { return !m_gopEncListOutput.empty(); }
   const EncReshape&           getReshaper() const      { return m_Reshaper; }
 
+  void setSliceCallback       ( std::function<void( AccessUnitList&, bool )> callback ) { m_sliceCallback = callback; }
+  bool isSliceStreamingEnabled() const;
+  void writeStreamingSlice    ( Picture& pic, int sliceIdx );
+
 private:
   void xUpdateRasInit                 ( Slice* slice );
 
@@ -180,7 +212,7 @@ private:
   bool xIsSliceTemporalSwitchingPoint ( const Slice* slice, PicList& picList, int gopId ) const;
 
   void xInitPicsInCodingOrder         ( const std::vector<Picture*>& encList, PicList& picList, bool isEncodeLtRef );
-  void xGetProcessingLists            ( std::list<Picture*>& procList, std::list<Picture*>& rcUpdateList );
+  void xApplyReconfig                 ();
   void xInitFirstSlice                ( Picture& pic, PicList& picList, bool isEncodeLtRef );
   void xInitSliceTMVPFlag             ( PicHeader* picHeader, const Slice* slice, int gopId );
   void xUpdateRPRtmvp                 ( PicHeader* picHeader, Slice* slice );
@@ -189,10 +221,15 @@ private:
   void xInitLMCS                      ( Picture& pic );
   void xSelectReferencePictureList    ( Slice* slice, int curPoc, int gopId, int ltPoc );
   void xSyncAlfAps                    ( Picture& pic, ParameterSetMap<APS>& dst, const ParameterSetMap<APS>& src );
+  void xInitAlfApsDeps                ( Picture& pic );
+  void xLoadAlfApsHist                ( Picture& pic );
+  void xStoreAlfApsHist               ( const Picture& pic );
+  void xPruneAlfApsHist               ();
 
   void xWritePicture                  ( Picture& pic, AccessUnitList& au, bool isEncodeLtRef );
   int  xWriteParameterSets            ( Picture& pic, AccessUnitList& accessUnit, HLSWriter& hlsWriter );
-  int  xWritePictureSlices            ( Picture& pic, AccessUnitList& accessUnit, HLSWriter& hlsWriter );
+  void xWritePictureSlice             ( Picture& pic, AccessUnitList& accessUnit, HLSWriter& hlsWriter );
+  void xSliceCallback                 ( const Picture& pic, AccessUnitList& sliceAu, bool isAuStart );
   void xWriteLeadingSEIs              ( const Picture& pic, AccessUnitList& accessUnit );
   void xWriteTrailingSEIs             ( const Picture& pic, AccessUnitList& accessUnit, std::string& digestStr );
   int  xWriteVPS                      ( AccessUnitList &accessUnit, const VPS *vps, HLSWriter& hlsWriter );
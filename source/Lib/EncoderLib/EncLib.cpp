@@ -50,6 +50,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "EncLib.h"
+#include "EncSplitModel.h"
 
 #include "CommonLib/Picture.h"
 #include "CommonLib/CommonDef.h"
@@ -71,6 +72,7 @@ EncLib::EncLib()
   , m_cGOPEncoder   ( nullptr )
   , m_RecYUVBufferCallback     ( nullptr )
   , m_RecYUVBufferCallbackCtx  ( nullptr )
+  , m_SliceCallback            ( nullptr )
   , m_threadPool    ( nullptr )
   , m_spsMap        ( MAX_NUM_SPS )
   , m_ppsMap        ( MAX_NUM_PPS )
@@ -87,6 +89,7 @@ void EncLib::xResetLib()
   m_numPicsRcvd        = 0;
   m_numPicsInQueue     = 0;
   m_numPicsCoded       = 0;
+  m_numPicsRCGOP       = 0;
   m_pocEncode          = -1;
   m_pocRecOut          = 0;
   m_GOPSizeLog2        = -1;
@@ -100,6 +103,9 @@ void EncLib::initEncoderLib( const VVEncCfg& encCfg )
   const_cast<VVEncCfg&>(m_cEncCfg) = encCfg;
   m_cBckCfg = encCfg;
 
+  // training data of all passes and threads is appended
+  EncSplitModel::initDumpFile( m_cEncCfg );
+
   // initialize first pass
   initPass( 0 );
 
@@ -256,11 +262,16 @@ void EncLib::initPass( int pass )
   }
 
   m_MCTF.init( m_cEncCfg.m_internalBitDepth, m_cEncCfg.m_PadSourceWidth, m_cEncCfg.m_PadSourceHeight, sps0.CTUSize,
-               m_cEncCfg.m_internChromaFormat, m_cEncCfg.m_QP, m_cEncCfg.m_vvencMCTF, m_cEncCfg.m_framesToBeEncoded, m_threadPool );
+               m_cEncCfg.m_internChromaFormat, m_cEncCfg.m_QP, m_cEncCfg.m_vvencMCTF, m_cEncCfg.m_framesToBeEncoded, m_cEncCfg.m_bMCTFMvPred, m_threadPool );
+  if( m_cEncCfg.m_LookAhead )
+  {
+    m_Lookahead.init( m_cEncCfg, m_threadPool );
+  }
 
   CHECK( m_cGOPEncoder != nullptr, "encoder library already initialised" );
   m_cGOPEncoder = new EncGOP;
   m_cGOPEncoder->init( m_cEncCfg, sps0, pps0, m_cRateCtrl, m_cEncHRD, m_threadPool );
+  m_cGOPEncoder->setSliceCallback( m_SliceCallback );
 
   m_pocToGopId.resize( m_cEncCfg.m_GOPSize, -1 );
   m_nextPocOffset.resize( m_cEncCfg.m_GOPSize, 0 );
@@ -295,7 +306,7 @@ void EncLib::initPass( int pass )
 
   int iOffset = -1;
   while((1<<(++iOffset)) < m_cEncCfg.m_GOPSize);
-  m_GOPSizeLog2 = iOffset;
+  m_GOPSizeLog2 = m_cEncCfg.m_lowDelay ? 0 : iOffset; // no reordering delay between dts and cts in low delay mode
 
   if( m_cEncCfg.m_FrameRate )
   {
@@ -314,12 +325,29 @@ void EncLib::initPass( int pass )
   m_numPassInitialized = pass;
 }
 
+void EncLib::reconfig( const VVEncCfg& encCfg )
+{
+  CHECK( m_cGOPEncoder == nullptr, "encoder library not initialised" );
+
+  // the new configuration is applied before the first picture of the next GOP is encoded
+  m_cGOPEncoder->reconfig( encCfg );
+}
+
 void EncLib::setRecYUVBufferCallback( void *ctx, vvencRecYUVBufferCallback callback )
 {
   m_RecYUVBufferCallbackCtx = ctx;
   m_RecYUVBufferCallback    = callback;
 }
 
+void EncLib::setSliceCallback( std::function<void( AccessUnitList&, bool )> callback )
+{
+  m_SliceCallback = callback;
+  if( m_cGOPEncoder )
+  {
+    m_cGOPEncoder->setSliceCallback( m_SliceCallback );
+  }
+}
+
 void EncLib::xUninitLib()
 {
 
@@ -336,6 +364,7 @@ void EncLib::xUninitLib()
     m_cGOPEncoder = nullptr;
   }
   m_MCTF.uninit();
+  m_Lookahead.uninit();
 
   // thread pool
   if( m_threadPool )
@@ -373,6 +402,7 @@ void EncLib::xSetRCEncCfg( int pass )
     // fixed-QP encoding in first rate control pass
     m_cBckCfg.m_RCTargetBitrate = 0;
     m_cBckCfg.m_QP /*base QP*/  = (m_cEncCfg.m_RCInitialQP > 0 ? Clip3 (17, MAX_QP, m_cEncCfg.m_RCInitialQP) : std::max (17, MAX_QP_PERCEPT_QPA - 2 - int (0.5 + sqrt ((d * m_cEncCfg.m_RCTargetBitrate) / 500000.0))));
+    m_cRateCtrl.firstPassBaseQP = m_cBckCfg.m_QP;
 
     // restore the settings
     if (m_cBckCfg.m_usePerceptQPA && (m_cBckCfg.m_QP <= MAX_QP_PERCEPT_QPA))
@@ -382,6 +412,12 @@ void EncLib::xSetRCEncCfg( int pass )
     m_cBckCfg.m_vvencMCTF.MCTF  = mctf;
     m_cBckCfg.m_IBCMode         = ibcMode;
 
+    // the fast first pass only runs the lookahead analysis
+    if( m_cBckCfg.m_FirstPassMode == 1 )
+    {
+      m_cBckCfg.m_LookAhead     = true;
+    }
+
     // clear MaxCuDQPSubdiv
     if( m_cBckCfg.m_CTUSize < 128 )
     {
@@ -395,6 +431,12 @@ void EncLib::xSetRCEncCfg( int pass )
     const unsigned fps = m_cEncCfg.m_FrameRate;
     uint64_t sumFrBits = 0, sumVisAct = 0; // for first-pass data
     std::list<TRCPassStats>& firstPassData = m_cRateCtrl.getFirstPassStats();
+
+    // second pass without a preceding first pass, load the statistics of an earlier run
+    if( firstPassData.empty() && m_cEncCfg.m_RCStatsFile[0] != '\0' )
+    {
+      m_cRateCtrl.readStatsFile( m_cEncCfg.m_RCStatsFile, m_cEncCfg );
+    }
     std::list<TRCPassStats>::iterator it;
 
     for (it = firstPassData.begin(); it != firstPassData.end(); it++)
@@ -405,7 +447,7 @@ void EncLib::xSetRCEncCfg( int pass )
     if ((firstPassData.size() > 0) && (fps > 0))
     {
       double d = (3840.0 * 2160.0) / double (m_cEncCfg.m_SourceWidth * m_cEncCfg.m_SourceHeight);
-      const int firstPassBaseQP  = std::max (17, MAX_QP_PERCEPT_QPA - 2 - int (0.5 + sqrt ((d * m_cEncCfg.m_RCTargetBitrate) / 500000.0)));
+      const int firstPassBaseQP  = m_cRateCtrl.firstPassBaseQP;
       const int log2HeightMinus7 = int (0.5 + log ((double) std::max (128, m_cEncCfg.m_SourceHeight)) / log (2.0)) - 7;
 
       d = (double) m_cEncCfg.m_RCTargetBitrate * (double) firstPassData.size() / double (fps * sumFrBits);
@@ -458,7 +500,21 @@ void EncLib::encodePicture( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUn
       }
 
       xInitPicture( *pic, m_numPicsRcvd, pps, sps, m_cVPS, m_cDCI );
+
+      if( m_cEncCfg.m_FirstPassMode == 1 && m_cEncCfg.m_RCNumPasses == 2 && !m_cRateCtrl.rcIsFinalPass )
+      {
+        // fast first pass, derive the rate control statistics from the lookahead analysis without encoding
+        xAddLookaheadPassStats( *pic );
+        m_numPicsRcvd += 1;
+        isQueueEmpty   = true;
+        return;
+      }
+
       xDetectScreenC(*pic, pic->getOrigBuf());
+      if( m_cEncCfg.m_LookAhead )
+      {
+        m_Lookahead.analyse( *pic );
+      }
       m_numPicsRcvd    += 1;
       m_numPicsInQueue += 1;
     }
@@ -466,6 +522,16 @@ void EncLib::encodePicture( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUn
   else
   {
     CHECK( 0 == m_numPicsRcvd, "invalid call, non-empty input buffer expected" );
+
+    if( m_cEncCfg.m_FirstPassMode == 1 && m_cEncCfg.m_RCNumPasses == 2 && !m_cRateCtrl.rcIsFinalPass )
+    {
+      if( m_cEncCfg.m_RCStatsFile[0] != '\0' )
+      {
+        m_cRateCtrl.writeStatsFile( m_cEncCfg.m_RCStatsFile, m_cBckCfg );
+      }
+      isQueueEmpty = true;
+      return;
+    }
   }
 
   // MCTF process
@@ -487,14 +553,16 @@ void EncLib::encodePicture( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUn
   {
     if ( m_cEncCfg.m_RCTargetBitrate > 0 )
     {
-      if ( m_numPicsRcvd == m_numPicsInQueue )
+      // register the rate control GOPs of all pictures, which may be started in this call (up to max parallel frames ahead),
+      // the GOPs are created when their first picture is started
+      const int numPicsCoded = m_numPicsRcvd - m_numPicsInQueue;
+      const int maxPicIdx    = numPicsCoded + std::max( 1, m_cEncCfg.m_maxParallelFrames ) - 1;
+      while ( m_numPicsRCGOP <= maxPicIdx && m_numPicsRCGOP < m_numPicsRcvd )
       {
-        m_cRateCtrl.initRCGOP( 1 );
-      }
-      else if ( 1 == ( m_numPicsRcvd - m_numPicsInQueue ) % m_cEncCfg.m_GOPSize )
-      {
-        m_cRateCtrl.destroyRCGOP();
-        m_cRateCtrl.initRCGOP( m_numPicsInQueue >= m_cEncCfg.m_GOPSize ? m_cEncCfg.m_GOPSize : m_numPicsInQueue );
+        const int numPicsLeft = m_numPicsRcvd - m_numPicsRCGOP;
+        const int numPics     = m_numPicsRCGOP == 0 ? 1 : ( flush ? std::min( numPicsLeft, m_cEncCfg.m_GOPSize ) : m_cEncCfg.m_GOPSize );
+        m_cRateCtrl.addRCGOP( numPics );
+        m_numPicsRCGOP += numPics;
       }
     }
 
@@ -537,11 +605,17 @@ void EncLib::encodePicture( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUn
   }
 
   isQueueEmpty = ( m_cEncCfg.m_maxParallelFrames && flush ) ? ( m_numPicsInQueue <= 0 && ! m_cGOPEncoder->anyFramesInOutputQueue() ) : ( m_numPicsInQueue <= 0 );
-  if( m_cEncCfg.m_RCTargetBitrate > 0 && isQueueEmpty )
+  if( m_cEncCfg.m_RCTargetBitrate > 0 && isQueueEmpty && flush ) // in low delay mode the queue is empty after each picture
   {
     m_cRateCtrl.destroyRCGOP();
   }
 
+  // store the first pass statistics for a later second pass
+  if( flush && isQueueEmpty && !m_cRateCtrl.rcIsFinalPass && m_cEncCfg.m_RCStatsFile[0] != '\0' )
+  {
+    m_cRateCtrl.writeStatsFile( m_cEncCfg.m_RCStatsFile, m_cBckCfg );
+  }
+
   // reset output access unit, if not final pass
   if( !m_cRateCtrl.rcIsFinalPass )
   {
@@ -582,6 +656,42 @@ int EncLib::xGetNextPocICO( int poc, bool flush, int max ) const
  .
  \retval pic obtained picture buffer
  */
+void EncLib::xAddLookaheadPassStats( Picture& pic )
+{
+  m_Lookahead.analyse( pic );
+
+  const vvencGOPEntry& gopEntry = m_cEncCfg.m_GOPList[ pic.gopId ];
+  const bool isIntra = pic.poc == 0 || ( m_cEncCfg.m_IntraPeriod > 0 && pic.poc % m_cEncCfg.m_IntraPeriod == 0 ) || gopEntry.m_sliceType == 'I';
+  int qp             = m_cEncCfg.m_QP;
+  int refDist        = MAX_INT;
+
+  // same QP derivation as EncSlice::xGetQPForPicture
+  if( isIntra )
+  {
+    qp += m_cEncCfg.m_intraQPOffset;
+  }
+  else
+  {
+    qp += gopEntry.m_QPOffset;
+    qp += (int) floor( Clip3<double>( 0.0, 3.0, qp * gopEntry.m_QPOffsetModelScale + gopEntry.m_QPOffsetModelOffset + 0.5 ) );
+
+    for( int l = 0; l < 2; l++ )
+    {
+      if( gopEntry.m_numRefPics[ l ] > 0 )
+      {
+        refDist = std::min( refDist, abs( gopEntry.m_deltaRefPics[ l ][ 0 ] ) );
+      }
+    }
+  }
+
+  m_cRateCtrl.addLookaheadPassStats( pic, Clip3( 0, MAX_QP, qp ), refDist == MAX_INT ? 1 : refDist, isIntra, isIntra ? 0 : pic.TLayer, m_cEncCfg.m_internalBitDepth[ CH_L ] );
+
+  // the picture is neither coded nor referenced, release it right away
+  pic.isReferenced      = false;
+  pic.isNeededForOutput = false;
+  pic.isFinished        = true;
+}
+
 Picture* EncLib::xGetNewPicBuffer( const PPS& pps, const SPS& sps )
 {
   Slice::sortPicList( m_cListPic );
@@ -625,6 +735,11 @@ Picture* EncLib::xGetNewPicBuffer( const PPS& pps, const SPS& sps )
   }
 
   pic->isMctfProcessed   = false;
+  pic->mctfMotion.clear();
+  pic->halfPelPlanes.reset();
+  pic->blockHashMap.clear();
+  pic->lookahead.reset();
+  pic->analysis.reset();
   pic->isInitDone        = false;
   pic->isReconstructed   = false;
   pic->isFinished        = false;
@@ -637,8 +752,10 @@ Picture* EncLib::xGetNewPicBuffer( const PPS& pps, const SPS& sps )
   pic->poc               = -1;
   pic->actualHeadBits    = 0;
   pic->actualTotalBits   = 0;
+  pic->numSlicesWritten  = 0;
 
   pic->encTime.resetTimer();
+  pic->speedLevel        = 0;
 
   return pic;
 }
@@ -841,7 +958,7 @@ void EncLib::xInitConstraintInfo(ConstraintInfo &ci) const
   ci.noActConstraintFlag                      = false;
   ci.noLmcsConstraintFlag                     = false;
   ci.noQtbttDualTreeIntraConstraintFlag           = ! m_cEncCfg.m_dualITree;
-  ci.noPartitionConstraintsOverrideConstraintFlag = m_cEncCfg.m_useAMaxBT == 0;
+  ci.noPartitionConstraintsOverrideConstraintFlag = m_cEncCfg.m_useAMaxBT == 0 && m_cEncCfg.m_RealTimeFps <= 0.0;
   ci.noSaoConstraintFlag                          = ! m_cEncCfg.m_bUseSAO;
   ci.noAlfConstraintFlag                          = ! m_cEncCfg.m_alf;
   ci.noCCAlfConstraintFlag                        = ! m_cEncCfg.m_ccalf;
@@ -943,7 +1060,7 @@ void EncLib::xInitSPS(SPS &sps) const
   sps.MRL                           = m_cEncCfg.m_MRL;
   sps.BdofPresent                   = m_cEncCfg.m_BDOF;
   sps.DmvrPresent                   = m_cEncCfg.m_DMVR;
-  sps.partitionOverrideEnabled      = m_cEncCfg.m_useAMaxBT != 0;
+  sps.partitionOverrideEnabled      = m_cEncCfg.m_useAMaxBT != 0 || m_cEncCfg.m_RealTimeFps > 0.0;
   sps.resChangeInClvsEnabled        = m_cEncCfg.m_resChangeInClvsEnabled;
   sps.rprEnabled                    = m_cEncCfg.m_rprEnabledFlag != 0;
   sps.log2MinCodingBlockSize        = m_cEncCfg.m_log2MinCodingBlockSize;
@@ -1267,11 +1384,45 @@ void EncLib::xInitRPL(SPS &sps) const
 
 void EncLib::xInitPPSforTiles(PPS &pps) const
 {
-  pps.sliceMap.clear();
-  pps.sliceMap.resize(1);
-  pps.sliceMap[0].addCtusToSlice(0, pps.picWidthInCtu, 0, pps.picHeightInCtu, pps.picWidthInCtu);
-  pps.ctuToTileCol.resize(pps.picWidthInCtu, 0);
-  pps.ctuToTileRow.resize(pps.picHeightInCtu, 0);
+  const int numSliceRows = m_cEncCfg.m_sliceCtuRows > 0 ? ( pps.picHeightInCtu + m_cEncCfg.m_sliceCtuRows - 1 ) / m_cEncCfg.m_sliceCtuRows : 1;
+
+  if( numSliceRows <= 1 )
+  {
+    pps.sliceMap.clear();
+    pps.sliceMap.resize(1);
+    pps.sliceMap[0].addCtusToSlice(0, pps.picWidthInCtu, 0, pps.picHeightInCtu, pps.picWidthInCtu);
+    pps.ctuToTileCol.resize(pps.picWidthInCtu, 0);
+    pps.ctuToTileRow.resize(pps.picHeightInCtu, 0);
+    return;
+  }
+
+  // single tile, split into rectangular slices of m_sliceCtuRows CTU rows each
+  pps.resetTileSliceInfo();
+  pps.noPicPartition       = false;
+  pps.log2CtuSize          = Log2( m_cEncCfg.m_CTUSize );
+  pps.ctuSize              = m_cEncCfg.m_CTUSize;
+  pps.numExpTileCols       = 1;
+  pps.numExpTileRows       = 1;
+  pps.tileColWidth.push_back( pps.picWidthInCtu );
+  pps.tileRowHeight.push_back( pps.picHeightInCtu );
+  pps.initTiles();
+
+  pps.rectSlice            = true;
+  pps.singleSlicePerSubPic = false;
+  pps.tileIdxDeltaPresent  = false;
+  pps.numSlicesInPic       = numSliceRows;
+  pps.initRectSlices();
+  for( int i = 0; i < numSliceRows; i++ )
+  {
+    RectSlice& rectSlice         = pps.rectSlices[ i ];
+    rectSlice.tileIdx            = 0;
+    rectSlice.sliceWidthInTiles  = 1;
+    rectSlice.sliceHeightInTiles = 1;
+    rectSlice.numSlicesInTile    = numSliceRows;
+    rectSlice.sliceHeightInCtu   = std::min<uint32_t>( m_cEncCfg.m_sliceCtuRows, pps.picHeightInCtu - i * m_cEncCfg.m_sliceCtuRows );
+  }
+  pps.initRectSliceMap();
+  pps.subPics[ 0 ].numSlicesInSubPic = numSliceRows;
 }
 
 void EncLib::xOutputRecYuv()
@@ -1315,6 +1466,64 @@ void EncLib::xInitHrdParameters(SPS &sps)
 #pragma GCC diagnostic ignored "-Wstrict-overflow"
 #endif
 
+struct ScreenCTask // band of 8x8 super block rows
+{
+  CPelBuf  orgY;
+  unsigned hStart;
+  unsigned hEnd;
+  int      sR[4];
+};
+
+static void xDetectScreenCRows( ScreenCTask& t )
+{
+  const int SIZE_BL = 4;
+  const Pel* piSrc    = t.orgY.buf;
+  uint32_t   uiStride = t.orgY.stride;
+  uint32_t   uiWidth  = t.orgY.width;
+  uint32_t   uiHeight = t.orgY.height;
+  int size = SIZE_BL;
+  unsigned   hh, ww;
+  int SizeS = SIZE_BL << 1;
+  for (hh = t.hStart; hh < t.hEnd;)
+  {
+    for (ww = 0; ww < uiWidth;)
+    {
+      int Rx = ww > (uiWidth >> 1) ? 1 : 0;
+      int Ry = hh > (uiHeight >> 1) ? 1 : 0;
+      Ry = Ry << 1 | Rx;
+
+      int i = ww;
+      int j = hh;
+      int n = 0;
+      int Var[4];
+      for (j = hh; (j < hh + SizeS) && (j < uiHeight); j++)
+      {
+        for (i = ww; (i < ww + SizeS) && (i < uiWidth); i++)
+        {
+          // Variance in Block (SIZE_BL*SIZE_BL)
+          Var[n] = g_pelBufOP.AvgAbsDev4x4( piSrc + j * uiStride + i, uiStride, std::min<int>( size, uiWidth - i ), std::min<int>( size, uiHeight - j ) );
+          n++;
+          i += size;
+        }
+        j += size;
+      }
+      for (int i = 0; i < 2; i++)
+      {
+        if (Var[i] == Var[i + 2])
+        {
+          t.sR[Ry] += 1;
+        }
+        if (Var[i << 1] == Var[(i << 1) + 1])
+        {
+          t.sR[Ry] += 1;
+        }
+      }
+      ww += SizeS;
+    }
+    hh += SizeS;
+  }
+}
+
 void EncLib::xDetectScreenC(Picture& pic, PelUnitBuf yuvOrgBuf)
 {
   bool isSccWeak = false;
@@ -1327,77 +1536,50 @@ void EncLib::xDetectScreenC(Picture& pic, PelUnitBuf yuvOrgBuf)
       || m_cEncCfg.m_lumaReshapeEnable == 2
       || m_cEncCfg.m_motionEstimationSearchMethodSCC > 0 )
   {
-    int SIZE_BL = 4;
-    int K_SC = 25;
-    const Pel* piSrc = yuvOrgBuf.Y().buf;
-    uint32_t   uiStride = yuvOrgBuf.Y().stride;
-    uint32_t   uiWidth = yuvOrgBuf.Y().width;
-    uint32_t   uiHeight = yuvOrgBuf.Y().height;
-    int size = SIZE_BL;
-    unsigned   hh, ww;
+    const int SIZE_BL  = 4;
+    const int K_SC     = 25;
+    const int BAND_BL  = 16; // super block rows per task
+    const CPelBuf orgY = yuvOrgBuf.Y();
+    uint32_t   uiWidth = orgY.width;
+    uint32_t  uiHeight = orgY.height;
     int SizeS = SIZE_BL << 1;
     int sR[4] = { 0,0,0,0 };
     int AmountBlock = (uiWidth >> 2) * (uiHeight >> 2);
-    for (hh = 0; hh < uiHeight;)
+
+    const unsigned bandSize = BAND_BL * SizeS;
+    const unsigned numBands = ( m_threadPool && m_threadPool->numThreads() > 1 ) ? ( uiHeight + bandSize - 1 ) / bandSize : 1;
+    std::vector<ScreenCTask> bands( numBands, ScreenCTask{ orgY, 0, uiHeight, { 0, 0, 0, 0 } } );
+
+    for( unsigned b = 0; b < numBands; b++ )
+    {
+      bands[ b ].hStart = b * bandSize;
+      bands[ b ].hEnd   = b + 1 < numBands ? ( b + 1 ) * bandSize : uiHeight;
+    }
+    if( numBands > 1 )
     {
-      for (ww = 0; ww < uiWidth;)
+      WaitCounter taskCounter;
+
+      for( auto& band : bands )
       {
-        int Rx = ww > (uiWidth >> 1) ? 1 : 0;
-        int Ry = hh > (uiHeight >> 1) ? 1 : 0;
-        Ry = Ry << 1 | Rx;
-
-        int i = ww;
-        int j = hh;
-        int n = 0;
-        int Var[4];
-        for (j = hh; (j < hh + SizeS) && (j < uiHeight); j++)
-        {
-          for (i = ww; (i < ww + SizeS) && (i < uiWidth); i++)
-          {
-            int sum = 0;
-            int Mit = 0;
-            int V = 0;
-            int h = j;
-            int w = i;
-            for (h = j; (h < j + size) && (h < uiHeight); h++)
-            {
-              for (w = i; (w < i + size) && (w < uiWidth); w++)
-              {
-                sum += int(piSrc[h * uiStride + w]);
-              }
-            }
-            int sizeEnd = ((h - j) * (w - i));
-            Mit = sum / sizeEnd;
-            for (h = j; (h < j + size) && (h < uiHeight); h++)
-            {
-              for (w = i; (w < i + size) && (w < uiWidth); w++)
-              {
-                V += abs(Mit - int(piSrc[h * uiStride + w]));
-              }
-            }
-            // Variance in Block (SIZE_BL*SIZE_BL)
-            V = V / sizeEnd;
-            Var[n] = V;
-            n++;
-            i += size;
-          }
-          j += size;
-        }
-        for (int i = 0; i < 2; i++)
-        {
-          if (Var[i] == Var[i + 2])
-          {
-            sR[Ry] += 1;
-          }
-          if (Var[i << 1] == Var[(i << 1) + 1])
-          {
-            sR[Ry] += 1;
-          }
-        }
-        ww += SizeS;
+        static auto task = []( int, ScreenCTask* t ) { xDetectScreenCRows( *t ); return true; };
+
+        m_threadPool->addBarrierTask<ScreenCTask>( task, &band, &taskCounter );
       }
-      hh += SizeS;
+      taskCounter.wait();
+    }
+    else
+    {
+      xDetectScreenCRows( bands[ 0 ] );
     }
+
+    for( const auto& band : bands )
+    {
+      for( int r = 0; r < 4; r++ )
+      {
+        sR[ r ] += band.sR[ r ];
+      }
+    }
+
     int s = 0;
     isSccStrg = true;
     for (int r = 0; r < 4; r++)
@@ -1418,6 +1600,11 @@ void EncLib::xDetectScreenC(Picture& pic, PelUnitBuf yuvOrgBuf)
   pic.useScLMCS  = m_cEncCfg.m_lumaReshapeEnable == 1 || ( m_cEncCfg.m_lumaReshapeEnable == 2 && ! isSccStrg );
   pic.useScIBC   = m_cEncCfg.m_IBCMode == 1           || ( m_cEncCfg.m_IBCMode == 2           && isSccStrg );
 
+  if( m_cEncCfg.m_HashME && ( pic.useScME || pic.useScIBC ) )
+  {
+    pic.blockHashMap.create( yuvOrgBuf.Y() );
+  }
+
 }
 
 #if FIX_FOR_TEMPORARY_COMPILER_ISSUES_ENABLED && defined( __GNUC__ ) && __GNUC__ == 5
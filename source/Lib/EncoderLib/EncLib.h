@@ -52,6 +52,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include "EncGOP.h"
 #include "EncHRD.h"
 #include "CommonLib/MCTF.h"
+#include "Lookahead.h"
 #include "CommonLib/Nal.h"
 #include "vvenc/vvencCfg.h"
 
@@ -76,6 +77,7 @@ private:
   int                       m_numPicsRcvd;
   int                       m_numPicsInQueue;
   int                       m_numPicsCoded;
+  int                       m_numPicsRCGOP;
   int                       m_pocEncode;
   int                       m_pocRecOut;
   int                       m_GOPSizeLog2;
@@ -87,10 +89,12 @@ private:
   EncGOP*                   m_cGOPEncoder;
   EncHRD                    m_cEncHRD;
   MCTF                      m_MCTF;
+  Lookahead                 m_Lookahead;
   PicList                   m_cListPic;
 
   std::function<void( void*, vvencYUVBuffer* )> m_RecYUVBufferCallback;
   void*                     m_RecYUVBufferCallbackCtx;
+  std::function<void( AccessUnitList&, bool )> m_SliceCallback;
 
   NoMallocThreadPool*       m_threadPool;
   RateCtrl                  m_cRateCtrl;                          ///< Rate control class
@@ -112,11 +116,13 @@ public:
 
   void     initEncoderLib      ( const VVEncCfg& encCfg );
   void     initPass            ( int pass );
+  void     reconfig            ( const VVEncCfg& encCfg );
   void     encodePicture       ( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUnitList& au, bool& isQueueEmpty );
   void     uninitEncoderLib    ();
   void     printSummary        ();
 
   void     setRecYUVBufferCallback( void *, vvencRecYUVBufferCallback );
+  void     setSliceCallback       ( std::function<void( AccessUnitList&, bool )> callback );
 
 private:
   void     xUninitLib          ();
@@ -141,6 +147,7 @@ private:
   void     xInitHrdParameters  ( SPS &sps );
   void     xOutputRecYuv       ();
   void     xDetectScreenC      ( Picture& pic, PelUnitBuf yuvOrgBuf );
+  void     xAddLookaheadPassStats( Picture& pic );
 };
 
 } // namespace vvenc
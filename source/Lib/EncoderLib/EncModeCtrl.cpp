@@ -534,12 +534,14 @@ void EncModeCtrl::init( const VVEncCfg& encCfg, RdCost* pRdCost )
 
   CacheBlkInfoCtrl::create();
   BestEncInfoCache::create( encCfg.m_internChromaFormat );
+  m_splitModel.init( encCfg );
 }
 
 void EncModeCtrl::destroy()
 {
   CacheBlkInfoCtrl::destroy();
   BestEncInfoCache::destroy();
+  m_splitModel.uninit();
 }
 
 void EncModeCtrl::initCTUEncoding( const Slice &slice )
@@ -593,6 +595,10 @@ void EncModeCtrl::initCULevel( Partitioner &partitioner, const CodingStructure&
   cuECtx.didHorzSplit   = partitioner.canSplit( CU_HORZ_SPLIT, cs );
   cuECtx.didVertSplit   = partitioner.canSplit( CU_VERT_SPLIT, cs );
   
+  if( cs.picture->analysis.isValid() )
+  {
+    xInitAnalysis( cuECtx, partitioner, cs );
+  }
 
   if( m_pcEncCfg->m_contentBasedFastQtbt )
   {
@@ -634,6 +640,12 @@ void EncModeCtrl::initCULevel( Partitioner &partitioner, const CodingStructure&
 
 void EncModeCtrl::finishCULevel( Partitioner &partitioner )
 {
+  const ComprCUCtx& cuECtx = m_ComprCUCtxList.back();
+  if( m_splitModel.isDumping() && cuECtx.splitFeaturesValid )
+  {
+    m_splitModel.addSample( cuECtx.splitFeatures, cuECtx.splitTested, getPartSplit( cuECtx.bestMode ) );
+  }
+
   m_ComprCUCtxList.pop_back();
   comprCUCtx = m_ComprCUCtxList.size() ? &m_ComprCUCtxList.back() : nullptr;
 }
@@ -642,6 +654,16 @@ bool EncModeCtrl::trySplit( const EncTestMode& encTestmode, const CodingStructur
 {
   ComprCUCtx& cuECtx = *comprCUCtx;
 
+  // follow the loaded partitioning
+  if( cuECtx.analysisState == ANALYSIS_SPLIT )
+  {
+    return getPartSplit( encTestmode ) == cuECtx.analysisSplit;
+  }
+  else if( cuECtx.analysisState == ANALYSIS_REFINE || ( cuECtx.analysisState == ANALYSIS_LEAF && m_pcEncCfg->m_AnalysisRefine < 2 ) )
+  {
+    return false;
+  }
+
   const PartSplit implicitSplit = partitioner.getImplicitSplit( cs );
   const bool isBoundary         = implicitSplit != CU_DONT_SPLIT;
 
@@ -662,6 +684,12 @@ bool EncModeCtrl::trySplit( const EncTestMode& encTestmode, const CodingStructur
   const CodingStructure *bestCS      = cuECtx.bestCS;
   const CodingUnit      *bestCU      = cuECtx.bestCU;
 
+  // the features describe the best mode without split, i.e. before the first split is tested
+  if( ( m_splitModel.isActive() || m_splitModel.isDumping() ) && !cuECtx.splitFeaturesValid && !cuECtx.splitTested && bestCU && isLuma( partitioner.chType ) )
+  {
+    xGetSplitFeatures( cuECtx, cs, partitioner );
+  }
+
   if( cuECtx.minDepth > partitioner.currQtDepth && partitioner.canSplit( CU_QUAD_SPLIT, cs ) )
   {
     // enforce QT
@@ -856,6 +884,14 @@ bool EncModeCtrl::trySplit( const EncTestMode& encTestmode, const CodingStructur
       break;
   }
 
+  if( m_splitModel.isActive() && cuECtx.splitFeaturesValid && m_splitModel.skipSplit( split, cuECtx.splitFeatures ) )
+  {
+    if( split == CU_HORZ_SPLIT ) cuECtx.didHorzSplit = false;
+    if( split == CU_VERT_SPLIT ) cuECtx.didVertSplit = false;
+    if( split == CU_QUAD_SPLIT ) cuECtx.didQuadSplit = false;
+    return false;
+  }
+
   if( split == CU_QUAD_SPLIT )
   {
     cuECtx.didQuadSplit = m_pcEncCfg->m_qtbttSpeedUp <= 1 || !!cuECtx.doMoreSplits;
@@ -870,6 +906,11 @@ bool EncModeCtrl::tryMode( const EncTestMode& encTestmode, const CodingStructure
 
   ComprCUCtx& cuECtx = m_ComprCUCtxList.back();
 
+  if( cuECtx.analysisState == ANALYSIS_SPLIT || ( cuECtx.analysisState == ANALYSIS_LEAF && !xIsAnalysisMode( encTestmode, cuECtx, cs, partitioner ) ) )
+  {
+    return false;
+  }
+
   if( cuECtx.minDepth > partitioner.currQtDepth && partitioner.canSplit( CU_QUAD_SPLIT, cs ) )
   {
     // enforce QT
@@ -1090,6 +1131,10 @@ bool EncModeCtrl::useModeResult( const EncTestMode& encTestmode, CodingStructure
 {
   ComprCUCtx& cuECtx = m_ComprCUCtxList.back();
 
+  if( isModeSplit( encTestmode ) )
+  {
+    cuECtx.splitTested |= 1u << ( getPartSplit( encTestmode ) - CU_QUAD_SPLIT );
+  }
 
   if(      encTestmode.type == ETM_SPLIT_BT_H )
   {
@@ -1191,6 +1236,130 @@ bool EncModeCtrl::useModeResult( const EncTestMode& encTestmode, CodingStructure
   }
 }
 
+void EncModeCtrl::xInitAnalysis( ComprCUCtx& cuECtx, Partitioner& partitioner, const CodingStructure& cs ) const
+{
+  // locate the block in the loaded partitioning of the luma tree by the split series of the coding unit at its top-left sample
+  const AnalysisCu* aCu = isLuma( partitioner.chType ) ? cs.picture->analysis.getCu( cs.area.lumaPos() ) : nullptr;
+  if( !aCu )
+  {
+    return;
+  }
+
+  const unsigned    depth    = partitioner.currDepth;
+  const unsigned    cmpDepth = std::min<unsigned>( depth, aCu->depth );
+  const SplitSeries mask     = cmpDepth * SPLIT_DMULT >= 64 ? ~SplitSeries( 0 ) : ( SplitSeries( 1 ) << ( cmpDepth * SPLIT_DMULT ) ) - 1;
+  if( ( partitioner.getSplitSeries() & mask ) != ( aCu->splitSeries & mask ) )
+  {
+    return;
+  }
+
+  if( depth < aCu->depth )
+  {
+    const PartSplit split = PartSplit( ( aCu->splitSeries >> ( depth * SPLIT_DMULT ) ) & SPLIT_MASK );
+    if( !partitioner.canSplit( split, cs ) )
+    {
+      // the split is not allowed with the current configuration, search this block regularly
+      return;
+    }
+    cuECtx.analysisState = ANALYSIS_SPLIT;
+    cuECtx.analysisSplit = split;
+  }
+  else if( depth == aCu->depth )
+  {
+    cuECtx.analysisState = ANALYSIS_LEAF;
+  }
+  else if( depth == aCu->depth + 1u )
+  {
+    cuECtx.analysisState = ANALYSIS_REFINE;
+  }
+  else
+  {
+    return;
+  }
+
+  // the loaded decisions replace the depth restrictions of the fast partitioning
+  cuECtx.analysisCu = aCu;
+  cuECtx.minDepth   = 0;
+  cuECtx.maxDepth   = cs.pcv->getMaxDepth( cs.slice->sliceType, partitioner.chType );
+}
+
+bool EncModeCtrl::xIsAnalysisMode( const EncTestMode& encTestmode, const ComprCUCtx& cuECtx, const CodingStructure& cs, const Partitioner& partitioner ) const
+{
+  if( m_pcEncCfg->m_AnalysisRefine > 0 )
+  {
+    return true;
+  }
+
+  // merge/skip in inter and intra in intra slices are always tested, the fast mode decisions could reject the loaded mode
+  if( encTestmode.type == ETM_MERGE_SKIP || ( cs.slice->isIntra() && encTestmode.type == ETM_INTRA ) )
+  {
+    return true;
+  }
+
+  // restrict to the loaded prediction type, intra, inter or IBC, if it is available for this block
+  const AnalysisCu& aCu = *cuECtx.analysisCu;
+  switch( aCu.predMode )
+  {
+  case MODE_INTRA:
+    if( partitioner.modeType == MODE_TYPE_INTER )
+    {
+      return true;
+    }
+    return encTestmode.type == ETM_INTRA;
+  case MODE_INTER:
+    if( cs.slice->isIntra() || partitioner.modeType == MODE_TYPE_INTRA || ( cs.area.lwidth() == 4 && cs.area.lheight() == 4 ) )
+    {
+      return true;
+    }
+    return isModeInter( encTestmode );
+  case MODE_IBC:
+    if( !cs.sps->IBC || !cs.picture->useScIBC )
+    {
+      return true;
+    }
+    return encTestmode.type == ETM_IBC || encTestmode.type == ETM_IBC_MERGE;
+  default:
+    return true;
+  }
+}
+
+void EncModeCtrl::xGetSplitFeatures( ComprCUCtx& cuECtx, const CodingStructure& cs, const Partitioner& partitioner ) const
+{
+  const CompArea&   area   = partitioner.currArea().Y();
+  const double      numPel = area.area();
+  const CodingUnit& bestCU = *cuECtx.bestCU;
+  if( cuECtx.bestCS->cost == MAX_DOUBLE )
+  {
+    return;
+  }
+
+  int numNeigh   = 0;
+  int neighDepth = 0;
+  for( const CodingUnit* cu : { cs.getCU( area.pos().offset( -1, 0 ), partitioner.chType, partitioner.treeType ), cs.getCU( area.pos().offset( 0, -1 ), partitioner.chType, partitioner.treeType ) } )
+  {
+    if( cu )
+    {
+      neighDepth += cu->depth;
+      numNeigh   += 1;
+    }
+  }
+
+  float* f = cuECtx.splitFeatures.f;
+  f[ SF_BIAS ]        = 1.0f;
+  f[ SF_LOG2_AREA ]   = float( Log2( area.width ) + Log2( area.height ) );
+  f[ SF_LOG2_RATIO ]  = float( (int)Log2( area.width ) - (int)Log2( area.height ) );
+  f[ SF_QP ]          = float( cs.baseQP / 64.0 );
+  f[ SF_COST ]        = float( log2( 1.0 + cuECtx.bestCS->cost / ( m_pcRdCost->getLambda() * numPel ) ) );
+  f[ SF_DIST ]        = float( log2( 1.0 + cuECtx.bestCS->dist / numPel ) );
+  f[ SF_SKIP ]        = bestCU.skip ? 1.0f : 0.0f;
+  f[ SF_INTRA ]       = CU::isIntra( bestCU ) ? 1.0f : 0.0f;
+  f[ SF_CBF ]         = bestCU.rootCbf ? 1.0f : 0.0f;
+  f[ SF_NEIGH_DEPTH ] = numNeigh ? float( neighDepth ) / numNeigh - partitioner.currDepth : 0.0f;
+  f[ SF_MT_DEPTH ]    = float( partitioner.currMtDepth );
+  f[ SF_TLAYER ]      = float( cs.slice->TLayer );
+  cuECtx.splitFeaturesValid = true;
+}
+
 } // namespace vvenc
 
 //! \}
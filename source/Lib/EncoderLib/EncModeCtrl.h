@@ -50,8 +50,10 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "InterSearch.h"
+#include "EncSplitModel.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/CodingStructure.h"
+#include "CommonLib/Picture.h"
 
 #include <typeinfo>
 #include <vector>
@@ -169,6 +171,14 @@ inline PartSplit getPartSplit( const EncTestMode& encTestmode )
 // EncModeCtrl controls if specific modes should be tested
 //////////////////////////////////////////////////////////////////////////
 
+enum AnalysisState
+{
+  ANALYSIS_NONE,                          // no loaded decision for the block, regular search
+  ANALYSIS_SPLIT,                         // inner node of the loaded partitioning, only the loaded split is tested
+  ANALYSIS_LEAF,                          // coding unit of the loaded partitioning
+  ANALYSIS_REFINE                         // one split below a loaded coding unit, no further split
+};
+
 struct ComprCUCtx
 {
   ComprCUCtx()
@@ -208,6 +218,11 @@ struct ComprCUCtx
     , relatedCuIsValid      (false)
     , bestIntraMode         (0)
     , isIntra               (false)
+    , analysisState         (ANALYSIS_NONE)
+    , analysisSplit         (CU_DONT_SPLIT)
+    , analysisCu            (nullptr)
+    , splitFeaturesValid    (false)
+    , splitTested           (0)
   {
   }
 
@@ -244,6 +259,12 @@ struct ComprCUCtx
   bool              relatedCuIsValid;
   int               bestIntraMode;
   bool              isIntra;
+  AnalysisState     analysisState;
+  PartSplit         analysisSplit;
+  const AnalysisCu* analysisCu;
+  SplitFeatures     splitFeatures;
+  bool              splitFeaturesValid;
+  unsigned          splitTested;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -347,6 +368,7 @@ protected:
         RdCost*         m_pcRdCost;
   static_vector<ComprCUCtx, ( MAX_CU_DEPTH << 2 )> m_ComprCUCtxList;
   unsigned              m_skipThresholdE0023FastEnc;
+  EncSplitModel         m_splitModel;
 
 public:
   ComprCUCtx*           comprCUCtx;
@@ -364,6 +386,11 @@ public:
   bool useModeResult      ( const EncTestMode& encTestmode, CodingStructure*& tempCS,  Partitioner& partitioner, const bool useEDO );
 
   void beforeSplit        ( Partitioner& partitioner );
+
+private:
+  void xInitAnalysis      ( ComprCUCtx& cuECtx, Partitioner& partitioner, const CodingStructure& cs ) const;
+  bool xIsAnalysisMode    ( const EncTestMode& encTestmode, const ComprCUCtx& cuECtx, const CodingStructure& cs, const Partitioner& partitioner ) const;
+  void xGetSplitFeatures  ( ComprCUCtx& cuECtx, const CodingStructure& cs, const Partitioner& partitioner ) const;
 };
 
 } // namespace vvenc
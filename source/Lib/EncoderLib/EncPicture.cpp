@@ -119,6 +119,10 @@ void EncPicture::compressPicture( Picture& pic, EncGOP& gopEncoder )
   xInitPicEncoder ( pic );
   if( m_pcEncCfg->m_RCTargetBitrate > 0 )
   {
+    if( pic.rcIdxInGop == 0 )
+    {
+      m_pcRateCtrl->initRCGOP();
+    }
     pic.encRCPic = new EncRCPic;
     pic.encRCPic->create( m_pcRateCtrl->encRCSeq, m_pcRateCtrl->encRCGOP, (pic.slices[0]->isIntra() ? 0 : pic.slices[0]->TLayer + 1), pic.slices[0]->poc, pic.rcIdxInGop, m_pcRateCtrl->m_listRCPictures );
     gopEncoder.picInitRateControl( pic.gopId, pic, pic.slices[0], this );
@@ -126,7 +130,14 @@ void EncPicture::compressPicture( Picture& pic, EncGOP& gopEncoder )
 
   // compress current slice
   pic.cs->slice = pic.slices[0];
-  m_SliceEncoder.compressSlice( &pic );
+  if( gopEncoder.isSliceStreamingEnabled() )
+  {
+    m_SliceEncoder.compressSlice( &pic, [&gopEncoder]( Picture& slicePic, int sliceIdx ) { gopEncoder.writeStreamingSlice( slicePic, sliceIdx ); } );
+  }
+  else
+  {
+    m_SliceEncoder.compressSlice( &pic );
+  }
 
   ITT_TASKEND( itt_domain_picEncoder, itt_handle_start );
 }
@@ -156,6 +167,12 @@ void EncPicture::finalizePicture( Picture& pic )
     cs.slice->ccAlfFilterControl[0] = m_ALF.getCcAlfControlIdc(COMP_Cb);
     cs.slice->ccAlfFilterControl[1] = m_ALF.getCcAlfControlIdc(COMP_Cr);
 
+    // the filters are derived for the whole picture, and are shared by all slices
+    for( int i = 1; i < (int)pic.slices.size(); i++ )
+    {
+      xCopySliceAlfParams( *pic.slices[ i ], *slice );
+    }
+
     DTRACE( g_trace_ctx, D_CRC, "ALF" );
     DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
     DTRACE_PIC_COMP( D_REC_CB_LUMA_ALF,   cs, cs.getRecoBuf(), COMP_Y  );
@@ -177,6 +194,10 @@ void EncPicture::finalizePicture( Picture& pic )
   {
     pic.picBlkStat.storeBlkSize( pic );
   }
+  if( pic.encPic && m_pcEncCfg->m_AnalysisSaveFile[0] != '\0' )
+  {
+    pic.analysis.store( *pic.cs );
+  }
   // cleanup
   if( pic.encPic )
   {
@@ -266,6 +287,7 @@ void EncPicture::skipCompressPicture( Picture& pic, ParameterSetMap<APS>& shrdAp
 
   if( slice->sps->saoEnabled )
   {
+    EncSampleAdaptiveOffset::inheritDisabledRate( pic );
     m_SliceEncoder.saoDisabledRate( cs, pic.getSAO( 1 ) );
   }
 
@@ -398,10 +420,32 @@ void EncPicture::skipCompressPicture( Picture& pic, ParameterSetMap<APS>& shrdAp
   }
 }
 
+void EncPicture::xCopySliceAlfParams( Slice& dst, const Slice& src ) const
+{
+  memcpy( dst.alfAps,              src.alfAps,              sizeof( dst.alfAps ) );
+  memcpy( dst.tileGroupAlfEnabled, src.tileGroupAlfEnabled, sizeof( dst.tileGroupAlfEnabled ) );
+  dst.tileGroupNumAps         = src.tileGroupNumAps;
+  dst.tileGroupLumaApsId      = src.tileGroupLumaApsId;
+  dst.tileGroupChromaApsId    = src.tileGroupChromaApsId;
+  dst.ccAlfFilterParam        = src.ccAlfFilterParam;
+  dst.ccAlfFilterControl[ 0 ] = src.ccAlfFilterControl[ 0 ];
+  dst.ccAlfFilterControl[ 1 ] = src.ccAlfFilterControl[ 1 ];
+  dst.tileGroupCcAlfCbEnabled = src.tileGroupCcAlfCbEnabled;
+  dst.tileGroupCcAlfCrEnabled = src.tileGroupCcAlfCrEnabled;
+  dst.tileGroupCcAlfCbApsId   = src.tileGroupCcAlfCbApsId;
+  dst.tileGroupCcAlfCrApsId   = src.tileGroupCcAlfCrApsId;
+}
+
 void EncPicture::xWriteSliceData( Picture& pic )
 {
   const int numSlices = (int)pic.slices.size();
 
+  // with slice streaming, the slice data has already been written during encoding
+  if( pic.numSlicesWritten == numSlices )
+  {
+    return;
+  }
+
   pic.sliceDataStreams.clear();
   pic.sliceDataStreams.resize( numSlices );
   pic.sliceDataNumBins = 0;
@@ -410,8 +454,9 @@ void EncPicture::xWriteSliceData( Picture& pic )
   {
     // set current slice
     pic.cs->slice = pic.slices[i];
-    m_SliceEncoder.encodeSliceData( &pic );
+    m_SliceEncoder.encodeSliceData( &pic, pic.slices[i] );
   }
+  pic.cs->slice = pic.slices[0];
 }
 
 } // namespace vvenc
@@ -102,6 +102,7 @@ class EncPicture
   protected:
     void xInitPicEncoder        ( Picture& pic );
     void xWriteSliceData        ( Picture& pic );
+    void xCopySliceAlfParams    ( Slice& dst, const Slice& src ) const;
 
     void xInitSliceColFromL0Flag( Slice* slice ) const;
     void xInitSliceCheckLDC     ( Slice* slice ) const;
@@ -193,158 +193,59 @@ void EncReshape::calcSeqStats(Picture& pic, SeqInfo &stats)
   const int stride = picY.stride;
   uint32_t winLens = (m_binNum == PIC_CODE_CW_BINS) ? (std::min(height, width) / 240) : 2;
   winLens = winLens > 0 ? winLens : 1;
+  const int winLen = (int)winLens;
+  const int binLen = m_reshapeLUTSize / m_binNum;
 
-  int64_t tempSq  = 0;
-  int64_t topSum  = 0,  topSumSq = 0;
-  int64_t leftSum = 0, leftSumSq = 0;
-  int64_t *leftColSum   = new int64_t[width];
-  int64_t *leftColSumSq = new int64_t[width];
-  int64_t *topRowSum    = new int64_t[height];
-  int64_t *topRowSumSq  = new int64_t[height];
-  int64_t *topColSum    = new int64_t[width];
-  int64_t *topColSumSq  = new int64_t[width];
-  uint32_t *binCnt      = new uint32_t[m_binNum];
-  memset(leftColSum,   0, width * sizeof(int64_t));
-  memset(leftColSumSq, 0, width * sizeof(int64_t));
-  memset(topRowSum,    0, height * sizeof(int64_t));
-  memset(topRowSumSq,  0, height * sizeof(int64_t));
-  memset(topColSum,    0, width * sizeof(int64_t));
-  memset(topColSumSq,  0, width * sizeof(int64_t));
-  memset(binCnt,       0, m_binNum * sizeof(uint32_t));
+  // column sums over the vertical window, updated by the rows entering and leaving the window
+  const Pel* const pLuma = picY.buf;
+  std::vector<int> colSum  (width, 0);
+  std::vector<int> colSumSq(width, 0);
+  uint32_t *binCnt = new uint32_t[m_binNum];
+  memset(binCnt, 0, m_binNum * sizeof(uint32_t));
+
+  for (int y = 0; y < std::min(winLen, height); y++)
+  {
+    g_pelBufOP.addSubColSums(pLuma + y * stride, nullptr, colSum.data(), colSumSq.data(), width);
+  }
 
   stats = SeqInfo();
-  for (uint32_t y = 0; y < height; y++)
+  for (int y = 0; y < height; y++)
   {
-    for (uint32_t x = 0; x < width; x++)
+    const Pel* addRow = y + winLen < height ? pLuma + (y + winLen) * stride : nullptr;
+    const Pel* subRow = y > winLen ? pLuma + (y - 1 - winLen) * stride : nullptr;
+    g_pelBufOP.addSubColSums(addRow, subRow, colSum.data(), colSumSq.data(), width);
+
+    const int y1 = std::max(y - winLen, 0);
+    const int y2 = std::min(y + winLen, height - 1);
+    int64_t sum = 0, sumSq = 0;
+    for (int x = 0; x < std::min(winLen, width); x++)
     {
-      const Pel pxlY = picY.buf[x];
-      int64_t sum = 0, sumSq = 0;
-      uint32_t numPixInPart = 0;
-      uint32_t y1 = std::max((int)(y - winLens), 0);
-      uint32_t y2 = std::min((int)(y + winLens), (height - 1));
-      uint32_t x1 = std::max((int)(x - winLens), 0);
-      uint32_t x2 = std::min((int)(x + winLens), (width - 1));
-      uint32_t bx = 0, by = 0;
-      const Pel* pWinY = &picY.buf[0];
-      numPixInPart = (x2 - x1 + 1) * (y2 - y1 + 1);
-
-      if (x == 0 && y == 0)
-      {
-        for (by = y1; by <= y2; by++)
-        {
-          for (bx = x1; bx <= x2; bx++)
-          {
-            tempSq =  (int64_t)pWinY[bx] *  (int64_t)pWinY[bx];
-            leftSum += pWinY[bx];
-            leftSumSq += tempSq;
-            leftColSum[bx] += pWinY[bx];
-            leftColSumSq[bx] += tempSq;
-            topColSum[bx] += pWinY[bx];
-            topColSumSq[bx] += tempSq;
-            topRowSum[by] += pWinY[bx];
-            topRowSumSq[by] += tempSq;
-          }
-          pWinY += stride;
-        }
-        topSum = leftSum;
-        topSumSq = leftSumSq;
-        sum = leftSum;
-        sumSq = leftSumSq;
-      }
-      else if (x == 0 && y > 0)
+      sum   += colSum[x];
+      sumSq += colSumSq[x];
+    }
+
+    for (int x = 0; x < width; x++)
+    {
+      if (x + winLen < width)
       {
-        if (y < height - winLens)
-        {
-          pWinY += winLens*stride;
-          topRowSum[y + winLens] = 0;
-          topRowSumSq[y + winLens] = 0;
-          for (bx = x1; bx <= x2; bx++)
-          {
-            topRowSum[y + winLens] += pWinY[bx];
-            topRowSumSq[y + winLens] +=  (int64_t)pWinY[bx] *  (int64_t)pWinY[bx];
-          }
-          topSum += topRowSum[y + winLens];
-          topSumSq += topRowSumSq[y + winLens];
-        }
-        if (y > winLens)
-        {
-          topSum -= topRowSum[y - 1 - winLens];
-          topSumSq -= topRowSumSq[y - 1 - winLens];
-        }
-        memset(leftColSum, 0, width * sizeof(int64_t));
-        memset(leftColSumSq, 0, width * sizeof(int64_t));
-        pWinY = &picY.buf[0];
-        pWinY -= (y <= winLens ? y : winLens)*stride;
-        for (by = y1; by <= y2; by++)
-        {
-          for (bx = x1; bx <= x2; bx++)
-          {
-            leftColSum[bx] += pWinY[bx];
-            leftColSumSq[bx] +=  (int64_t)pWinY[bx] *  (int64_t)pWinY[bx];
-          }
-          pWinY += stride;
-        }
-        leftSum = topSum;
-        leftSumSq = topSumSq;
-        sum = topSum;
-        sumSq = topSumSq;
+        sum   += colSum  [x + winLen];
+        sumSq += colSumSq[x + winLen];
       }
-      else if (x > 0)
+      if (x > winLen)
       {
-        if (x < width - winLens)
-        {
-          pWinY -= (y <= winLens ? y : winLens)*stride;
-          if (y == 0)
-          {
-            leftColSum[x + winLens] = 0;
-            leftColSumSq[x + winLens] = 0;
-            for (by = y1; by <= y2; by++)
-            {
-              leftColSum[x + winLens] += pWinY[x + winLens];
-              leftColSumSq[x + winLens] +=  (int64_t)pWinY[x + winLens] *  (int64_t)pWinY[x + winLens];
-              pWinY += stride;
-            }
-          }
-          else
-          {
-            leftColSum[x + winLens] = topColSum[x + winLens];
-            leftColSumSq[x + winLens] = topColSumSq[x + winLens];
-            if (y < height - winLens)
-            {
-              pWinY = &picY.buf[0];
-              pWinY += winLens * stride;
-              leftColSum[x + winLens] += pWinY[x + winLens];
-              leftColSumSq[x + winLens] +=  (int64_t)pWinY[x + winLens] *  (int64_t)pWinY[x + winLens];
-            }
-            if (y > winLens)
-            {
-              pWinY = &picY.buf[0];
-              pWinY -= (winLens + 1) * stride;
-              leftColSum[x + winLens] -= pWinY[x + winLens];
-              leftColSumSq[x + winLens] -=  (int64_t)pWinY[x + winLens] *  (int64_t)pWinY[x + winLens];
-            }
-          }
-          topColSum[x + winLens] = leftColSum[x + winLens];
-          topColSumSq[x + winLens] = leftColSumSq[x + winLens];
-          leftSum += leftColSum[x + winLens];
-          leftSumSq += leftColSumSq[x + winLens];
-        }
-        if (x > winLens)
-        {
-          leftSum -= leftColSum[x - 1 - winLens];
-          leftSumSq -= leftColSumSq[x - 1 - winLens];
-        }
-        sum = leftSum;
-        sumSq = leftSumSq;
+        sum   -= colSum  [x - 1 - winLen];
+        sumSq -= colSumSq[x - 1 - winLen];
       }
 
+      const Pel pxlY = picY.buf[x];
+      const int x1 = std::max(x - winLen, 0);
+      const int x2 = std::min(x + winLen, width - 1);
+      const uint32_t numPixInPart = (x2 - x1 + 1) * (y2 - y1 + 1);
+
       double average = double(sum) / numPixInPart;
       double variance = double(sumSq) / numPixInPart - average * average;
-      int binLen = m_reshapeLUTSize / m_binNum;
-      uint32_t binIdx = (uint32_t)(pxlY / binLen);
-      average = average / (double)(1 << (m_lumaBD - 10));
       variance = variance / (double)(1 << (2 * (m_lumaBD - 10)));
-      binIdx = (uint32_t)((pxlY >> (m_lumaBD - 10)) / binLen);
+      uint32_t binIdx = (uint32_t)((pxlY >> (m_lumaBD - 10)) / binLen);
       double varLog10 = log10(variance + 1.0);
       stats.binVar[binIdx] += varLog10;
       binCnt[binIdx]++;
@@ -358,12 +259,6 @@ void EncReshape::calcSeqStats(Picture& pic, SeqInfo &stats)
     stats.binVar[b] = (binCnt[b] > 0) ? (stats.binVar[b] / binCnt[b]) : 0.0;
   }
   delete[] binCnt;
-  delete[] topColSum;
-  delete[] topColSumSq;
-  delete[] topRowSum;
-  delete[] topRowSumSq;
-  delete[] leftColSum;
-  delete[] leftColSumSq;
 
   stats.minBinVar = 5.0;
   stats.maxBinVar = 0.0;
@@ -393,36 +288,17 @@ void EncReshape::calcSeqStats(Picture& pic, SeqInfo &stats)
   CPelBuf picV = pic.getOrigBuf(COMP_Cr);
   const int widthC = picU.width;
   const int heightC = picU.height;
-  const int strideC = picU.stride;
-  double avgY = 0.0, avgU = 0.0, avgV = 0.0;
-  double varY = 0.0, varU = 0.0, varV = 0.0;
-  for (int y = 0; y < height; y++)
-  {
-    for (int x = 0; x < width; x++)
-    {
-      avgY += picY.buf[x];
-      varY += (double)picY.buf[x] * (double)picY.buf[x];
-    }
-    picY.buf += stride;
-  }
-  for (int y = 0; y < heightC; y++)
-  {
-    for (int x = 0; x < widthC; x++)
-    {
-      avgU += picU.buf[x];
-      avgV += picV.buf[x];
-      varU += (int64_t)picU.buf[x] * (int64_t)picU.buf[x];
-      varV += (int64_t)picV.buf[x] * (int64_t)picV.buf[x];
-    }
-    picU.buf += strideC;
-    picV.buf += strideC;
-  }
-  avgY = avgY / (width * height);
-  avgU = avgU / (widthC * heightC);
-  avgV = avgV / (widthC * heightC);
-  varY = varY / (width * height) - avgY * avgY;
-  varU = varU / (widthC * heightC) - avgU * avgU;
-  varV = varV / (widthC * heightC) - avgV * avgV;
+  int64_t sumY = 0, sumU = 0, sumV = 0;
+  int64_t sumSqY = 0, sumSqU = 0, sumSqV = 0;
+  g_pelBufOP.sumAndSumSq(picY.buf, picY.stride, width,  height,  &sumY, &sumSqY);
+  g_pelBufOP.sumAndSumSq(picU.buf, picU.stride, widthC, heightC, &sumU, &sumSqU);
+  g_pelBufOP.sumAndSumSq(picV.buf, picV.stride, widthC, heightC, &sumV, &sumSqV);
+  double avgY = (double)sumY / (width * height);
+  double avgU = (double)sumU / (widthC * heightC);
+  double avgV = (double)sumV / (widthC * heightC);
+  double varY = (double)sumSqY / (width * height) - avgY * avgY;
+  double varU = (double)sumSqU / (widthC * heightC) - avgU * avgU;
+  double varV = (double)sumSqV / (widthC * heightC) - avgV * avgV;
   if (varY > 0)
   {
     stats.ratioStdU = sqrt(varU) / sqrt(varY);
@@ -122,10 +122,40 @@ void EncSampleAdaptiveOffset::setCtuEncRsrc( CABACWriter* cabacEstimator, CtxCac
   m_CtxCache       = ctxCache;
 }
 
-void EncSampleAdaptiveOffset::disabledRate( CodingStructure& cs, double saoDisabledRate[ MAX_NUM_COMP ][ VVENC_MAX_TLAYER ], SAOBlkParam* reconParams, const double saoEncodingRate, const double saoEncodingRateChroma, const ChromaFormat& chromaFormat )
+void EncSampleAdaptiveOffset::inheritDisabledRate( Picture& pic )
+{
+  // take the disabled rates per layer from the most recent picture in coding order known by the reference pictures,
+  // which are finished at this point, thus the decision does not depend on the number of pictures encoded in parallel
+  ::memset( pic.saoDisabledRate, 0, sizeof( pic.saoDisabledRate ) );
+  std::fill_n( pic.saoDisabledRateIdx, VVENC_MAX_TLAYER, -1 );
+
+  const Slice& slice = *pic.slices[ 0 ];
+  for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+  {
+    for( int refIdx = 0; refIdx < slice.numRefIdx[ refList ]; refIdx++ )
+    {
+      const Picture* refPic = slice.refPicList[ refList ][ refIdx ];
+      for( int tempLayer = 0; tempLayer < VVENC_MAX_TLAYER; tempLayer++ )
+      {
+        if( refPic->saoDisabledRateIdx[ tempLayer ] > pic.saoDisabledRateIdx[ tempLayer ] )
+        {
+          pic.saoDisabledRateIdx[ tempLayer ] = refPic->saoDisabledRateIdx[ tempLayer ];
+          for( int compIdx = 0; compIdx < MAX_NUM_COMP; compIdx++ )
+          {
+            pic.saoDisabledRate[ compIdx ][ tempLayer ] = refPic->saoDisabledRate[ compIdx ][ tempLayer ];
+          }
+        }
+      }
+    }
+  }
+}
+
+void EncSampleAdaptiveOffset::disabledRate( CodingStructure& cs, SAOBlkParam* reconParams, const double saoEncodingRate, const double saoEncodingRateChroma, const ChromaFormat& chromaFormat )
 {
   if ( saoEncodingRate > 0.0 )
   {
+    Picture& pic                 = *cs.picture;
+    auto& saoDisabledRate        = pic.saoDisabledRate;
     const PreCalcValues& pcv     = *cs.pcv;
     const int numberOfComponents = getNumberValidComponents( chromaFormat );
     const int picTempLayer       = cs.slice->depth;
@@ -148,17 +178,20 @@ void EncSampleAdaptiveOffset::disabledRate( CodingStructure& cs, double saoDisab
       {
         saoDisabledRate[compIdx][picTempLayer] = (double)numCtusForSAOOff[compIdx]/(double)pcv.sizeInCtus;
       }
+      pic.saoDisabledRateIdx[picTempLayer] = pic.codingOrderIdx;
     }
     else if (picTempLayer == 0)
     {
       saoDisabledRate[COMP_Y][0] = (double)(numCtusForSAOOff[COMP_Y]+numCtusForSAOOff[COMP_Cb]+numCtusForSAOOff[COMP_Cr])/(double)(pcv.sizeInCtus *3);
+      pic.saoDisabledRateIdx[0]  = pic.codingOrderIdx;
     }
   }
 }
 
-void EncSampleAdaptiveOffset::decidePicParams( const CodingStructure& cs, double saoDisabledRate[ MAX_NUM_COMP ][ VVENC_MAX_TLAYER ], bool saoEnabled[ MAX_NUM_COMP ], const double saoEncodingRate, const double saoEncodingRateChroma, const ChromaFormat& chromaFormat )
+void EncSampleAdaptiveOffset::decidePicParams( const CodingStructure& cs, bool saoEnabled[ MAX_NUM_COMP ], const double saoEncodingRate, const double saoEncodingRateChroma, const ChromaFormat& chromaFormat )
 {
   const Slice& slice           = *cs.slice;
+  auto& saoDisabledRate        = cs.picture->saoDisabledRate;
   const int numberOfComponents = getNumberValidComponents( chromaFormat );
 
   // reset
@@ -1030,9 +1063,9 @@ void EncSampleAdaptiveOffset::deriveLoopFilterBoundaryAvailibility(CodingStructu
 
   if (!isLoopFiltAcrossSlicePPS)
   {
-    isLeftAvail      = (cuLeft == NULL)      ? false : CU::isSameTile(*cuCurr, *cuLeft);
-    isAboveAvail     = (cuAbove == NULL)     ? false : CU::isSameTile(*cuCurr, *cuAbove);
-    isAboveLeftAvail = (cuAboveLeft == NULL) ? false : CU::isSameTile(*cuCurr, *cuAboveLeft);
+    isLeftAvail      = (cuLeft == NULL)      ? false : CU::isSameSlice(*cuCurr, *cuLeft);
+    isAboveAvail     = (cuAbove == NULL)     ? false : CU::isSameSlice(*cuCurr, *cuAbove);
+    isAboveLeftAvail = (cuAboveLeft == NULL) ? false : CU::isSameSlice(*cuCurr, *cuAboveLeft);
   }
   else
   {
@@ -53,6 +53,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include "EncLib.h"
 #include "EncPicture.h"
 #include "BitAllocation.h"
+#include "EncSpeedCtrl.h"
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/TimeProfiler.h"
@@ -103,15 +104,17 @@ struct CtuEncParam
 {
   Picture*  pic;
   EncSlice* encSlice;
+  Slice*    slice;
   int       ctuRsAddr;
   int       ctuPosX;
   int       ctuPosY;
   UnitArea  ctuArea;
 
-  CtuEncParam() : pic( nullptr ), encSlice( nullptr ), ctuRsAddr( 0 ), ctuPosX( 0 ), ctuPosY( 0 ), ctuArea() {}
+  CtuEncParam() : pic( nullptr ), encSlice( nullptr ), slice( nullptr ), ctuRsAddr( 0 ), ctuPosX( 0 ), ctuPosY( 0 ), ctuArea() {}
   CtuEncParam( Picture* _p, EncSlice* _s, const int _r, const int _x, const int _y )
     : pic( _p )
     , encSlice( _s )
+    , slice( _p->slices[0] )
     , ctuRsAddr( _r )
     , ctuPosX( _x )
     , ctuPosY( _y )
@@ -131,7 +134,6 @@ EncSlice::EncSlice()
   , m_pALF               ( nullptr )
   , m_pcRateCtrl         ( nullptr )
   , m_CABACWriter        ( m_BinEncoder )
-  , m_encCABACTableIdx   ( VVENC_I_SLICE )
 {
 }
 
@@ -181,6 +183,10 @@ void EncSlice::init( const VVEncCfg& encCfg,
   m_ctuTasksDoneCounter = ctuTasksDoneCounter;
   m_syncPicCtx.resize( encCfg.m_entropyCodingSyncEnabled ? pps.pcv->heightInCtus : 0 );
 
+  // with real-time speed control, the CU encoders use a copy of the configuration that is adapted per picture
+  m_speedCfg = encCfg;
+  const VVEncCfg& cuEncCfg = encCfg.m_RealTimeFps > 0.0 ? m_speedCfg : encCfg;
+
   const int maxCntRscr = ( encCfg.m_numThreads > 0 ) ? pps.pcv->heightInCtus : 1;
   const int maxCtuEnc  = ( encCfg.m_numThreads > 0 && threadPool ) ? threadPool->numThreads() : 1;
 
@@ -195,7 +201,7 @@ void EncSlice::init( const VVEncCfg& encCfg,
   for( LineEncRsrc*& lnRsc : m_LineEncRsrc )
   {
     lnRsc = new LineEncRsrc( encCfg );
-    lnRsc->m_encCu.init( encCfg,
+    lnRsc->m_encCu.init( cuEncCfg,
                          sps,
                          globalCtuQpVector,
                          m_syncPicCtx.data(),
@@ -210,8 +216,6 @@ void EncSlice::init( const VVEncCfg& encCfg,
   m_processStates = std::vector<ProcessCtuState>( sizeInCtus );
   m_saoReconParams.resize( sizeInCtus );
 
-  ::memset( m_saoDisabledRate, 0, sizeof( m_saoDisabledRate ) );
-
   // sao statistics
   if( encCfg.m_bUseSAO )
   {
@@ -235,13 +239,16 @@ void EncSlice::initPic( Picture* pic, int gopId )
 
   slice->sliceMap.addCtusToSlice( 0, pic->cs->pcv->widthInCtus, 0, pic->cs->pcv->heightInCtus, pic->cs->pcv->widthInCtus);
 
-  // this ensures that independently encoded bitstream chunks can be combined to bit-equal
-  const SliceType cabacTableIdx = ! slice->pps->cabacInitPresent || slice->pendingRasInit ? slice->sliceType : m_encCABACTableIdx;
-  slice->encCABACTableIdx = cabacTableIdx;
-
   // set QP and lambda values
   xInitSliceLambdaQP( slice, gopId );
 
+  if( m_pcEncCfg->m_RealTimeFps > 0.0 )
+  {
+    // refresh the copy, the base configuration may have been changed by a reconfiguration
+    m_speedCfg = *m_pcEncCfg;
+    EncSpeedCtrl::applySpeedLevel( m_speedCfg, *m_pcEncCfg, pic->speedLevel );
+  }
+
   for( auto* lnRsc : m_LineEncRsrc )
   {
     lnRsc->m_ReuseUniMv.resetReusedUniMvs();
@@ -278,7 +285,7 @@ void EncSlice::xInitSliceLambdaQP( Slice* slice, int gopId )
       ((slice->isIntra() && !slice->sps->IBC) || (m_pcEncCfg->m_sliceChromaQpOffsetPeriodicity > 0 && (slice->poc % m_pcEncCfg->m_sliceChromaQpOffsetPeriodicity) == 0)))
   {
     adaptedLumaQP = BitAllocation::applyQPAdaptationChroma (slice, m_pcEncCfg, iQP, *m_LineEncRsrc[ 0 ]->m_encCu.getQpPtr(),
-                                                            sliceChromaQpOffsetIntraOrPeriodic, &slice->pic->picVisActY); // adapts sliceChromaQpOffsetIntraOrPeriodic[]
+                                                            sliceChromaQpOffsetIntraOrPeriodic, &slice->pic->picVisActY, m_threadPool); // adapts sliceChromaQpOffsetIntraOrPeriodic[]
   }
   if (m_pcEncCfg->m_usePerceptQPA)
   {
@@ -309,7 +316,7 @@ void EncSlice::xInitSliceLambdaQP( Slice* slice, int gopId )
 
     if ((iQP = BitAllocation::applyQPAdaptationLuma (slice, m_pcEncCfg, adaptedLumaQP, dLambda, *m_LineEncRsrc[ 0 ]->m_encCu.getQpPtr(),
                                                      (rcIsFirstPassOf2 && slice->poc > 0 ? m_pcRateCtrl->getIntraPQPAStats() : nullptr),
-                                                     startCtuTsAddr, boundingCtuTsAddr )) >= 0) // sets pic->ctuAdaptedQP[] & ctuQpaLambda[]
+                                                     startCtuTsAddr, boundingCtuTsAddr, m_threadPool )) >= 0) // sets pic->ctuAdaptedQP[] & ctuQpaLambda[]
     {
       dLambda *= pow (2.0, ((double) iQP - dQP) / 3.0); // adjust lambda based on change of slice QP
     }
@@ -512,7 +519,7 @@ double EncSlice::xCalculateLambda( const Slice*     slice,
 
 /** \param pic   picture class
  */
-void EncSlice::compressSlice( Picture* pic )
+void EncSlice::compressSlice( Picture* pic, std::function<void( Picture&, int )> sliceWriteFunc )
 {
   PROFILER_SCOPE_AND_STAGE( 1, g_timeProfiler, P_COMPRESS_SLICE );
   CodingStructure& cs         = *pic->cs;
@@ -528,6 +535,18 @@ void EncSlice::compressSlice( Picture* pic )
     cs.initStructData (slice->sliceQp );
   }
 
+  xInitSlices( pic );
+
+  // with slice streaming, the slice data is written while the picture is encoded
+  m_sliceWriteFunc = sliceWriteFunc;
+  if( m_sliceWriteFunc )
+  {
+    pic->sliceDataStreams.clear();
+    pic->sliceDataStreams.resize( pic->slices.size() );
+    pic->sliceDataNumBins = 0;
+    pic->numSlicesWritten = 0;
+  }
+
   for( auto* lnRsrc : m_LineEncRsrc )
   {
     lnRsrc->m_CABACEstimator.initCtxModels( *slice );
@@ -550,6 +569,35 @@ void EncSlice::compressSlice( Picture* pic )
   xProcessCtus( pic, startCtuTsAddr, boundingCtuTsAddr );
 }
 
+void EncSlice::xInitSlices( Picture* pic )
+{
+  const PPS& pps = *pic->cs->pps;
+  Slice* slice0  = pic->slices[ 0 ];
+
+  if( pps.numSlicesInPic <= 1 )
+  {
+    return;
+  }
+
+  // all slices share the coding parameters of the first slice, they only differ in the covered ctu's
+  slice0->sliceMap = pps.sliceMap[ 0 ];
+  for( int i = 1; i < (int)pps.numSlicesInPic; i++ )
+  {
+    Slice* slice = pic->allocateNewSlice();
+    *slice       = *slice0;
+    for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+    {
+      if( slice0->rpl[ l ] == &slice0->rplLocal[ l ] )
+      {
+        slice->rpl[ l ] = &slice->rplLocal[ l ];
+      }
+    }
+    slice->independentSliceIdx = i;
+    slice->sliceSubPicId       = i;
+    slice->sliceMap            = pps.sliceMap[ i ];
+  }
+}
+
 void setJointCbCrModes( CodingStructure& cs, const Position topLeftLuma, const Size sizeLuma )
 {
   bool              sgnFlag = true;
@@ -685,7 +733,7 @@ class CtuTsIterator : public std::iterator<std::forward_iterator_tag, int>
 
 void EncSlice::saoDisabledRate( CodingStructure& cs, SAOBlkParam* reconParams )
 {
-  EncSampleAdaptiveOffset::disabledRate( cs, m_saoDisabledRate, reconParams, m_pcEncCfg->m_saoEncodingRate, m_pcEncCfg->m_saoEncodingRateChroma, m_pcEncCfg->m_internChromaFormat );
+  EncSampleAdaptiveOffset::disabledRate( cs, reconParams, m_pcEncCfg->m_saoEncodingRate, m_pcEncCfg->m_saoEncodingRateChroma, m_pcEncCfg->m_internChromaFormat );
 }
 
 void EncSlice::finishCompressSlice( Picture* pic, Slice& slice )
@@ -697,14 +745,6 @@ void EncSlice::finishCompressSlice( Picture* pic, Slice& slice )
   {
     // store disabled statistics
     saoDisabledRate( cs, &m_saoReconParams[ 0 ] );
-
-    // set slice header flags
-    CHECK( m_saoEnabled[ COMP_Cb ] != m_saoEnabled[ COMP_Cr ], "Unspecified error");
-    for( auto s : pic->slices )
-    {
-      s->saoEnabled[ CH_L ] = m_saoEnabled[ COMP_Y  ];
-      s->saoEnabled[ CH_C ] = m_saoEnabled[ COMP_Cb ];
-    }
   }
 
   CS::setRefinedMotionField( cs );
@@ -728,7 +768,8 @@ void EncSlice::xProcessCtus( Picture* pic, const unsigned startCtuTsAddr, const
   if( slice.sps->saoEnabled )
   {
     // check SAO enabled or disabled
-    EncSampleAdaptiveOffset::decidePicParams( cs, m_saoDisabledRate, m_saoEnabled, m_pcEncCfg->m_saoEncodingRate, m_pcEncCfg->m_saoEncodingRateChroma, m_pcEncCfg->m_internChromaFormat );
+    EncSampleAdaptiveOffset::inheritDisabledRate( *pic );
+    EncSampleAdaptiveOffset::decidePicParams( cs, m_saoEnabled, m_pcEncCfg->m_saoEncodingRate, m_pcEncCfg->m_saoEncodingRateChroma, m_pcEncCfg->m_internChromaFormat );
 
     m_saoAllDisabled = true;
     for( int compIdx = 0; compIdx < getNumberValidComponents( pcv.chrFormat ); compIdx++ )
@@ -736,6 +777,14 @@ void EncSlice::xProcessCtus( Picture* pic, const unsigned startCtuTsAddr, const
       m_saoAllDisabled &= ! m_saoEnabled[ compIdx ];
     }
 
+    // set slice header flags, already required when a slice is written before the picture is finished
+    CHECK( m_saoEnabled[ COMP_Cb ] != m_saoEnabled[ COMP_Cr ], "Unspecified error");
+    for( auto s : pic->slices )
+    {
+      s->saoEnabled[ CH_L ] = m_saoEnabled[ COMP_Y  ];
+      s->saoEnabled[ CH_C ] = m_saoEnabled[ COMP_Cb ];
+    }
+
     std::fill( m_saoReconParams.begin(), m_saoReconParams.end(), SAOBlkParam() );
   }
 
@@ -746,6 +795,16 @@ void EncSlice::xProcessCtus( Picture* pic, const unsigned startCtuTsAddr, const
 
   std::fill( m_processStates.begin(), m_processStates.end(), CTU_ENCODE );
 
+  // map ctu's to slices
+  std::vector<Slice*> ctuSlices( pcv.sizeInCtus, pic->slices[ 0 ] );
+  for( auto s : pic->slices )
+  {
+    for( auto ctuAddr : s->sliceMap.ctuAddrInSlice )
+    {
+      ctuSlices[ ctuAddr ] = s;
+    }
+  }
+
   // fill encoder parameter list
   int idx = 0;
   auto ctuIter = CtuTsIterator( cs, startCtuTsAddr, boundingCtuTsAddr, m_pcEncCfg->m_numThreads > 0 );
@@ -753,6 +812,7 @@ void EncSlice::xProcessCtus( Picture* pic, const unsigned startCtuTsAddr, const
   {
     ctuEncParams[ idx ].pic       = pic;
     ctuEncParams[ idx ].encSlice  = this;
+    ctuEncParams[ idx ].slice     = ctuSlices[ ctuPos.ctuRsAddr ];
     ctuEncParams[ idx ].ctuRsAddr = ctuPos.ctuRsAddr;
     ctuEncParams[ idx ].ctuPosX   = ctuPos.ctuPosX;
     ctuEncParams[ idx ].ctuPosY   = ctuPos.ctuPosY;
@@ -848,7 +908,7 @@ bool EncSlice::xProcessCtuTask( int threadIdx, CtuEncParam* ctuEncParam )
         EncCu& encCu             = lineEncRsrc->m_encCu;
 
         encCu.setCtuEncRsrc( &lineEncRsrc->m_CABACEstimator, &taskRsrc->m_CtxCache, &lineEncRsrc->m_ReuseUniMv, &lineEncRsrc->m_BlkUniMvInfoBuffer, &lineEncRsrc->m_AffineProfList, &lineEncRsrc->m_CachedBvs );
-        encCu.encodeCtu( pic, lineEncRsrc->m_prevQp, ctuPosX, ctuPosY );
+        encCu.encodeCtu( pic, ctuEncParam->slice, lineEncRsrc->m_prevQp, ctuPosX, ctuPosY );
 
         // cleanup line memory when last ctu in line done to reduce overall memory consumption
         if( encSlice->m_pcEncCfg->m_ensureWppBitEqual && ctuPosX == pcv.widthInCtus - 1 )
@@ -1012,9 +1072,23 @@ bool EncSlice::xProcessCtuTask( int threadIdx, CtuEncParam* ctuEncParam )
         if( ctuPosX + 1 < pcv.widthInCtus && ctuPosY + 1 < pcv.heightInCtus && processStates[ ctuRsAddr + 1 + ctuStride ] <= SAO_FILTER )
           return false;
 
+        // with slice streaming, the slice is written by its last ctu
+        // due to the wpp and line ordering conditions, all ctu's of the slice have been filtered at this point,
+        // only the previous slice has to be written before
+        const Slice* ctuSlice  = ctuEncParam->slice;
+        const bool writeSlice  = encSlice->m_sliceWriteFunc && ctuRsAddr == ctuSlice->sliceMap.ctuAddrInSlice.back();
+        if( writeSlice && ctuSlice->independentSliceIdx > 0 && processStates[ pic->slices[ ctuSlice->independentSliceIdx - 1 ]->sliceMap.ctuAddrInSlice.back() ] <= ALF_GET_STATISTICS )
+          return false;
+
         if( checkReadyState )
           return true;
 
+        if( writeSlice )
+        {
+          encSlice->encodeSliceData( pic, ctuEncParam->slice );
+          encSlice->m_sliceWriteFunc( *pic, ctuSlice->independentSliceIdx );
+        }
+
         ITT_TASKSTART( itt_domain_encode, itt_handle_alf_stat );
 
         // ALF pre-processing
@@ -1131,18 +1205,13 @@ bool EncSlice::xProcessCtuTask( int threadIdx, CtuEncParam* ctuEncParam )
   return false;
 }
 
-void EncSlice::encodeSliceData( Picture* pic )
+void EncSlice::encodeSliceData( Picture* pic, Slice* slice )
 {
   CodingStructure& cs              = *pic->cs;
-  Slice* const slice               = cs.slice;
-  const uint32_t startCtuTsAddr    = slice->sliceMap.ctuAddrInSlice[0];
-  const uint32_t boundingCtuTsAddr = cs.pcv->sizeInCtus;
+  const SliceMap& sliceMap         = slice->sliceMap;
+  const uint32_t numCtusInSlice    = sliceMap.numCtuInSlice;
   const bool wavefrontsEnabled     = slice->sps->entropyCodingSyncEnabled;
 
-  // this ensures that independently encoded bitstream chunks can be combined to bit-equal
-  const SliceType cabacTableIdx = ! slice->pps->cabacInitPresent || slice->pendingRasInit ? slice->sliceType : m_encCABACTableIdx;
-  slice->encCABACTableIdx = cabacTableIdx;
-
   // initialise entropy coder for the slice
   m_CABACWriter.initCtxModels( *slice );
 
@@ -1154,16 +1223,14 @@ void EncSlice::encodeSliceData( Picture* pic )
   const PreCalcValues& pcv        = *cs.pcv;
   const uint32_t widthInCtus      = pcv.widthInCtus;
   uint32_t uiSubStrm              = 0;
-  const int numSubstreamsColumns  = slice->pps->numExpTileCols;
-  const int numSubstreamRows      = slice->sps->entropyCodingSyncEnabled ? pic->cs->pcv->heightInCtus : slice->pps->numExpTileRows;
-  const int numSubstreams         = std::max<int>( numSubstreamRows * numSubstreamsColumns, 0/*(int)pic->brickMap->bricks.size()*/ );
+  const int numSubstreams         = slice->getNumEntryPoints( *slice->sps, *slice->pps ) + 1;
   std::vector<OutputBitstream> substreamsOut( numSubstreams );
 
   slice->clearSubstreamSizes();
 
-  for( uint32_t ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
+  for( uint32_t ctuIdx = 0; ctuIdx < numCtusInSlice; ctuIdx++ )
   {
-    const uint32_t ctuRsAddr = (ctuTsAddr);
+    const uint32_t ctuRsAddr = sliceMap.ctuAddrInSlice[ ctuIdx ];
     const uint32_t firstCtuRsAddrOfTile = 0;
     const uint32_t tileXPosInCtus       = firstCtuRsAddrOfTile % widthInCtus;
     const uint32_t ctuXPosInCtus        = ctuRsAddr % widthInCtus;
@@ -1179,7 +1246,7 @@ void EncSlice::encodeSliceData( Picture* pic )
     // set up CABAC contexts' state for this CTU
     if (ctuRsAddr == firstCtuRsAddrOfTile)
     {
-      if (ctuTsAddr != startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
+      if (ctuIdx != 0) // if it is the first CTU, then the entropy coder has already been reset
       {
         m_CABACWriter.initCtxModels( *slice );
       }
@@ -1187,7 +1254,7 @@ void EncSlice::encodeSliceData( Picture* pic )
     else if (ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled)
     {
       // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
-      if (ctuTsAddr != startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
+      if (ctuIdx != 0) // if it is the first CTU, then the entropy coder has already been reset
       {
         m_CABACWriter.initCtxModels( *slice );
       }
@@ -1208,7 +1275,7 @@ void EncSlice::encodeSliceData( Picture* pic )
 
     // terminate the sub-stream, if required (end of slice-segment, end of tile, end of wavefront-CTU-row):
     bool isLastCTUinWPP = wavefrontsEnabled && (((ctuRsAddr + 1) % widthInCtus) == tileXPosInCtus);
-    bool isMoreCTUsinSlice = ctuRsAddr != (boundingCtuTsAddr - 1);
+    bool isMoreCTUsinSlice = ctuIdx + 1 < numCtusInSlice;
     if (isLastCTUinWPP || !isMoreCTUsinSlice)         // this the the last CTU of either tile/brick/WPP/slice
     {
       m_CABACWriter.end_of_slice();
@@ -1227,15 +1294,15 @@ void EncSlice::encodeSliceData( Picture* pic )
 
   if(slice->pps->cabacInitPresent)
   {
-    m_encCABACTableIdx = m_CABACWriter.getCtxInitId( *slice );
+    pic->cabacTableIdxEst = m_CABACWriter.getCtxInitId( *slice );
   }
   else
   {
-    m_encCABACTableIdx = slice->sliceType;
+    pic->cabacTableIdxEst = slice->sliceType;
   }
 
   // concatenate substreams
-  OutputBitstream& outStream = pic->sliceDataStreams[ 0/*slice->sliceIdx*/ ];
+  OutputBitstream& outStream = pic->sliceDataStreams[ slice->independentSliceIdx ];
   for ( int i = 0; i < slice->getNumberOfSubstreamSizes() + 1; i++ )
   {
     outStream.addSubstream( &(substreamsOut[ i ]) );
@@ -55,6 +55,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include "InterSearch.h"
 
 #include <atomic>
+#include <functional>
 
 //! \ingroup EncoderLib
 //! \{
@@ -96,6 +97,7 @@ class EncSlice
 private:
   // encoder configuration
   const VVEncCfg*              m_pcEncCfg;                           ///< encoder configuration class
+  VVEncCfg                     m_speedCfg;                           ///< configuration of the CU encoders, adapted by the real-time speed control
 
   std::vector<PerThreadRsrc*>  m_CtuTaskRsrc;
   std::vector<LineEncRsrc*>    m_LineEncRsrc;
@@ -112,14 +114,13 @@ private:
 
   Ctx                          m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row used for writing
   std::vector<Ctx>             m_syncPicCtx;                         ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row used for estimation
-  SliceType                    m_encCABACTableIdx;
 
-  double                       m_saoDisabledRate[ MAX_NUM_COMP ][ VVENC_MAX_TLAYER ];
   bool                         m_saoEnabled[ MAX_NUM_COMP ];
   bool                         m_saoAllDisabled;
   std::vector<SAOBlkParam>     m_saoReconParams;
   std::vector<SAOStatData**>   m_saoStatData;
   std::vector<CtuEncParam>     ctuEncParams;
+  std::function<void( Picture&, int )> m_sliceWriteFunc;             ///< writes the NAL unit of a slice as soon as the slice is coded (slice streaming)
 
 public:
   EncSlice();
@@ -138,8 +139,8 @@ public:
   void    initPic             ( Picture* pic, int gopId );
 
   // compress and encode slice
-  void    compressSlice       ( Picture* pic );      ///< analysis stage of slice                     s
-  void    encodeSliceData     ( Picture* pic );
+  void    compressSlice       ( Picture* pic, std::function<void( Picture&, int )> sliceWriteFunc = nullptr ); ///< analysis stage of slice
+  void    encodeSliceData     ( Picture* pic, Slice* slice );
   void    saoDisabledRate     ( CodingStructure& cs, SAOBlkParam* reconParams );
   void    finishCompressSlice ( Picture* pic, Slice& slice );
 
@@ -147,6 +148,7 @@ public:
 
 private:
   void    xInitSliceLambdaQP   ( Slice* slice, int gopId );
+  void    xInitSlices          ( Picture* pic );
   double  xCalculateLambda     ( const Slice* slice, const int GOPid, const int depth, const double refQP, const double dQP, int& iQP );
   void    xProcessCtus         ( Picture* pic, const unsigned startCtuTsAddr, const unsigned boundingCtuTsAddr );
   template<bool checkReadyState=false>
@@ -0,0 +1,227 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     EncSpeedCtrl.cpp
+\brief    deadline driven speed control for real-time encoding
+*/
+
+#include "EncSpeedCtrl.h"
+
+#include "CommonLib/Slice.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+struct SpeedLevelParams
+{
+  int searchRangeShift;
+  int mttDepthReduction;
+  int fastMrg;
+  int fastIntraTools;
+  int qtbttSpeedUp;
+  int intraEstDecBit;
+  bool fastSubPel;
+  bool earlyCU;
+  bool pbIntraFast;
+  bool integerET;
+  bool contentBasedFastQtbt;
+};
+
+// the knobs are lower bounds, a speed level never makes the base configuration slower
+static const SpeedLevelParams SPEED_LEVELS[ RT_NUM_SPEED_LEVELS ] =
+{
+  // SR  MTT  FastMrg  FastIntra  QtbttFast  IntraDec  FastSubPel  EarlyCU  PbIntraFast  IntegerET  CBFastQtbt
+  {  0,   0,     0,        0,         0,         0,      false,     false,     false,      false,      false },
+  {  1,   0,     2,        1,         2,         3,      true,      true,      true,       false,      true  },
+  {  2,   0,     2,        2,         3,         3,      true,      true,      true,       true,       true  },
+  {  2,   1,     2,        2,         3,         3,      true,      true,      true,       true,       true  },
+  {  2,   2,     2,        2,         3,         3,      true,      true,      true,       true,       true  },
+  {  3,   3,     2,        2,         3,         3,      true,      true,      true,       true,       true  },
+};
+
+static const int    RT_MIN_SEARCH_RANGE = 16;
+static const double RT_SPEED_DOWN_RATIO = 0.75;   // slow down, if the pictures take less than this fraction of the frame time
+static const double RT_COST_ALPHA       = 0.5;    // update rate of the per picture type encoding times
+static const int    RT_HOLD_OFF         = 4;      // min. number of pictures between two speed level changes
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+EncSpeedCtrl::EncSpeedCtrl()
+  : m_pcEncCfg  ( nullptr )
+  , m_frameTime ( 0.0 )
+  , m_queueDepth( 0.0 )
+  , m_numPics   ( 0 )
+  , m_holdOff   ( 0 )
+  , m_level     ( 0 )
+{
+  std::fill_n( m_picTime, RT_NUM_PIC_TYPES, -1.0 );
+}
+
+void EncSpeedCtrl::init( const VVEncCfg& encCfg )
+{
+  m_pcEncCfg   = &encCfg;
+  m_frameTime  = encCfg.m_RealTimeFps > 0.0 ? 1.0 / encCfg.m_RealTimeFps : 0.0;
+  m_queueDepth = 0.0;
+  m_numPics    = 0;
+  m_holdOff    = 0;
+  m_level      = 0;
+  std::fill_n( m_picTime, RT_NUM_PIC_TYPES, -1.0 );
+}
+
+void EncSpeedCtrl::initPicture( Picture& pic )
+{
+  pic.speedLevel = m_level;
+
+  // restrict the multi-type tree depth by the partitioning constraints override of the picture header
+  const int reduction = SPEED_LEVELS[ pic.speedLevel ].mttDepthReduction;
+  if( reduction > 0 )
+  {
+    PicHeader* picHeader = pic.cs->picHeader;
+    const SPS& sps       = *pic.cs->sps;
+    CHECK( ! sps.partitionOverrideEnabled, "speed control requires partitioning constraints override" );
+    for( int i = 0; i < 3; i++ )
+    {
+      picHeader->maxMTTDepth[ i ] = std::max<int>( 0, sps.maxMTTDepth[ i ] - reduction );
+    }
+    picHeader->splitConsOverride = true;
+  }
+}
+
+void EncSpeedCtrl::finishPicture( const Picture& pic )
+{
+  const auto   now       = std::chrono::steady_clock::now();
+  const int    numPicEnc = std::max( 1, m_pcEncCfg->m_maxParallelFrames );
+  const double picTime   = std::chrono::duration<double>( pic.encTime.m_timer ).count() / numPicEnc;
+  const int    picType   = xGetPicType( pic.slices[ 0 ]->isIntra(), pic.TLayer );
+
+  m_picTime[ picType ] = m_picTime[ picType ] < 0.0 ? picTime : m_picTime[ picType ] + RT_COST_ALPHA * ( picTime - m_picTime[ picType ] );
+
+  // queue of a live source delivering one frame per frame time, while the encoder outputs one picture
+  if( m_numPics > 0 )
+  {
+    const double outTime = std::chrono::duration<double>( now - m_lastOutTime ).count();
+    m_queueDepth = std::max( 0.0, m_queueDepth + outTime / m_frameTime - 1.0 );
+  }
+  m_lastOutTime = now;
+  m_numPics    += 1;
+
+  // bounded queue depth: switch to the fastest level immediately
+  if( m_queueDepth > m_pcEncCfg->m_RealTimeMaxDelay )
+  {
+    m_level   = RT_NUM_SPEED_LEVELS - 1;
+    m_holdOff = RT_HOLD_OFF;
+    return;
+  }
+
+  if( m_holdOff > 0 )
+  {
+    m_holdOff -= 1;
+    return;
+  }
+
+  const double predTime = xGetPredFrameTime( picTime );
+  if( ( predTime > m_frameTime || m_queueDepth > 0.5 * m_pcEncCfg->m_RealTimeMaxDelay ) && m_level < RT_NUM_SPEED_LEVELS - 1 )
+  {
+    m_level  += 1;
+    m_holdOff = RT_HOLD_OFF;
+  }
+  else if( predTime < RT_SPEED_DOWN_RATIO * m_frameTime && m_queueDepth < 1.0 && m_level > 0 )
+  {
+    m_level  -= 1;
+    m_holdOff = RT_HOLD_OFF;
+  }
+}
+
+void EncSpeedCtrl::applySpeedLevel( VVEncCfg& dst, const VVEncCfg& base, int level )
+{
+  CHECK( level < 0 || level >= RT_NUM_SPEED_LEVELS, "speed level out of range" );
+  const SpeedLevelParams& params = SPEED_LEVELS[ level ];
+
+  dst.m_SearchRange          = std::max( std::min( base.m_SearchRange,       RT_MIN_SEARCH_RANGE ), base.m_SearchRange       >> params.searchRangeShift );
+  dst.m_bipredSearchRange    = std::max( std::min( base.m_bipredSearchRange, RT_MIN_SEARCH_RANGE ), base.m_bipredSearchRange >> params.searchRangeShift );
+  dst.m_useFastMrg           = std::max( base.m_useFastMrg,     params.fastMrg );
+  dst.m_FastIntraTools       = std::max( base.m_FastIntraTools, params.fastIntraTools );
+  dst.m_qtbttSpeedUp         = std::max( base.m_qtbttSpeedUp,   params.qtbttSpeedUp );
+  dst.m_IntraEstDecBit       = std::max( base.m_IntraEstDecBit, params.intraEstDecBit );
+  dst.m_fastSubPel           = std::max( base.m_fastSubPel,     params.fastSubPel ? 1 : 0 );
+  dst.m_bUseEarlyCU          = base.m_bUseEarlyCU          || params.earlyCU;
+  dst.m_usePbIntraFast       = base.m_usePbIntraFast       || params.pbIntraFast;
+  dst.m_bIntegerET           = base.m_bIntegerET           || params.integerET;
+  dst.m_contentBasedFastQtbt = base.m_contentBasedFastQtbt || params.contentBasedFastQtbt;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+double EncSpeedCtrl::xGetPredFrameTime( double lastPicTime ) const
+{
+  // average encoding time per frame of the GOP structure, picture types not encoded yet take the last picture time
+  const int gopSize = m_pcEncCfg->m_GOPSize;
+  double gopTime    = 0.0;
+  for( int i = 0; i < gopSize; i++ )
+  {
+    const int picType = xGetPicType( false, m_pcEncCfg->m_GOPList[ i ].m_temporalId );
+    gopTime += m_picTime[ picType ] < 0.0 ? lastPicTime : m_picTime[ picType ];
+  }
+
+  // intra pictures replace a key picture once per intra period
+  const int keyType = xGetPicType( false, 0 );
+  if( m_picTime[ 0 ] >= 0.0 && m_pcEncCfg->m_IntraPeriod > 0 )
+  {
+    const double keyTime = m_picTime[ keyType ] < 0.0 ? lastPicTime : m_picTime[ keyType ];
+    gopTime += ( m_picTime[ 0 ] - keyTime ) * gopSize / m_pcEncCfg->m_IntraPeriod;
+  }
+
+  return gopTime / gopSize;
+}
+
+} // namespace vvenc
+
+//! \}
@@ -0,0 +1,102 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     EncSpeedCtrl.h
+\brief    deadline driven speed control for real-time encoding (header)
+*/
+
+#pragma once
+
+#include "CommonLib/Picture.h"
+
+#include <chrono>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+static const int RT_NUM_SPEED_LEVELS = 6;
+static const int RT_NUM_PIC_TYPES    = VVENC_MAX_TLAYER + 1;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+class EncSpeedCtrl
+{
+public:
+  EncSpeedCtrl();
+  ~EncSpeedCtrl() {}
+
+  void init            ( const VVEncCfg& encCfg );
+  bool isActive        () const { return m_frameTime > 0.0; }
+
+  // in coding order, before the picture is compressed
+  void initPicture     ( Picture& pic );
+  // in coding order, after the picture has been written
+  void finishPicture   ( const Picture& pic );
+
+  // derive the speed knobs of a speed level from the base configuration
+  static void applySpeedLevel( VVEncCfg& dst, const VVEncCfg& base, int level );
+
+private:
+  static int xGetPicType       ( bool isIntra, int TLayer ) { return isIntra ? 0 : std::min( TLayer + 1, RT_NUM_PIC_TYPES - 1 ); }
+  double     xGetPredFrameTime ( double lastPicTime ) const;
+
+private:
+  const VVEncCfg*                       m_pcEncCfg;
+  double                                m_frameTime;
+  double                                m_picTime[ RT_NUM_PIC_TYPES ];
+  double                                m_queueDepth;
+  int                                   m_numPics;
+  int                                   m_holdOff;
+  int                                   m_level;
+  std::chrono::steady_clock::time_point m_lastOutTime;
+};
+
+} // namespace vvenc
+
+//! \}
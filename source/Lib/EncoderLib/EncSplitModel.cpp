@@ -0,0 +1,173 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     EncSplitModel.cpp
+\brief    statistical early termination of the coding unit splits
+*/
+
+#include "EncSplitModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// trained on the split decisions of the fast and medium presets (QP 22..42) for natural and screen content
+static const float SPLIT_MODEL_WEIGHTS[ NUM_SPLIT_CLASSES ][ NUM_SPLIT_FEATURES ] =
+{
+  { -25.9228f,  0.1121f,  0.0000f, 29.3099f,  1.2020f,  0.1894f, -1.5287f, -0.5786f,  1.4960f,  1.3737f,  0.0000f,  0.4769f }, // QT
+  {  -5.2265f, -0.2867f, -0.2986f,  8.2341f,  0.2375f, -0.0113f, -1.0441f,  0.0755f,  0.4170f,  0.5433f,  0.3614f,  0.0862f }, // BT horizontal
+  {  -8.7671f, -0.2615f,  0.3549f, 15.5322f,  0.4348f, -0.1198f, -0.9493f, -0.0506f,  0.3212f,  0.4199f,  0.3813f,  0.0442f }, // BT vertical
+  {  -5.9233f, -0.4707f,  0.1828f, 13.5374f,  0.3896f, -0.0276f, -1.0324f,  0.0019f, -1.1310f,  1.1808f,  0.6478f,  0.4661f }, // TT horizontal
+  {  -9.3903f, -0.2341f, -0.1330f, 13.0728f,  0.4537f,  0.1276f, -0.5166f, -0.1676f, -0.8660f,  0.9237f,  0.9510f,  0.3413f }, // TT vertical
+};
+
+// the encoder instances of all threads append their samples at the end of the encoding
+static std::mutex s_dumpMutex;
+
+void EncSplitModel::init( const VVEncCfg& encCfg )
+{
+  m_threshold    = encCfg.m_SplitModelConf > 0.0 ? 1.0 - encCfg.m_SplitModelConf : 0.0;
+  m_dump         = encCfg.m_SplitModelDumpFile[0] != '\0';
+  m_dumpFileName = encCfg.m_SplitModelDumpFile;
+  m_samples.clear();
+  m_labels.clear();
+
+  std::copy( &SPLIT_MODEL_WEIGHTS[0][0], &SPLIT_MODEL_WEIGHTS[0][0] + NUM_SPLIT_CLASSES * NUM_SPLIT_FEATURES, &m_weights[0][0] );
+
+  if( encCfg.m_SplitModelFile[0] != '\0' )
+  {
+    // one line of weights per split type in the order QT, BT_H, BT_V, TT_H, TT_V, lines starting with # are ignored
+    std::ifstream file( encCfg.m_SplitModelFile );
+    CHECK( !file.is_open(), "cannot open split model file " << encCfg.m_SplitModelFile );
+
+    int         cls = 0;
+    std::string line;
+    while( cls < NUM_SPLIT_CLASSES && std::getline( file, line ) )
+    {
+      if( line.empty() || line[ 0 ] == '#' )
+      {
+        continue;
+      }
+      std::replace( line.begin(), line.end(), ',', ' ' );
+      std::istringstream values( line );
+      for( int i = 0; i < NUM_SPLIT_FEATURES; i++ )
+      {
+        values >> m_weights[ cls ][ i ];
+      }
+      CHECK( values.fail(), "split model file " << encCfg.m_SplitModelFile << ": expected " << NUM_SPLIT_FEATURES << " weights per line" );
+      cls++;
+    }
+    CHECK( cls != NUM_SPLIT_CLASSES, "split model file " << encCfg.m_SplitModelFile << ": expected " << NUM_SPLIT_CLASSES << " lines of weights" );
+  }
+}
+
+void EncSplitModel::uninit()
+{
+  if( m_labels.empty() )
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock( s_dumpMutex );
+  std::ofstream file( m_dumpFileName, std::ios::app );
+  const float* sample = m_samples.data();
+  for( size_t n = 0; n < m_labels.size(); n++ )
+  {
+    for( int i = 1; i < NUM_SPLIT_FEATURES; i++ )
+    {
+      file << *sample++ << ",";
+    }
+    file << ( m_labels[ n ] >> 4 ) << "," << ( m_labels[ n ] & 15 ) << "\n";
+  }
+  m_samples.clear();
+  m_labels.clear();
+}
+
+void EncSplitModel::initDumpFile( const VVEncCfg& encCfg )
+{
+  if( encCfg.m_SplitModelDumpFile[0] == '\0' )
+  {
+    return;
+  }
+
+  std::ofstream file( encCfg.m_SplitModelDumpFile, std::ios::trunc );
+  CHECK( !file.is_open(), "cannot open split model dump file " << encCfg.m_SplitModelDumpFile );
+  file << "log2Area,log2Ratio,qp,cost,dist,skip,intra,cbf,neighDepth,mtDepth,tLayer,testedMask,bestSplit\n";
+}
+
+double EncSplitModel::probSplit( const PartSplit split, const SplitFeatures& features ) const
+{
+  const float* w = m_weights[ split - CU_QUAD_SPLIT ];
+  double z = 0.0;
+  for( int i = 0; i < NUM_SPLIT_FEATURES; i++ )
+  {
+    z += w[ i ] * features.f[ i ];
+  }
+  return 1.0 / ( 1.0 + exp( -z ) );
+}
+
+bool EncSplitModel::skipSplit( const PartSplit split, const SplitFeatures& features ) const
+{
+  return probSplit( split, features ) < m_threshold;
+}
+
+void EncSplitModel::addSample( const SplitFeatures& features, const unsigned testedMask, const PartSplit bestSplit )
+{
+  const unsigned bestClass = bestSplit == CU_DONT_SPLIT ? 0 : bestSplit - CU_QUAD_SPLIT + 1;
+  m_labels.push_back( uint16_t( ( testedMask << 4 ) | bestClass ) );
+  m_samples.insert( m_samples.end(), features.f + 1, features.f + NUM_SPLIT_FEATURES );
+}
+
+} // namespace vvenc
+
+//! \}
+
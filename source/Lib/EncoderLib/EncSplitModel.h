@@ -0,0 +1,123 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     EncSplitModel.h
+\brief    statistical early termination of the coding unit splits (header)
+*/
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/UnitPartitioner.h"
+
+#include <string>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+enum SplitFeature
+{
+  SF_BIAS = 0,
+  SF_LOG2_AREA,                           // log2 of the block size
+  SF_LOG2_RATIO,                          // log2 of width / height
+  SF_QP,                                  // slice QP / 64
+  SF_COST,                                // log2( 1 + best non-split cost in bits per sample )
+  SF_DIST,                                // log2( 1 + best non-split distortion per sample )
+  SF_SKIP,                                // best non-split mode is skip
+  SF_INTRA,                               // best non-split mode is intra
+  SF_CBF,                                 // best non-split mode has a residual
+  SF_NEIGH_DEPTH,                         // mean depth of the left and above coding units relative to the current depth
+  SF_MT_DEPTH,                            // multi-type tree depth
+  SF_TLAYER,                              // temporal layer
+  NUM_SPLIT_FEATURES
+};
+
+static const int NUM_SPLIT_CLASSES = CU_TRIV_SPLIT - CU_QUAD_SPLIT + 1;
+
+struct SplitFeatures
+{
+  float f[ NUM_SPLIT_FEATURES ];
+};
+
+// logistic model of the probability that a split gives the best rd-cost, one weight set per split type
+class EncSplitModel
+{
+public:
+  EncSplitModel() : m_threshold( 0.0 ), m_dump( false ) {}
+  ~EncSplitModel() { uninit(); }
+
+  void   init       ( const VVEncCfg& encCfg );
+  void   uninit     ();
+
+  bool   isActive   () const { return m_threshold > 0.0; }
+  bool   isDumping  () const { return m_dump; }
+  bool   skipSplit  ( const PartSplit split, const SplitFeatures& features ) const;
+  double probSplit  ( const PartSplit split, const SplitFeatures& features ) const;
+
+  // training data: features, tested split types and the split type chosen by the full search
+  void   addSample  ( const SplitFeatures& features, const unsigned testedMask, const PartSplit bestSplit );
+
+  static void initDumpFile( const VVEncCfg& encCfg );
+
+private:
+  double                m_threshold;
+  float                 m_weights[ NUM_SPLIT_CLASSES ][ NUM_SPLIT_FEATURES ];
+  bool                  m_dump;
+  std::string           m_dumpFileName;
+  std::vector<float>    m_samples;            // features without the bias
+  std::vector<uint16_t> m_labels;             // tested split types << 4 | best split type
+};
+
+} // namespace vvenc
+
+//! \}
+
@@ -202,6 +202,9 @@ InterSearch::InterSearch()
   , m_CABACEstimator              (nullptr)
   , m_CtxCache                    (nullptr)
   , m_pTempPel                    (nullptr)
+  , m_hpelRef                     { { nullptr, nullptr }, { nullptr, nullptr } }
+  , m_hpelTmp                     { nullptr, nullptr }
+  , m_hpelStride                  (0)
 {
   for (int i=0; i<MAX_NUM_REF_LIST_ADAPT_SR; i++)
   {
@@ -825,7 +828,7 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
   uiDistBest = m_pcEncCfg->m_fastSubPel ? uiDistBest : MAX_DISTORTION;
   uint32_t        uiDirecBest = 0;
 
-  Pel*  piRefPos;
+  const Pel* piRefPos;
   int iRefStride = pcPatternKey->width + 1;
   m_pcRdCost->setDistParam( m_cDistParam, *pcPatternKey, m_filteredBlock[0][0][0], iRefStride, m_lumaClpRng.bd, COMP_Y, 0, m_pcEncCfg->m_bUseHADME && bAllowUseOfHadamard );
 
@@ -864,7 +867,11 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
           break;
         }
 
-        if( 0 == i )
+        if( m_hpelRef[ 0 ][ 0 ] )
+        {
+          // taken from the half-sample planes of the reference picture
+        }
+        else if( 0 == i )
         {
           // split the prediction with funny widths into power-of-2 and +1 parts for the sake of SIMD speed-up
           m_if.filterHor( COMP_Y, srcPtr, srcStride, m_filteredBlockTmp[ 0 ][ 0 ], intStride, width, height + filterSize, 0 << MV_FRACTIONAL_BITS_DIFF, false, chFmt, clpRng, useAltHpelIf );
@@ -907,15 +914,26 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
 
     int horVal = cMvTest.hor * iFrac;
     int verVal = cMvTest.ver * iFrac;
-    piRefPos = m_filteredBlock[verVal & 3][horVal & 3][0];
 
-    if ( horVal == 2 && ( verVal & 1 ) == 0 )
+    if( m_hpelRef[ 0 ][ 0 ] && ( ( horVal | verVal ) & 1 ) == 0 )
     {
-      piRefPos += 1;
+      // integer and half-sample positions, the planes hold the sample at +1/2 of the given position
+      piRefPos = m_hpelRef[ ( verVal & 2 ) >> 1 ][ ( horVal & 2 ) >> 1 ] + ( verVal >> 2 ) * m_hpelStride + ( horVal >> 2 );
+      m_cDistParam.cur.stride = m_hpelStride;
     }
-    if ( ( horVal & 1 ) == 0 && verVal == 2 )
+    else
     {
-      piRefPos += iRefStride;
+      piRefPos = m_filteredBlock[verVal & 3][horVal & 3][0];
+
+      if ( horVal == 2 && ( verVal & 1 ) == 0 )
+      {
+        piRefPos += 1;
+      }
+      if ( ( horVal & 1 ) == 0 && verVal == 2 )
+      {
+        piRefPos += iRefStride;
+      }
+      m_cDistParam.cur.stride = iRefStride;
     }
     cMvTest = pcMvRefine[i];
     cMvTest += rcMvFrac;
@@ -2213,6 +2231,11 @@ void InterSearch::xPatternSearchFast( const CodingUnit& cu,
 {
   if( cu.cs->picture->useScME )
   {
+    if( m_pcEncCfg->m_HashME && xHashSearch( cu, refPicList, iRefIdxPred, cStruct, rcMv, ruiSAD ) )
+    {
+      return;
+    }
+
     switch ( m_motionEstimationSearchMethodSCC )
     {
       case 3: //VVENC_MESEARCH_DIAMOND_FAST:
@@ -2360,6 +2383,11 @@ void InterSearch::xTZSearch( const CodingUnit& cu,
     }
   }
 
+  if( m_pcEncCfg->m_bMCTFMvPred || m_pcEncCfg->m_LookAhead || cu.cs->picture->analysis.isValid() )
+  {
+    xTZSearchMctfMv( cu, refPicList, iRefIdxPred, cStruct );
+  }
+
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
@@ -2586,6 +2614,117 @@ void InterSearch::xTZSearch( const CodingUnit& cu,
 }
 
 
+void InterSearch::xTZSearchMctfMv( const CodingUnit& cu, RefPicList refPicList, int iRefIdxPred, TZSearchStruct& cStruct )
+{
+  // test the motion of the MCTF or lookahead pre-analysis at the block center as additional start point
+  const Position center = cu.lumaPos().offset( cu.lumaSize().width >> 1, cu.lumaSize().height >> 1 );
+  const int      refPoc = cu.slice->getRefPOC( refPicList, iRefIdxPred );
+
+  // the motion of a loaded analysis is tested in addition
+  Mv analysisMv;
+  if( cu.cs->picture->getAnalysisMv( center, refPoc, analysisMv ) )
+  {
+    clipMv( analysisMv, cu.lumaPos(), cu.lumaSize(), *cu.cs->pcv );
+    analysisMv.changePrecision( MV_PRECISION_INTERNAL, MV_PRECISION_INT );
+    if( analysisMv.hor != cStruct.iBestX || analysisMv.ver != cStruct.iBestY )
+    {
+      xTZSearchHelp( cStruct, analysisMv.hor, analysisMv.ver, 0, 0 );
+    }
+  }
+
+  if( !m_pcEncCfg->m_bMCTFMvPred && !m_pcEncCfg->m_LookAhead )
+  {
+    return;
+  }
+
+  Mv mctfMv;
+  if( !cu.cs->picture->getMctfMv( center, refPoc, mctfMv ) && !cu.cs->picture->getLookaheadMv( center, refPoc, mctfMv ) )
+  {
+    return;
+  }
+
+  clipMv( mctfMv, cu.lumaPos(), cu.lumaSize(), *cu.cs->pcv );
+  mctfMv.changePrecision( MV_PRECISION_INTERNAL, MV_PRECISION_INT );
+
+  if( mctfMv.hor != cStruct.iBestX || mctfMv.ver != cStruct.iBestY )
+  {
+    xTZSearchHelp( cStruct, mctfMv.hor, mctfMv.ver, 0, 0 );
+  }
+}
+
+bool InterSearch::xHashSearch( const CodingUnit& cu, RefPicList refPicList, int iRefIdxPred, TZSearchStruct& cStruct, Mv& rcMv, Distortion& ruiSAD )
+{
+  // blocks of the reference picture with an identical original are the motion candidates, only 8x8 keys are used for inter
+  const int roiWidth  = cu.lwidth();
+  const int roiHeight = cu.lheight();
+  if( cu.imv || roiWidth < BlockHashMap::MAX_HASH_BLK_SIZE || roiHeight < BlockHashMap::MAX_HASH_BLK_SIZE )
+  {
+    return false;
+  }
+
+  const BlockHashMap& hashMap = cu.slice->getRefPic( refPicList, iRefIdxPred )->blockHashMap;
+  if( hashMap.empty() )
+  {
+    return false;
+  }
+
+  Position keyPos;
+  uint32_t keyHash;
+  if( !BlockHashMap::getKeyBlock( cu.cs->getOrgBuf( cu.Y() ), BlockHashMap::MAX_HASH_BLK_SIZE, keyPos, keyHash ) )
+  {
+    return false;
+  }
+
+  const PreCalcValues& pcv = *cu.cs->pcv;
+  const int cuPelX         = cu.lx();
+  const int cuPelY         = cu.ly();
+  const auto bucket        = hashMap.getBucket( keyHash, BlockHashMap::MAX_HASH_BLK_SIZE );
+  m_pcRdCost->setDistParam( m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMP_Y, 0 );
+
+  Distortion bestCost  = MAX_DISTORTION;
+  int        numChecks = 0;
+  for( const BlockHashMap::Entry* e = bucket.first; e != bucket.second && numChecks < BlockHashMap::MAX_NUM_CHECKS; e++ )
+  {
+    if( e->hash != keyHash )
+    {
+      continue;
+    }
+
+    const int x = e->x - keyPos.x - cuPelX;
+    const int y = e->y - keyPos.y - cuPelY;
+    if( cuPelX + x < 0 || cuPelX + x + roiWidth > (int)pcv.lumaWidth || cuPelY + y < 0 || cuPelY + y + roiHeight > (int)pcv.lumaHeight )
+    {
+      continue;
+    }
+
+    const Distortion mvCost = m_pcRdCost->getCostOfVectorWithPredictor( x, y, cStruct.imvShift );
+    if( mvCost >= bestCost )
+    {
+      continue;
+    }
+
+    numChecks++;
+    m_cDistParam.cur.buf = cStruct.piRefY + y * cStruct.iRefStride + x;
+    const Distortion cost = m_cDistParam.distFunc( m_cDistParam ) + mvCost;
+    if( cost < bestCost )
+    {
+      bestCost = cost;
+      rcMv.set( x, y );
+    }
+  }
+
+  if( bestCost == MAX_DISTORTION )
+  {
+    return false;
+  }
+
+  cStruct.iBestX    = rcMv.hor;
+  cStruct.iBestY    = rcMv.ver;
+  cStruct.uiBestSad = bestCost;
+  ruiSAD            = bestCost - m_pcRdCost->getCostOfVectorWithPredictor( rcMv.hor, rcMv.ver, cStruct.imvShift );
+  return true;
+}
+
 void InterSearch::xTZSearchSelective( const CodingUnit& cu,
                                       RefPicList            refPicList,
                                       int                   iRefIdxPred,
@@ -2679,6 +2818,11 @@ void InterSearch::xTZSearchSelective( const CodingUnit& cu,
     }
   }
 
+  if( m_pcEncCfg->m_bMCTFMvPred || m_pcEncCfg->m_LookAhead || cu.cs->picture->analysis.isValid() )
+  {
+    xTZSearchMctfMv( cu, refPicList, iRefIdxPred, cStruct );
+  }
+
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
@@ -2875,9 +3019,28 @@ void InterSearch::xPatternSearchFracDIF(
   int         iOffset    = rcMvInt.hor + rcMvInt.ver * cStruct.iRefStride;
   CPelBuf cPatternRoi(cStruct.piRefY + iOffset, cStruct.iRefStride, *cStruct.pcPatternKey);
 
+  m_hpelRef[ 0 ][ 0 ] = nullptr;
+  if( m_pcEncCfg->m_bHalfPelRefCache && !cStruct.useAltHpelIf && !cu.cs->sps->wrapAroundEnabled )
+  {
+    const Picture*      refPic = cu.slice->getRefPic( refPicList, iRefIdx );
+    const HalfPelPlanes& hpel  = refPic->halfPelPlanes;
+    const Position      refPos = cu.lumaPos().offset( rcMvInt.hor, rcMvInt.ver );
+
+    // the quarter-sample filters need the intermediates of four rows above and below the block
+    hpel.fill( refPic->getRecoBuf( COMP_Y ), refPic->margin, cu.cs->pcv->maxCUSize, m_if, m_lumaClpRng, refPos.y - NTAPS_LUMA, refPos.y + cPatternRoi.height + NTAPS_LUMA );
+
+    m_hpelRef[ 0 ][ 0 ] = cPatternRoi.buf;
+    m_hpelRef[ 0 ][ 1 ] = hpel.getBuf( HPEL_HOR,     refPos );
+    m_hpelRef[ 1 ][ 0 ] = hpel.getBuf( HPEL_VER,     refPos );
+    m_hpelRef[ 1 ][ 1 ] = hpel.getBuf( HPEL_HOR_VER, refPos );
+    m_hpelTmp[ 0 ]      = hpel.getBuf( HPEL_TMP_INT, refPos.offset( -1, -( NTAPS_LUMA >> 1 ) ) );
+    m_hpelTmp[ 1 ]      = hpel.getBuf( HPEL_TMP_HOR, refPos.offset( -1, -( NTAPS_LUMA >> 1 ) ) );
+    m_hpelStride        = hpel.getStride();
+  }
+
   //  Half-pel refinement
   m_pcRdCost->setCostScale(1);
-  if( 0 == m_pcEncCfg->m_fastSubPel )
+  if( 0 == m_pcEncCfg->m_fastSubPel && !m_hpelRef[ 0 ][ 0 ] )
   {
     xExtDIFUpSamplingH( &cPatternRoi, cStruct.useAltHpelIf );
   }
@@ -3158,6 +3321,12 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef, int& patt
 
   int halfFilterSize = (filterSize>>1);
 
+  // horizontal intermediates of the half-sample stage, from the reference planes if available
+  const Pel* tmpInt    = m_hpelRef[ 0 ][ 0 ] ? m_hpelTmp[ 0 ] : m_filteredBlockTmp[ 0 ][ 0 ];
+  const Pel* tmpHor    = m_hpelRef[ 0 ][ 0 ] ? m_hpelTmp[ 1 ] : m_filteredBlockTmp[ 2 ][ 0 ];
+  const int  tmpStride = m_hpelRef[ 0 ][ 0 ] ? m_hpelStride  : intStride;
+  const Pel* tmpPtr;
+
   int extHeight = (halfPelRef.ver == 0) ? height + filterSize : height + filterSize-1;
 
   const ChromaFormat chFmt = m_currChromaFormat;
@@ -3284,33 +3453,33 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef, int& patt
     if( s_doInterpQ[ patternId ][ 6 ] )
     {
       // Generate @ 1,2
-      intPtr = m_filteredBlockTmp[ 2 ][ 0 ] + ( halfFilterSize - 1 ) * intStride;
+      tmpPtr = tmpHor + ( halfFilterSize - 1 ) * tmpStride;
       dstPtr = m_filteredBlock[ 1 ][ 2 ][ 0 ];
       if( halfPelRef.hor > 0 )
       {
-        intPtr += 1;
+        tmpPtr += 1;
       }
       if( halfPelRef.ver >= 0 )
       {
-        intPtr += intStride;
+        tmpPtr += tmpStride;
       }
-      m_if.filterVer( COMP_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng );
+      m_if.filterVer( COMP_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng );
     }
 
     if( s_doInterpQ[ patternId ][ 7 ] )
     {
       // Generate @ 3,2
-      intPtr = m_filteredBlockTmp[ 2 ][ 0 ] + ( halfFilterSize - 1 ) * intStride;
+      tmpPtr = tmpHor + ( halfFilterSize - 1 ) * tmpStride;
       dstPtr = m_filteredBlock[ 3 ][ 2 ][ 0 ];
       if( halfPelRef.hor > 0 )
       {
-        intPtr += 1;
+        tmpPtr += 1;
       }
       if( halfPelRef.ver > 0 )
       {
-        intPtr += intStride;
+        tmpPtr += tmpStride;
       }
-      m_if.filterVer( COMP_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng );
+      m_if.filterVer( COMP_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng );
     }
   }
   else
@@ -3318,25 +3487,25 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef, int& patt
     if( s_doInterpQ[ patternId ][ 0 ] )
     {
       // Generate @ 1,0
-      intPtr = m_filteredBlockTmp[ 0 ][ 0 ] + ( halfFilterSize - 1 ) * intStride + 1;
+      tmpPtr = tmpInt + ( halfFilterSize - 1 ) * tmpStride + 1;
       dstPtr = m_filteredBlock[ 1 ][ 0 ][ 0 ];
       if( halfPelRef.ver >= 0 )
       {
-        intPtr += intStride;
+        tmpPtr += tmpStride;
       }
-      m_if.filterVer( COMP_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng );
+      m_if.filterVer( COMP_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng );
     }
 
     if( s_doInterpQ[ patternId ][ 1 ] )
     {
       // Generate @ 3,0
-      intPtr = m_filteredBlockTmp[ 0 ][ 0 ] + ( halfFilterSize - 1 ) * intStride + 1;
+      tmpPtr = tmpInt + ( halfFilterSize - 1 ) * tmpStride + 1;
       dstPtr = m_filteredBlock[ 3 ][ 0 ][ 0 ];
       if( halfPelRef.ver > 0 )
       {
-        intPtr += intStride;
+        tmpPtr += tmpStride;
       }
-      m_if.filterVer( COMP_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng );
+      m_if.filterVer( COMP_Y, tmpPtr, tmpStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false, true, chFmt, clpRng );
     }
   }
 }
@@ -5995,6 +6164,21 @@ uint32_t InterSearch::xCalcAffineMVBits(CodingUnit& cu, Mv acMvTemp[3], Mv acMvP
 //! set adaptive search range based on poc difference
 void InterSearch::setSearchRange( const Slice* slice, const VVEncCfg& encCfg )
 {
+  // the search options may change between pictures (real-time speed control, reconfiguration)
+  m_bipredSearchRange               = encCfg.m_bipredSearchRange;
+  m_motionEstimationSearchMethod    = vvencMESearchMethod( encCfg.m_motionEstimationSearchMethod );
+  m_motionEstimationSearchMethodSCC = encCfg.m_motionEstimationSearchMethodSCC;
+
+  if( !encCfg.m_bUseASR )
+  {
+    for( uint32_t iDir = 0; iDir < MAX_NUM_REF_LIST_ADAPT_SR; iDir++ )
+    {
+      for( uint32_t iRefIdx = 0; iRefIdx < MAX_IDX_ADAPT_SR; iRefIdx++ )
+      {
+        m_aaiAdaptSR[iDir][iRefIdx] = encCfg.m_SearchRange;
+      }
+    }
+  }
   if( !encCfg.m_bUseASR || slice->isIRAP() )
   {
     return;
@@ -6101,9 +6285,7 @@ int InterSearch::xIBCSearchMVChromaRefine(CodingUnit& cu,
       width = roiWidth >> getComponentScaleX(ComponentID(ch), cu.chromaFormat);
       height = roiHeight >> getComponentScaleY(ComponentID(ch), cu.chromaFormat);
 
-      PelUnitBuf origBuf = cu.cs->getOrgBuf(allCompBlocks);
-      PelUnitBuf* pBuf = &origBuf;
-      CPelBuf  tmpPattern = pBuf->get(ComponentID(ch));
+      CPelBuf  tmpPattern = cu.cs->getOrgBuf(allCompBlocks.blocks[ComponentID(ch)]);
       pOrg = (Pel*)tmpPattern.buf;
 
       Picture* refPic = cu.slice->pic;
@@ -6468,6 +6650,79 @@ end:
 
 
 
+bool InterSearch::xHashSearchIBC( CodingUnit& cu, TZSearchStruct& cStruct, Mv& rcMv, Distortion& ruiCost )
+{
+  // blocks of the current picture with an identical original are the block vector candidates
+  const BlockHashMap& hashMap = cu.cs->picture->blockHashMap;
+  if( hashMap.empty() )
+  {
+    return false;
+  }
+
+  const int roiWidth  = cu.lwidth();
+  const int roiHeight = cu.lheight();
+  const int blkSize   = std::min( roiWidth, roiHeight ) >= BlockHashMap::MAX_HASH_BLK_SIZE ? BlockHashMap::MAX_HASH_BLK_SIZE : BlockHashMap::MIN_HASH_BLK_SIZE;
+
+  Position keyPos;
+  uint32_t keyHash;
+  if( !BlockHashMap::getKeyBlock( cu.cs->getOrgBuf( cu.Y() ), blkSize, keyPos, keyHash ) )
+  {
+    return false;
+  }
+
+  const int  picWidth  = cu.cs->slice->pps->picWidthInLumaSamples;
+  const int  picHeight = cu.cs->slice->pps->picHeightInLumaSamples;
+  const int  lcuWidth  = cu.cs->slice->sps->CTUSize;
+  const int  cuPelX    = cu.lx();
+  const int  cuPelY    = cu.ly();
+  const int  ctuPelY   = cuPelY & ~( lcuWidth - 1 );
+  const bool useAmvr   = cu.cs->sps->AMVR;
+  const auto bucket    = hashMap.getBucket( keyHash, blkSize );
+
+  Distortion bestCost  = MAX_DISTORTION;
+  int        numChecks = 0;
+  for( const BlockHashMap::Entry* e = bucket.first; e != bucket.second && numChecks < BlockHashMap::MAX_NUM_CHECKS; e++ )
+  {
+    // IBC references are restricted to the current CTU row
+    const int yRef = e->y - keyPos.y;
+    if( e->hash != keyHash || yRef < ctuPelY || yRef + roiHeight > ctuPelY + lcuWidth )
+    {
+      continue;
+    }
+
+    const int xBv = e->x - keyPos.x - cuPelX;
+    const int yBv = yRef - cuPelY;
+    if( ( !xBv && !yBv ) || cuPelX + xBv < 0 )
+    {
+      continue;
+    }
+
+    const Distortion bvCost = m_pcRdCost->getBvCostMultiplePredsIBC( xBv, yBv, useAmvr );
+    if( bvCost >= bestCost || !searchBvIBC( cu, cuPelX, cuPelY, roiWidth, roiHeight, picWidth, picHeight, xBv, yBv, lcuWidth ) )
+    {
+      continue;
+    }
+
+    numChecks++;
+    m_cDistParam.cur.buf = cStruct.piRefY + cStruct.iRefStride * yBv + xBv;
+    const Distortion cost = m_cDistParam.distFunc( m_cDistParam ) + bvCost;
+    if( cost < bestCost )
+    {
+      bestCost = cost;
+      rcMv.set( xBv, yBv );
+    }
+  }
+
+  if( bestCost == MAX_DISTORTION )
+  {
+    return false;
+  }
+
+  ruiCost = bestCost;
+  m_ctuRecord[cu.lumaPos()][cu.lumaSize()].bvRecord[rcMv] = ruiCost;
+  return true;
+}
+
 // based on xMotionEstimation
 void InterSearch::xIBCEstimation(CodingUnit& cu, PelUnitBuf& origBuf, Mv* pcMvPred, Mv& rcMv, Distortion& ruiCost )
 {
@@ -6509,6 +6764,12 @@ void InterSearch::xIBCEstimation(CodingUnit& cu, PelUnitBuf& origBuf, Mv* pcMvPr
   m_pcRdCost->setCostScale(0);
 
   m_pcRdCost->setDistParam(m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMP_Y, cStruct.subShiftMode);
+
+  if( m_pcEncCfg->m_HashME && xHashSearchIBC( cu, cStruct, rcMv, ruiCost ) )
+  {
+    return;
+  }
+
   bool buffered = false;
   if (m_pcEncCfg->m_IBCFastMethod)// IBC_FAST_METHOD_BUFFERBV
   {
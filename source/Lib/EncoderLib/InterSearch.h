@@ -385,6 +385,11 @@ protected:
   // Misc.
   Pel*              m_pTempPel;
 
+  // half-sample planes of the reference picture for the current fractional search, null if not used
+  const Pel*        m_hpelRef[2][2];                      // [ver][hor] half-sample offset
+  const Pel*        m_hpelTmp[2];                         // horizontal intermediates at integer and half-sample offset
+  int               m_hpelStride;
+
   // AMVP cost computation
   uint32_t          m_auiMVPIdxCost[AMVP_MAX_NUM_CANDS+1][AMVP_MAX_NUM_CANDS+1];
   Distortion        m_estMinDistSbt[NUMBER_SBT_MODE + 1]; // estimated minimum SSE value of the PU if using a SBT mode
@@ -527,6 +532,20 @@ private:
                                     const Mv* const       pIntegerMv2Nx2NPred
                                   );
 
+  void xTZSearchMctfMv            ( const CodingUnit&     cu,
+                                    RefPicList            refPicList,
+                                    int                   iRefIdxPred,
+                                    TZSearchStruct&       cStruct
+                                  );
+
+  bool xHashSearch                ( const CodingUnit&     cu,
+                                    RefPicList            refPicList,
+                                    int                   iRefIdxPred,
+                                    TZSearchStruct&       cStruct,
+                                    Mv&                   rcMv,
+                                    Distortion&           ruiSAD
+                                  );
+
   void xSetSearchRange            ( const CodingUnit&     cu,
                                     const Mv&             cMvPred,
                                     const int             iSrchRng,
@@ -621,6 +640,7 @@ private:
   uint64_t xGetSymbolFracBitsInter    ( CodingStructure &cs, Partitioner &partitioner );
   void  xSetIntraSearchRangeIBC       ( CodingUnit& pu, int iRoiWidth, int iRoiHeight, Mv& rcMvSrchRngLT, Mv& rcMvSrchRngRB);
   void  xIBCEstimation                ( CodingUnit& cu, PelUnitBuf& origBuf, Mv* pcMvPred, Mv& rcMv, Distortion& ruiCost );
+  bool  xHashSearchIBC                ( CodingUnit& cu, TZSearchStruct& cStruct, Mv& rcMv, Distortion& ruiCost );
   void  xIBCSearchMVCandUpdate        ( Distortion  uiSad, int x, int y, Distortion* uiSadBestCand, Mv* cMVCand);
   int   xIBCSearchMVChromaRefine      ( CodingUnit& cu, int iRoiWidth, int iRoiHeight, int cuPelX, int cuPelY, Distortion* uiSadBestCand, Mv* cMVCand);
   void  xIntraPatternSearchIBC        ( CodingUnit& pu, TZSearchStruct& cStruct, Mv& rcMv, Distortion& ruiCost, Mv* cMvSrchRngLT, Mv* cMvSrchRngRB, Mv* pcMvPred);
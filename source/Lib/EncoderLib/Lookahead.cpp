@@ -0,0 +1,419 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+
+/** \file     Lookahead.cpp
+\brief    low resolution pre-analysis of the input pictures
+*/
+
+#include "Lookahead.h"
+#include "Utilities/NoMallocThreadPool.h"
+
+#include "vvenc/vvencCfg.h"
+
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+Lookahead::Lookahead()
+  : m_encCfg    ( nullptr )
+  , m_threadPool( nullptr )
+  , m_bitDepth  ( 0 )
+  , m_curIdx    ( 0 )
+  , m_prevPoc   ( -1 )
+  , m_numCoarseX( 0 )
+  , m_numCoarseY( 0 )
+{
+}
+
+Lookahead::~Lookahead()
+{
+  uninit();
+}
+
+void Lookahead::init( const VVEncCfg& encCfg, NoMallocThreadPool* threadPool )
+{
+  m_encCfg     = &encCfg;
+  m_threadPool = threadPool;
+  m_bitDepth   = encCfg.m_internalBitDepth[ CH_L ];
+  m_curIdx     = 0;
+  m_prevPoc    = -1;
+
+  m_rdCost.create();
+
+  const int halfWidth  = encCfg.m_PadSourceWidth  >> 1;
+  const int halfHeight = encCfg.m_PadSourceHeight >> 1;
+  for( int i = 0; i < 2; i++ )
+  {
+    m_lowRes[ i ][ 0 ].create( CHROMA_400, Area( 0, 0, halfWidth,      halfHeight      ), 0, LA_MARGIN );
+    m_lowRes[ i ][ 1 ].create( CHROMA_400, Area( 0, 0, halfWidth >> 1, halfHeight >> 1 ), 0, LA_MARGIN );
+  }
+
+  m_numCoarseX = ( halfWidth  >> 1 ) / LA_BLK_SIZE;
+  m_numCoarseY = ( halfHeight >> 1 ) / LA_BLK_SIZE;
+  m_coarseMvs.assign( m_numCoarseX * m_numCoarseY, Mv() );
+  m_mvs.assign( ( halfWidth / LA_BLK_SIZE ) * ( halfHeight / LA_BLK_SIZE ), Mv() );
+}
+
+void Lookahead::uninit()
+{
+  for( int i = 0; i < 2; i++ )
+  {
+    m_lowRes[ i ][ 0 ].destroy();
+    m_lowRes[ i ][ 1 ].destroy();
+  }
+  m_coarseMvs.clear();
+  m_mvs.clear();
+  m_prevPoc = -1;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+void Lookahead::analyse( Picture& pic )
+{
+  m_curIdx = 1 - m_curIdx;
+  PelStorage& halfRes    = m_lowRes[ m_curIdx ][ 0 ];
+  PelStorage& quarterRes = m_lowRes[ m_curIdx ][ 1 ];
+  xDownsample( pic.getOrigBuf( COMP_Y ), halfRes );
+  xDownsample( halfRes.Y(),              quarterRes );
+
+  LookaheadStats& stats = pic.lookahead;
+  stats.reset();
+  stats.numBlkX = halfRes.Y().width  / LA_BLK_SIZE;
+  stats.numBlkY = halfRes.Y().height / LA_BLK_SIZE;
+  stats.intraCost.resize( stats.numBlkX * stats.numBlkY );
+  stats.interCost.resize( stats.numBlkX * stats.numBlkY );
+  stats.motion.blkSize = LA_BLK_SIZE << 1;
+  stats.motion.stride  = stats.numBlkX;
+  stats.motion.refPoc  = m_prevPoc >= 0 && m_prevPoc + 1 == pic.poc ? m_prevPoc : -1;
+  if( stats.motion.refPoc >= 0 )
+  {
+    stats.motion.mvs.resize( stats.numBlkX * stats.numBlkY );
+    xCoarseSearch();
+  }
+
+  std::vector<RowTask> rows( stats.numBlkY, RowTask{ this, &stats, 0, 0, 0, 0, 0 } );
+  for( int y = 0; y < stats.numBlkY; y++ )
+  {
+    rows[ y ].blkY = y;
+  }
+  if( m_threadPool && m_threadPool->numThreads() > 1 && stats.numBlkY > 1 )
+  {
+    WaitCounter taskCounter;
+
+    for( auto& row : rows )
+    {
+      static auto task = []( int, RowTask* t ) { t->la->xAnalyseRow( *t ); return true; };
+
+      m_threadPool->addBarrierTask<RowTask>( task, &row, &taskCounter );
+    }
+    taskCounter.wait();
+  }
+  else
+  {
+    for( auto& row : rows )
+    {
+      xAnalyseRow( row );
+    }
+  }
+
+  uint64_t sumSpatial  = 0;
+  uint64_t sumTemporal = 0;
+  for( const auto& row : rows )
+  {
+    stats.sumIntraCost += row.sumIntra;
+    stats.sumInterCost += row.sumInter;
+    sumSpatial         += row.sumSpatial;
+    sumTemporal        += row.sumTemporal;
+  }
+
+  const double numSamples = std::max( 1.0, double( stats.numBlkX * stats.numBlkY * LA_BLK_SIZE * LA_BLK_SIZE ) );
+  stats.spatialAct  = double( sumSpatial  ) / numSamples;
+  stats.temporalAct = double( sumTemporal ) / numSamples;
+  stats.isValid     = true;
+
+  m_prevPoc = pic.poc;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+void Lookahead::xDownsample( const CPelBuf& src, PelStorage& dst ) const
+{
+  PelBuf dstBuf = dst.Y();
+  const Pel* srcRow = src.buf;
+
+  for( int y = 0; y < dstBuf.height; y++, srcRow += 2 * src.stride )
+  {
+    const Pel* inRow      = srcRow;
+    const Pel* inRowBelow = srcRow + src.stride;
+    Pel*       target     = dstBuf.bufAt( 0, y );
+
+    for( int x = 0; x < dstBuf.width; x++ )
+    {
+      target[ x ] = ( inRow[ 2 * x ] + inRow[ 2 * x + 1 ] + inRowBelow[ 2 * x ] + inRowBelow[ 2 * x + 1 ] + 2 ) >> 2;
+    }
+  }
+  dst.extendBorderPel( LA_MARGIN );
+}
+
+void Lookahead::xCoarseSearch()
+{
+  const CPelBuf cur = m_lowRes[     m_curIdx ][ 1 ].Y();
+  const CPelBuf ref = m_lowRes[ 1 - m_curIdx ][ 1 ].Y();
+
+  // raster order, the entry of the previous picture at the current position is read before it is replaced
+  for( int by = 0; by < m_numCoarseY; by++ )
+  {
+    for( int bx = 0; bx < m_numCoarseX; bx++ )
+    {
+      Mv  cands[ 5 ];
+      int numCands = 0;
+      cands[ numCands++ ] = Mv();
+      cands[ numCands++ ] = m_coarseMvs[ by * m_numCoarseX + bx ];
+      if( bx > 0 )                                cands[ numCands++ ] = m_coarseMvs[ by * m_numCoarseX + bx - 1 ];
+      if( by > 0 )                                cands[ numCands++ ] = m_coarseMvs[ ( by - 1 ) * m_numCoarseX + bx ];
+      if( by > 0 && bx + 1 < m_numCoarseX )       cands[ numCands++ ] = m_coarseMvs[ ( by - 1 ) * m_numCoarseX + bx + 1 ];
+
+      Distortion sad;
+      m_coarseMvs[ by * m_numCoarseX + bx ] = xMotionSearch( cur, ref, bx * LA_BLK_SIZE, by * LA_BLK_SIZE, cands, numCands, sad );
+    }
+  }
+}
+
+void Lookahead::xAnalyseRow( RowTask& t )
+{
+  LookaheadStats& stats = *t.stats;
+  const CPelBuf cur     = m_lowRes[     m_curIdx ][ 0 ].Y();
+  const CPelBuf ref     = m_lowRes[ 1 - m_curIdx ][ 0 ].Y();
+  const bool    hasRef  = stats.motion.refPoc >= 0;
+  const int     y       = t.blkY * LA_BLK_SIZE;
+
+  for( int blkX = 0; blkX < stats.numBlkX; blkX++ )
+  {
+    const int x   = blkX * LA_BLK_SIZE;
+    const int idx = t.blkY * stats.numBlkX + blkX;
+
+    // spatial activity, Laplacian high-pass
+    for( int j = 0; j < LA_BLK_SIZE; j++ )
+    {
+      const Pel* p = cur.bufAt( x, y + j );
+      for( int i = 0; i < LA_BLK_SIZE; i++ )
+      {
+        t.sumSpatial += abs( 4 * p[ i ] - p[ i - 1 ] - p[ i + 1 ] - p[ i - cur.stride ] - p[ i + cur.stride ] );
+      }
+    }
+
+    const uint32_t intraCost = xIntraCost( cur, x, y );
+    uint32_t       interCost = intraCost;
+
+    if( hasRef )
+    {
+      const int cx = std::min( blkX >> 1, m_numCoarseX - 1 );
+      const int cy = std::min( t.blkY >> 1, m_numCoarseY - 1 );
+
+      Mv  cands[ 4 ];
+      int numCands = 0;
+      cands[ numCands++ ] = Mv();
+      if( cx >= 0 && cy >= 0 ) cands[ numCands++ ] = Mv( m_coarseMvs[ cy * m_numCoarseX + cx ].hor * 2, m_coarseMvs[ cy * m_numCoarseX + cx ].ver * 2 );
+      cands[ numCands++ ] = m_mvs[ idx ];
+      if( blkX > 0 )           cands[ numCands++ ] = m_mvs[ idx - 1 ];
+
+      Distortion sad;
+      const Mv mv = xMotionSearch( cur, ref, x, y, cands, numCands, sad );
+      m_mvs[ idx ] = mv;
+      stats.motion.mvs[ idx ].set( mv.hor << ( 1 + MV_FRACTIONAL_BITS_INTERNAL ), mv.ver << ( 1 + MV_FRACTIONAL_BITS_INTERNAL ) );
+
+      const CPelBuf curBlk( cur.bufAt( x, y ), cur.stride, LA_BLK_SIZE, LA_BLK_SIZE );
+      const CPelBuf refBlk( ref.bufAt( x + mv.hor, y + mv.ver ), ref.stride, LA_BLK_SIZE, LA_BLK_SIZE );
+      DistParam dp = m_rdCost.setDistParam( curBlk, refBlk, m_bitDepth, DF_HAD );
+      interCost    = (uint32_t) dp.distFunc( dp );
+
+      const CPelBuf colBlk( ref.bufAt( x, y ), ref.stride, LA_BLK_SIZE, LA_BLK_SIZE );
+      DistParam dpCol = m_rdCost.setDistParam( curBlk, colBlk, m_bitDepth, DF_SAD );
+      t.sumTemporal  += dpCol.distFunc( dpCol );
+    }
+
+    stats.intraCost[ idx ] = intraCost;
+    stats.interCost[ idx ] = interCost;
+    t.sumIntra += intraCost;
+    t.sumInter += std::min( intraCost, interCost );
+  }
+}
+
+uint32_t Lookahead::xIntraCost( const CPelBuf& cur, int x, int y )
+{
+  // best of DC, horizontal and vertical prediction from the neighbouring low resolution samples
+  const bool hasLeft  = x > 0;
+  const bool hasAbove = y > 0;
+  const CPelBuf curBlk( cur.bufAt( x, y ), cur.stride, LA_BLK_SIZE, LA_BLK_SIZE );
+
+  Pel pred[ LA_BLK_SIZE * LA_BLK_SIZE ];
+  const CPelBuf predBlk( pred, LA_BLK_SIZE, LA_BLK_SIZE, LA_BLK_SIZE );
+  DistParam dp = m_rdCost.setDistParam( curBlk, predBlk, m_bitDepth, DF_HAD );
+
+  int sum = 0;
+  int num = 0;
+  for( int i = 0; i < LA_BLK_SIZE; i++ )
+  {
+    if( hasLeft )  { sum += cur.at( x - 1, y + i ); num++; }
+    if( hasAbove ) { sum += cur.at( x + i, y - 1 ); num++; }
+  }
+  const Pel dc = num ? Pel( ( sum + ( num >> 1 ) ) / num ) : Pel( 1 << ( m_bitDepth - 1 ) );
+  std::fill( pred, pred + LA_BLK_SIZE * LA_BLK_SIZE, dc );
+  Distortion cost = dp.distFunc( dp );
+
+  if( hasLeft )
+  {
+    for( int j = 0; j < LA_BLK_SIZE; j++ )
+    {
+      std::fill( pred + j * LA_BLK_SIZE, pred + ( j + 1 ) * LA_BLK_SIZE, cur.at( x - 1, y + j ) );
+    }
+    cost = std::min( cost, dp.distFunc( dp ) );
+  }
+  if( hasAbove )
+  {
+    for( int j = 0; j < LA_BLK_SIZE; j++ )
+    {
+      memcpy( pred + j * LA_BLK_SIZE, cur.bufAt( x, y - 1 ), LA_BLK_SIZE * sizeof( Pel ) );
+    }
+    cost = std::min( cost, dp.distFunc( dp ) );
+  }
+  return (uint32_t) cost;
+}
+
+Mv Lookahead::xMotionSearch( const CPelBuf& cur, const CPelBuf& ref, int x, int y, const Mv* cands, int numCands, Distortion& sad )
+{
+  // the block has to stay within the padded reference
+  const int minX = -LA_MARGIN - x;
+  const int maxX = ref.width  + LA_MARGIN - LA_BLK_SIZE - x;
+  const int minY = -LA_MARGIN - y;
+  const int maxY = ref.height + LA_MARGIN - LA_BLK_SIZE - y;
+
+  const CPelBuf curBlk( cur.bufAt( x, y ), cur.stride, LA_BLK_SIZE, LA_BLK_SIZE );
+  DistParam dp = m_rdCost.setDistParam( curBlk, CPelBuf( ref.bufAt( x, y ), ref.stride, LA_BLK_SIZE, LA_BLK_SIZE ), m_bitDepth, DF_SAD );
+
+  auto getSad = [&]( const Mv& mv )
+  {
+    dp.cur.buf = ref.bufAt( x + mv.hor, y + mv.ver );
+    return dp.distFunc( dp );
+  };
+
+  Mv best;
+  sad = MAX_DISTORTION;
+  for( int i = 0; i < numCands; i++ )
+  {
+    const Mv cand( Clip3( minX, maxX, cands[ i ].hor ), Clip3( minY, maxY, cands[ i ].ver ) );
+    if( i > 0 && cand == best )
+    {
+      continue;
+    }
+    const Distortion candSad = getSad( cand );
+    if( candSad < sad )
+    {
+      sad  = candSad;
+      best = cand;
+    }
+  }
+
+  // small diamond refinement followed by the diagonal neighbours
+  static const int diamond[ 4 ][ 2 ] = { { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 } };
+  static const int square [ 4 ][ 2 ] = { { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+  for( int iter = 0; iter < 2 * LA_MARGIN; iter++ )
+  {
+    const Mv center = best;
+    for( int i = 0; i < 4; i++ )
+    {
+      const Mv cand( center.hor + diamond[ i ][ 0 ], center.ver + diamond[ i ][ 1 ] );
+      if( cand.hor < minX || cand.hor > maxX || cand.ver < minY || cand.ver > maxY )
+      {
+        continue;
+      }
+      const Distortion candSad = getSad( cand );
+      if( candSad < sad )
+      {
+        sad  = candSad;
+        best = cand;
+      }
+    }
+    if( best == center )
+    {
+      break;
+    }
+  }
+
+  const Mv center = best;
+  for( int i = 0; i < 4; i++ )
+  {
+    const Mv cand( center.hor + square[ i ][ 0 ], center.ver + square[ i ][ 1 ] );
+    if( cand.hor < minX || cand.hor > maxX || cand.ver < minY || cand.ver > maxY )
+    {
+      continue;
+    }
+    const Distortion candSad = getSad( cand );
+    if( candSad < sad )
+    {
+      sad  = candSad;
+      best = cand;
+    }
+  }
+
+  return best;
+}
+
+} // namespace vvenc
+
+//! \}
+
@@ -0,0 +1,118 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     Lookahead.h
+\brief    low resolution pre-analysis of the input pictures (header)
+*/
+
+#pragma once
+
+#include "CommonLib/Picture.h"
+#include "CommonLib/RdCost.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+class NoMallocThreadPool;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// analyses every input picture once on a downscaled pyramid and publishes the results in Picture::lookahead
+class Lookahead
+{
+public:
+  static const int LA_BLK_SIZE = 8;    // block size on the half resolution level, covers 16x16 full resolution samples
+  static const int LA_MARGIN   = 16;   // padding of the low resolution planes, limits the motion range beyond the picture border
+
+public:
+  Lookahead();
+  ~Lookahead();
+
+  void init  ( const VVEncCfg& encCfg, NoMallocThreadPool* threadPool );
+  void uninit();
+
+  // has to be called in input order, the previous analysed picture is the motion reference
+  void analyse( Picture& pic );
+
+private:
+  struct RowTask
+  {
+    Lookahead*      la;
+    LookaheadStats* stats;
+    int             blkY;
+    uint64_t        sumIntra;
+    uint64_t        sumInter;
+    uint64_t        sumSpatial;
+    uint64_t        sumTemporal;
+  };
+
+  void     xDownsample     ( const CPelBuf& src, PelStorage& dst ) const;
+  void     xCoarseSearch   ();
+  void     xAnalyseRow     ( RowTask& t );
+  uint32_t xIntraCost      ( const CPelBuf& cur, int x, int y );
+  Mv       xMotionSearch   ( const CPelBuf& cur, const CPelBuf& ref, int x, int y, const Mv* cands, int numCands, Distortion& sad );
+
+private:
+  const VVEncCfg*       m_encCfg;
+  NoMallocThreadPool*   m_threadPool;
+  RdCost                m_rdCost;
+  int                   m_bitDepth;
+  PelStorage            m_lowRes[ 2 ][ 2 ];   // [current, previous][half, quarter resolution]
+  int                   m_curIdx;
+  int                   m_prevPoc;
+  int                   m_numCoarseX;
+  int                   m_numCoarseY;
+  std::vector<Mv>       m_coarseMvs;          // quarter resolution motion, holds the previous picture until overwritten
+  std::vector<Mv>       m_mvs;                // half resolution motion, holds the previous picture until overwritten
+};
+
+} // namespace vvenc
+
+//! \}
+
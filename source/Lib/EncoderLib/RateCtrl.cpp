@@ -52,6 +52,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include "CommonLib/Picture.h"
 
 #include <cmath>
+#include <fstream>
 
 namespace vvenc {
 
@@ -68,6 +69,15 @@ static const double RC_ALPHA_MIN_VALUE =                            0.05;
 static const double RC_ALPHA_MAX_VALUE =                           500.0;
 static const double RC_BETA_MIN_VALUE =                             -3.0;
 static const double RC_BETA_MAX_VALUE =                             -0.1;
+static const char   RC_STATS_FILE_MAGIC[4] =                         { 'V', 'V', 'R', 'C' };
+static const uint32_t RC_STATS_FILE_VERSION =                          1;
+static const double RC_LA_BITS_PER_BLOCK =                          0.44;  // header and skip overhead per 16x16 luma block
+static const double RC_LA_INTRA_SCALE =                            0.74;  // bits per unit of block SATD / quantizer step size
+static const double RC_LA_INTER_SCALE =                            0.12;
+static const double RC_LA_INTER_DEADZONE =                          3.5;  // inter SATD / step size below which a block is assumed skipped
+static const double RC_LA_DIST_EXPONENT =                          0.28;  // growth of the inter cost with the reference distance
+static const double RC_LA_SPATIAL_ACT_SCALE =                       4.7;  // low resolution to QPA activity mapping
+static const double RC_LA_TEMPORAL_ACT_SCALE =                      3.1;
 static const double RC_ALPHA =                                    6.7542;
 static const double RC_BETA1 =                                    1.2517;
 static const double RC_BETA2 =                                    1.7860;
@@ -234,15 +244,33 @@ void EncRCSeq::initPicPara( TRCParameter* picPara )
   }
 }
 
-void EncRCSeq::updateAfterPic ( int bits, int tgtBits )
+void EncRCSeq::updateBeforePic ( int estBits, int tgtBits )
 {
   estimatedBitUsage += tgtBits;
-  bitsUsed += bits;
+  bitsUsed += estBits;
   framesCoded++;
-  bitsLeft -= bits;
+  bitsLeft -= estBits;
   framesLeft--;
 }
 
+void EncRCSeq::updateAfterPic ( int bits, int estBits )
+{
+  bitsUsed += bits - estBits;
+  bitsLeft -= bits - estBits;
+}
+
+void EncRCSeq::setTargetRate( int targetBitrate )
+{
+  // rescale the budget of the remaining frames, the over/underspent bits are kept relative to the target rate
+  if( totalFrames > 0 && targetRate > 0 )
+  {
+    bitsLeft   = (int64_t)( (double)bitsLeft * targetBitrate / targetRate + 0.5 );
+    targetBits = bitsUsed + bitsLeft;
+  }
+  targetRate  = targetBitrate;
+  averageBits = (int)( targetRate / frameRate );
+}
+
 void EncRCSeq::getTargetBitsFromFirstPass (const int poc, int &targetBits, double &frameVsGopRatio, bool &isNewScene, bool &refreshParameters)
 {
   std::list<TRCPassStats>::iterator it;
@@ -285,6 +313,7 @@ EncRCGOP::EncRCGOP()
   targetBits         = 0;
   picsLeft           = 0;
   bitsLeft           = 0;
+  picsPending        = 0;
   minEstLambda       = 0.0;
   maxEstLambda       = 0.0;
 }
@@ -555,10 +584,17 @@ double EncRCGOP::xSolveEqua( EncRCSeq* encRCSeq, double targetBpp, double* equaC
   return solution;
 }
 
-void EncRCGOP::updateAfterPicture( int bitsCost )
+void EncRCGOP::updateBeforePicture( int estBits )
 {
-  bitsLeft -= bitsCost;
+  bitsLeft -= estBits;
   picsLeft--;
+  picsPending++;
+}
+
+void EncRCGOP::updateAfterPicture( int bitsCost, int estBits )
+{
+  bitsLeft -= bitsCost - estBits;
+  picsPending--;
 }
 
 int EncRCGOP::xEstGOPTargetBits( EncRCSeq* encRCSeq, int GOPSize )
@@ -604,6 +640,7 @@ EncRCPic::EncRCPic()
   refreshParams       = false;
   finalLambda         = 0.0;
   estimatedBits       = 0;
+  predictedBits       = 0;
 }
 
 EncRCPic::~EncRCPic()
@@ -979,6 +1016,30 @@ void EncRCPic::updateAfterCTU( int LCUIdx, int bits, double lambda )
   bitsLeft -= bits;
 }
 
+void EncRCPic::updateBeforePicture( int estimatedQP, double estimatedLambda, bool isIRAP )
+{
+  // use the estimated values as history for the following pictures, until the picture is finished
+  picActualHeaderBits = estHeaderBits;
+  picLambda           = estimatedLambda;
+  picQP               = estimatedQP;
+
+  // account the target bits, scaled by the ratio of actual to target bits of previous pictures of the same level, until
+  // the actual bits are known after encoding, such that pictures encoded in parallel get their bits from the remaining budget.
+  // in 2-pass RC, the first-pass allocation is accounted, so that pictures in flight don't affect the over/underspent bits
+  predictedBits = targetBits;
+  if ( encRCSeq->twoPass )
+  {
+    predictedBits = tmpTargetBits;
+  }
+  else if ( frameLevel <= 7 && encRCSeq->actualBitCnt[ frameLevel ] > 0 && encRCSeq->targetBitCnt[ frameLevel ] > 0 )
+  {
+    predictedBits = int( 0.5 + (double)targetBits * (double)encRCSeq->actualBitCnt[ frameLevel ] / (double)encRCSeq->targetBitCnt[ frameLevel ] );
+  }
+  encRCSeq->updateBeforePic( predictedBits, tmpTargetBits );
+  // for intra picture, the estimated bits are used to update the current status in the GOP
+  encRCGOP->updateBeforePicture( isIRAP ? estimatedBits : predictedBits );
+}
+
 void EncRCPic::calPicMSE()
 {
   double totalSSE = 0.0;
@@ -1071,6 +1132,17 @@ void EncRCPic::updateAfterPicture( int actualHeaderBits, int actualTotalBits, do
     encRCSeq->qpCorrection[frameLevel] = (refreshed ? 1.0 : 6.0) * log ((double) encRCSeq->actualBitCnt[frameLevel] / (double) encRCSeq->targetBitCnt[frameLevel]) / log (2.0);
     encRCSeq->qpCorrection[frameLevel] = Clip3 (-12.0, 12.0, encRCSeq->qpCorrection[frameLevel]);
   }
+
+  // replace the predicted by the actual bits
+  encRCSeq->updateAfterPic( picActualBits, predictedBits );
+  if ( isIRAP )
+  {
+    encRCGOP->updateAfterPicture( estimatedBits, estimatedBits );
+  }
+  else
+  {
+    encRCGOP->updateAfterPicture( picActualBits, predictedBits );
+  }
 }
 
 void EncRCPic::clipRcBeta( double& beta)
@@ -1114,6 +1186,7 @@ RateCtrl::RateCtrl()
   rcPass        = 0;
   rcMaxPass     = 0;
   rcIsFinalPass = true;
+  firstPassBaseQP = 0;
 }
 
 RateCtrl::~RateCtrl()
@@ -1128,11 +1201,7 @@ void RateCtrl::destroy()
     delete encRCSeq;
     encRCSeq = NULL;
   }
-  if ( encRCGOP != NULL )
-  {
-    delete encRCGOP;
-    encRCGOP = NULL;
-  }
+  destroyRCGOP();
   while ( m_listRCPictures.size() > 0 )
   {
     EncRCPic* p = m_listRCPictures.front();
@@ -1204,6 +1273,16 @@ void RateCtrl::init( int totalFrames, int targetBitrate, int frameRate, int intr
 
     adaptiveBit = 1;
   }
+  else if ( GOPSize == 8 && isLowdelay )
+  {
+    // every second picture and the last picture of the GOP are coded with a lower QP offset
+    static const int init[ 4 ][ 8 ] = { { 2, 3, 2, 3, 2, 3, 2,  6 },
+                                        { 2, 3, 2, 3, 2, 3, 2, 10 },
+                                        { 2, 3, 2, 3, 2, 3, 2, 12 },
+                                        { 2, 3, 2, 3, 2, 3, 2, 14 } };
+    const int cls = bpp > 0.2 ? 0 : ( bpp > 0.1 ? 1 : ( bpp > 0.05 ? 2 : 3 ) );
+    std::copy_n( init[ cls ], 8, bitsRatio );
+  }
   else if ( GOPSize == 8 && !isLowdelay )
   {
     if ( bpp > 0.2 )
@@ -1302,6 +1381,10 @@ void RateCtrl::init( int totalFrames, int targetBitrate, int frameRate, int intr
     static const int init[] = { 3, 2, 3, 1 };
     std::copy_n( init, 4, GOPID2Level );
   }
+  else if ( GOPSize == 8 && isLowdelay )
+  {
+    std::fill_n( GOPID2Level, 8, 1 ); // all inter pictures share one level (temporal layer 0)
+  }
   else if ( GOPSize == 8 && !isLowdelay )
   {
     static const int init[] = { 1, 2, 3, 4, 4, 3, 4, 4 };
@@ -1324,21 +1407,47 @@ void RateCtrl::init( int totalFrames, int targetBitrate, int frameRate, int intr
   encRCSeq->initGOPID2Level( GOPID2Level );
   encRCSeq->bitDepth = bitDepth;
   if (rcMaxPass <= 0) encRCSeq->initPicPara();
-  encRCSeq->fppParFrames = maxParallelFrames;
+  encRCSeq->fppParFrames = std::min( maxParallelFrames, 4 ); // widen lambda/QP clipping for parallel frames, limited to avoid oscillation
 
   delete[] bitsRatio;
   delete[] GOPID2Level;
 }
 
-void RateCtrl::initRCGOP (const int numberOfPictures)
+void RateCtrl::addRCGOP (const int numberOfPictures)
+{
+  m_listRCGOPSizes.push_back (numberOfPictures);
+}
+
+void RateCtrl::initRCGOP()
 {
+  CHECK (m_listRCGOPSizes.empty(), "size of rate control GOP unknown");
+
+  // GOPs of pictures still being encoded are kept until these pictures are finished
+  for (auto it = m_listRCGOPs.begin(); it != m_listRCGOPs.end(); )
+  {
+    if ((*it)->picsPending > 0)
+    {
+      it++;
+      continue;
+    }
+    delete *it;
+    it = m_listRCGOPs.erase (it);
+  }
+
   encRCGOP = new EncRCGOP;
-  encRCGOP->create (encRCSeq, numberOfPictures);
+  encRCGOP->create (encRCSeq, m_listRCGOPSizes.front());
+  m_listRCGOPs.push_back (encRCGOP);
+  m_listRCGOPSizes.pop_front();
 }
 
 void RateCtrl::destroyRCGOP()
 {
-  delete encRCGOP;
+  for (auto gop : m_listRCGOPs)
+  {
+    delete gop;
+  }
+  m_listRCGOPs.clear();
+  m_listRCGOPSizes.clear();
   encRCGOP = NULL;
 }
 
@@ -1365,6 +1474,92 @@ void RateCtrl::processFirstPassData (const int secondPassBaseQP)
   adaptToSceneChanges();
 }
 
+// the statistics file stores the sequence parameters the statistics depend on, followed by the per-picture
+// first pass statistics and the intra QPA pumping reduction data, all in native byte order
+template<typename T> static inline void writeStatsValue (std::ofstream& file, const T value)
+{
+  file.write (reinterpret_cast<const char*> (&value), sizeof (T));
+}
+
+template<typename T> static inline T readStatsValue (std::ifstream& file)
+{
+  T value = T (0);
+  file.read (reinterpret_cast<char*> (&value), sizeof (T));
+  return value;
+}
+
+void RateCtrl::writeStatsFile (const std::string& fileName, const VVEncCfg& encCfg) const
+{
+  std::ofstream file (fileName, std::ios::binary | std::ios::trunc);
+  CHECK (!file.is_open(), "cannot open rate control statistics file " << fileName << " for writing");
+
+  const int32_t header[] = { encCfg.m_SourceWidth, encCfg.m_SourceHeight, encCfg.m_FrameRate, (int32_t) encCfg.m_temporalSubsampleRatio,
+                             encCfg.m_GOPSize, encCfg.m_IntraPeriod, encCfg.m_internalBitDepth[CH_L], firstPassBaseQP };
+
+  file.write (RC_STATS_FILE_MAGIC, sizeof (RC_STATS_FILE_MAGIC));
+  writeStatsValue<uint32_t> (file, RC_STATS_FILE_VERSION);
+  file.write (reinterpret_cast<const char*> (header), sizeof (header));
+  writeStatsValue<uint32_t> (file, (uint32_t) m_listRCFirstPassStats.size());
+  writeStatsValue<uint32_t> (file, (uint32_t) m_listRCIntraPQPAStats.size());
+
+  for (const TRCPassStats& stats : m_listRCFirstPassStats)
+  {
+    writeStatsValue<int32_t>  (file, stats.poc);
+    writeStatsValue<int32_t>  (file, stats.qp);
+    writeStatsValue<double>   (file, stats.lambda);
+    writeStatsValue<uint16_t> (file, stats.visActY);
+    writeStatsValue<uint32_t> (file, stats.numBits);
+    writeStatsValue<double>   (file, stats.psnrY);
+    writeStatsValue<uint8_t>  (file, stats.isIntra ? 1 : 0);
+    writeStatsValue<int32_t>  (file, stats.tempLayer - int (!stats.isIntra));
+  }
+  file.write (reinterpret_cast<const char*> (m_listRCIntraPQPAStats.data()), m_listRCIntraPQPAStats.size());
+
+  CHECK (!file.good(), "failed to write rate control statistics file " << fileName);
+}
+
+void RateCtrl::readStatsFile (const std::string& fileName, const VVEncCfg& encCfg)
+{
+  std::ifstream file (fileName, std::ios::binary);
+  CHECK (!file.is_open(), "cannot open rate control statistics file " << fileName);
+
+  // compare the header against the one of the current configuration, with the base QP taken from the file
+  char magic[sizeof (RC_STATS_FILE_MAGIC)];
+  file.read (magic, sizeof (magic));
+  CHECK (!file.good() || !std::equal (magic, magic + sizeof (magic), RC_STATS_FILE_MAGIC), "not a rate control statistics file: " << fileName);
+  const uint32_t version = readStatsValue<uint32_t> (file);
+  CHECK (version != RC_STATS_FILE_VERSION, "unsupported rate control statistics file version " << version << ", expected " << RC_STATS_FILE_VERSION);
+
+  int32_t header[8];
+  file.read (reinterpret_cast<char*> (header), sizeof (header));
+  const int32_t expected[] = { encCfg.m_SourceWidth, encCfg.m_SourceHeight, encCfg.m_FrameRate, (int32_t) encCfg.m_temporalSubsampleRatio,
+                               encCfg.m_GOPSize, encCfg.m_IntraPeriod, encCfg.m_internalBitDepth[CH_L] };
+  CHECK (!file.good() || !std::equal (expected, expected + 7, header), "rate control statistics file " << fileName << " does not match the sequence (size, frame rate, GOP or bit depth)");
+
+  const uint32_t numStats = readStatsValue<uint32_t> (file);
+  const uint32_t numPQPA  = readStatsValue<uint32_t> (file);
+
+  m_listRCFirstPassStats.clear();
+  for (uint32_t i = 0; i < numStats && file.good(); i++)
+  {
+    const int      poc       = readStatsValue<int32_t>  (file);
+    const int      qp        = readStatsValue<int32_t>  (file);
+    const double   lambda    = readStatsValue<double>   (file);
+    const uint16_t visActY   = readStatsValue<uint16_t> (file);
+    const uint32_t numBits   = readStatsValue<uint32_t> (file);
+    const double   psnrY     = readStatsValue<double>   (file);
+    const bool     isIntra   = readStatsValue<uint8_t>  (file) != 0;
+    const int      tempLayer = readStatsValue<int32_t>  (file);
+
+    m_listRCFirstPassStats.push_back (TRCPassStats (poc, qp, lambda, visActY, numBits, psnrY, isIntra, tempLayer));
+  }
+  m_listRCIntraPQPAStats.resize (numPQPA);
+  file.read (reinterpret_cast<char*> (m_listRCIntraPQPAStats.data()), numPQPA);
+
+  CHECK (!file.good() || m_listRCFirstPassStats.empty(), "rate control statistics file " << fileName << " is truncated or empty");
+  firstPassBaseQP = header[7];
+}
+
 uint64_t RateCtrl::getTotalBitsInFirstPass()
 {
   uint64_t totalBitsFirstPass = 0;
@@ -1475,6 +1670,31 @@ void RateCtrl::addRCPassStats (const int poc, const int qp, const double lambda,
   }
 }
 
+void RateCtrl::addLookaheadPassStats (const Picture& pic, const int qp, const int refDist, const bool isIntra, const int tempLayer, const int bitDepth)
+{
+  // estimate the first pass statistics from the lookahead costs instead of encoding, the model constants are fitted to first pass encodings
+  const LookaheadStats& la = pic.lookahead;
+  CHECK( !la.isValid, "lookahead statistics missing" );
+
+  const double qStep    = pow (2.0, (qp - 4) / 6.0 + (bitDepth - 8));
+  const double distFact = pow ((double) std::max (1, refDist), RC_LA_DIST_EXPONENT);
+  const bool   hasInter = !isIntra && la.motion.refPoc >= 0;
+  double       bits     = RC_LA_BITS_PER_BLOCK * la.intraCost.size();
+
+  for (size_t i = 0; i < la.intraCost.size(); i++)
+  {
+    const double intraCost = la.intraCost[i] / qStep;
+    const double interCost = hasInter ? std::min (intraCost, la.interCost[i] * distFact / qStep) : intraCost;
+
+    bits += (isIntra ? RC_LA_INTRA_SCALE * intraCost : RC_LA_INTER_SCALE * std::max (0.0, interCost - RC_LA_INTER_DEADZONE));
+  }
+
+  const double visAct = RC_LA_SPATIAL_ACT_SCALE * la.spatialAct + RC_LA_TEMPORAL_ACT_SCALE * la.temporalAct;
+
+  addRCPassStats (pic.poc, qp, 0.0 /*derived from the slice QP in the final pass*/, ClipBD (uint16_t (0.5 + visAct), bitDepth),
+                  uint32_t (std::min (bits, double (MAX_UINT))), 0.0, isIntra, tempLayer);
+}
+
 static int xCalcHADs8x8_ISlice( const Pel *piOrg, const int iStrideOrg )
 {
   int k, i, j, jj;
@@ -59,6 +59,7 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <algorithm>
 #include <list>
+#include <string>
 
 namespace vvenc {
   struct Picture;
@@ -113,7 +114,9 @@ namespace vvenc {
     void initBitsRatio( int bitsRatio[] );
     void initGOPID2Level( int GOPID2Level[] );
     void initPicPara( TRCParameter* picPara = NULL );    // NULL to initial with default value
-    void updateAfterPic( int bits, int tgtBits );
+    void updateBeforePic( int estBits, int tgtBits );
+    void updateAfterPic( int bits, int estBits );
+    void setTargetRate( int targetBitrate );
     void setAllBitRatio( double basicLambda, double* equaCoeffA, double* equaCoeffB );
     int  getLeftAverageBits() { CHECK( !( framesLeft > 0 ), "No frames left" ); return (int)( bitsLeft / framesLeft ); }
     void getTargetBitsFromFirstPass (const int poc, int &targetBits, double &frameVsGopRatio, bool &isNewScene, bool &refreshParameters);
@@ -165,7 +168,8 @@ namespace vvenc {
 
     void create( EncRCSeq* encRCSeq, int numPic );
     void destroy();
-    void updateAfterPicture( int bitsCost );
+    void updateBeforePicture( int estBits );
+    void updateAfterPicture( int bitsCost, int estBits );
 
   private:
     int    xEstGOPTargetBits( EncRCSeq* encRCSeq, int GOPSize );
@@ -177,6 +181,7 @@ namespace vvenc {
     int     targetBits;
     int     picsLeft;
     int     bitsLeft;
+    int     picsPending;      // pictures started, but not yet finished
     int*    picTargetBitInGOP;
     double  minEstLambda;
     double  maxEstLambda;
@@ -204,10 +209,12 @@ namespace vvenc {
     void   clipLambdaFrameRc( std::list<EncRCPic*>& listPreviousPictures, double &lambda, int bitdepthLumaScale );
     void   updateAlphaBetaIntra( double& alpha, double& beta );
     void   updateAfterCTU( int LCUIdx, int bits, double lambda );
+    void   updateBeforePicture( int estimatedQP, double estimatedLambda, bool isIRAP );
     void   updateAfterPicture( int actualHeaderBits, int actualTotalBits, double averageQP, double averageLambda, bool isIRAP );
     void   clipRcBeta( double& beta );
     void   addToPictureList( std::list<EncRCPic*>& listPreviousPictures );
     void   calPicMSE();
+    const EncRCGOP* getRCGOP() const { return encRCGOP; }
 
   private:
     int xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel );
@@ -225,6 +232,7 @@ namespace vvenc {
     double  picLambdaOffsetQPA;
     double  finalLambda;
     int     estimatedBits;
+    int     predictedBits;          // accounted in sequence and GOP budget until the actual bits are known
   
   private:
     EncRCSeq* encRCSeq;
@@ -253,13 +261,17 @@ namespace vvenc {
     void init( int totFrames, int targetBitrate, int frameRate, int intraPeriod, int GOPSize, int picWidth, int picHeight,
                int LCUWidth, int LCUHeight, int bitDepth, const vvencGOPEntry GOPList[ VVENC_MAX_GOP ], int maxParallelFrames );
     void destroy();
-    void initRCGOP (const int numberOfPictures);
+    void addRCGOP (const int numberOfPictures);
+    void initRCGOP();
     void destroyRCGOP();
 
     void setRCPass (const int pass, const int maxPass);
     void addRCPassStats (const int poc, const int qp, const double lambda, const uint16_t visActY,
                          const uint32_t numBits, const double psnrY, const bool isIntra, const int tempLayer);
+    void addLookaheadPassStats (const Picture& pic, const int qp, const int refDist, const bool isIntra, const int tempLayer, const int bitDepth);
     void processFirstPassData (const int secondPassBaseQP);
+    void writeStatsFile (const std::string& fileName, const VVEncCfg& encCfg) const;
+    void readStatsFile (const std::string& fileName, const VVEncCfg& encCfg);
     void processGops (const int secondPassBaseQP);
     uint64_t getTotalBitsInFirstPass();
     void detectNewScene();
@@ -279,8 +291,11 @@ namespace vvenc {
     int         rcPass;
     int         rcMaxPass;
     bool        rcIsFinalPass;
+    int         firstPassBaseQP;
 
   private:
+    std::list<EncRCGOP*>    m_listRCGOPs;
+    std::list<int>          m_listRCGOPSizes;
     std::list<TRCPassStats> m_listRCFirstPassStats;
     std::vector<uint8_t>    m_listRCIntraPQPAStats;
   };
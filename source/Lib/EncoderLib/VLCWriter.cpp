@@ -298,7 +298,7 @@ void HLSWriter::codePPS( const PPS* pcPPS, const SPS* pcSPS )
   WRITE_FLAG( pcPPS->subPicIdMappingInPps,            "pps_subpic_id_mapping_in_pps_flag" );
   if( pcPPS->subPicIdMappingInPps )
   {
-    if( pcPPS->noPicPartition )
+    if( !pcPPS->noPicPartition )
     {
       WRITE_UVLC( pcPPS->numSubPics - 1,              "pps_num_subpics_minus1" );
     }
@@ -313,7 +313,70 @@ void HLSWriter::codePPS( const PPS* pcPPS, const SPS* pcSPS )
 
   if( !pcPPS->noPicPartition )
   {
-    THROW("no suppport");
+    WRITE_CODE( pcPPS->log2CtuSize - 5, 2,            "pps_log2_ctu_size_minus5" );
+    WRITE_UVLC( pcPPS->numExpTileCols - 1,            "pps_num_exp_tile_columns_minus1" );
+    WRITE_UVLC( pcPPS->numExpTileRows - 1,            "pps_num_exp_tile_rows_minus1" );
+    for( int colIdx = 0; colIdx < pcPPS->numExpTileCols; colIdx++ )
+    {
+      WRITE_UVLC( pcPPS->tileColWidth[ colIdx ] - 1,  "pps_tile_column_width_minus1[i]" );
+    }
+    for( int rowIdx = 0; rowIdx < pcPPS->numExpTileRows; rowIdx++ )
+    {
+      WRITE_UVLC( pcPPS->tileRowHeight[ rowIdx ] - 1, "pps_tile_row_height_minus1[i]" );
+    }
+
+    const uint32_t numTiles = pcPPS->numTileCols * pcPPS->numTileRows;
+    if( numTiles > 1 )
+    {
+      WRITE_FLAG( pcPPS->loopFilterAcrossTilesEnabled, "pps_loop_filter_across_tiles_enabled_flag" );
+      WRITE_FLAG( pcPPS->rectSlice,                    "pps_rect_slice_flag" );
+    }
+    CHECK( numTiles == 1 && !pcPPS->rectSlice, "pps_rect_slice_flag is inferred to be 1 for a single tile" );
+    if( pcPPS->rectSlice )
+    {
+      WRITE_FLAG( pcPPS->singleSlicePerSubPic,         "pps_single_slice_per_subpic_flag" );
+    }
+    if( pcPPS->rectSlice && !pcPPS->singleSlicePerSubPic )
+    {
+      WRITE_UVLC( pcPPS->numSlicesInPic - 1,           "pps_num_slices_in_pic_minus1" );
+      if( pcPPS->numSlicesInPic - 1 > 1 )
+      {
+        WRITE_FLAG( pcPPS->tileIdxDeltaPresent,        "pps_tile_idx_delta_present_flag" );
+      }
+      for( int i = 0; i < (int)pcPPS->numSlicesInPic - 1; i++ )
+      {
+        const RectSlice& rectSlice = pcPPS->rectSlices[ i ];
+        const uint32_t   tileX     = rectSlice.tileIdx % pcPPS->numTileCols;
+        const uint32_t   tileY     = rectSlice.tileIdx / pcPPS->numTileCols;
+        if( tileX != pcPPS->numTileCols - 1 )
+        {
+          WRITE_UVLC( rectSlice.sliceWidthInTiles - 1,  "pps_slice_width_in_tiles_minus1[i]" );
+        }
+        if( tileY != pcPPS->numTileRows - 1 && ( pcPPS->tileIdxDeltaPresent || tileX == 0 ) )
+        {
+          WRITE_UVLC( rectSlice.sliceHeightInTiles - 1, "pps_slice_height_in_tiles_minus1[i]" );
+        }
+        // multiple slices within a single tile, all but the last slice have the same height
+        if( rectSlice.sliceWidthInTiles == 1 && rectSlice.sliceHeightInTiles == 1 && pcPPS->tileRowHeight[ tileY ] > 1 )
+        {
+          const uint32_t numExpSlicesInTile = rectSlice.numSlicesInTile > 1 ? 1 : 0;
+          WRITE_UVLC( numExpSlicesInTile,               "pps_num_exp_slices_in_tile[i]" );
+          if( numExpSlicesInTile )
+          {
+            WRITE_UVLC( rectSlice.sliceHeightInCtu - 1, "pps_exp_slice_height_in_ctus_minus1[i]" );
+          }
+          i += rectSlice.numSlicesInTile - 1;
+        }
+        if( pcPPS->tileIdxDeltaPresent && i < (int)pcPPS->numSlicesInPic - 1 )
+        {
+          WRITE_SVLC( (int)pcPPS->rectSlices[ i + 1 ].tileIdx - (int)pcPPS->rectSlices[ i ].tileIdx, "pps_tile_idx_delta_val[i]" );
+        }
+      }
+    }
+    if( !pcPPS->rectSlice || pcPPS->singleSlicePerSubPic || pcPPS->numSlicesInPic > 1 )
+    {
+      WRITE_FLAG( pcPPS->loopFilterAcrossSlicesEnabled, "pps_loop_filter_across_slices_enabled_flag" );
+    }
   }
 
   WRITE_FLAG( pcPPS->cabacInitPresent,                "pps_cabac_init_present_flag" );
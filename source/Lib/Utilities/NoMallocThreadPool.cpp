@@ -66,6 +66,8 @@ NoMallocThreadPool::NoMallocThreadPool( int numThreads, const char * threadPoolN
   : m_poolName( threadPoolName )
   , m_threads ( numThreads < 0 ? std::thread::hardware_concurrency() : numThreads )
 {
+  m_numActiveThreads = (int)m_threads.size();
+
   int tid = 0;
   for( auto& t: m_threads )
   {
@@ -128,6 +130,12 @@ void NoMallocThreadPool::shutdown( bool block )
   }
 }
 
+void NoMallocThreadPool::setNumActiveThreads( int numThreads )
+{
+  CHECK( numThreads < 1 || numThreads > (int)m_threads.size(), "number of active threads out of range" );
+  m_numActiveThreads = numThreads;
+}
+
 void NoMallocThreadPool::waitForThreads()
 {
   for( auto& t: m_threads )
@@ -150,6 +158,12 @@ void NoMallocThreadPool::threadProc( int threadId )
   auto nextTaskIt = m_tasks.begin();
   while( !m_exitThreads )
   {
+    if( threadId >= m_numActiveThreads.load( std::memory_order_relaxed ) )
+    {
+      std::this_thread::sleep_for( PARKED_WAIT_TIME );
+      continue;
+    }
+
     auto taskIt = findNextTask( threadId, nextTaskIt );
     if( !taskIt.isValid() )
     {
@@ -161,7 +175,7 @@ void NoMallocThreadPool::threadProc( int threadId )
       while( !m_exitThreads )
       {
         taskIt = findNextTask( threadId, nextTaskIt );
-        if( taskIt.isValid() || m_exitThreads )
+        if( taskIt.isValid() || m_exitThreads || threadId >= m_numActiveThreads.load( std::memory_order_relaxed ) )
         {
           break;
         }
@@ -187,6 +201,10 @@ void NoMallocThreadPool::threadProc( int threadId )
     {
       return;
     }
+    if( !taskIt.isValid() )
+    {
+      continue;
+    }
 
     processTask( threadId, *taskIt );
 
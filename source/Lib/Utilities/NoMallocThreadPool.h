@@ -88,6 +88,10 @@ const static auto BUSY_WAIT_TIME = [] {
 }();
 
 
+// sleep time of threads parked by limiting the number of active threads
+const static auto PARKED_WAIT_TIME = std::chrono::milliseconds( 1 );
+
+
 // enable this if tasks need to be added from mutliple threads
 #define ADD_TASK_THREAD_SAFE 1
 
@@ -476,6 +480,10 @@ public:
 
   int numThreads() const { return (int)m_threads.size(); }
 
+  // limit the number of threads processing tasks, the remaining threads are parked
+  void setNumActiveThreads( int numThreads );
+  int  numActiveThreads() const { return m_numActiveThreads.load( std::memory_order_relaxed ); }
+
 private:
 
   using TaskIterator = ChunkedTaskQueue::Iterator;
@@ -491,6 +499,7 @@ private:
 #endif
   std::mutex               m_idleMutex;
   std::atomic_uint         m_waitingThreads{ 0 };
+  std::atomic_int          m_numActiveThreads{ 0 };
 #if ENABLE_VALGRIND_CODE
   std::mutex               m_extraMutex;
 #endif
@@ -451,6 +451,7 @@ bool VVEncAppCfg::parseCfg( int argc, char* argv[] )
   ("threads,-t",        m_numThreads,             "Number of threads default: [size < 720p: 4, >= 720p: 8]")
 
   ("gopsize,g",         m_GOPSize,                "GOP size of temporal structure (16,32)")
+  ("lowdelay",          m_lowDelay,               "low-delay coding without picture reordering (0:off, 1:on)")
   ("refreshtype,-rt",   toDecRefreshType,         "intra refresh type (idr,cra)")
   ("refreshsec,-rs",    m_IntraPeriodSec,         "Intra period/refresh in seconds")
   ("intraperiod,-ip",   m_IntraPeriod,            "Intra period in frames (0: use intra period in seconds (refreshsec), else: n*gopsize)")
@@ -613,6 +614,14 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
   IStreamToArr<char>                toDecodeBitstreams1           ( &m_decodeBitstreams[1][0], VVENC_MAX_STRING_LEN  );
   IStreamToArr<char>                toSummaryOutFilename          ( &m_summaryOutFilename[0], VVENC_MAX_STRING_LEN  );
   IStreamToArr<char>                toSummaryPicFilenameBase      ( &m_summaryPicFilenameBase[0], VVENC_MAX_STRING_LEN  );
+  IStreamToArr<char>                toSIMDTuningFile              ( &m_SIMDTuningFile[0], VVENC_MAX_STRING_LEN  );
+  IStreamToArr<char>                toRCStatsFile                 ( &m_RCStatsFile[0], VVENC_MAX_STRING_LEN  );
+  IStreamToArr<char>                toAnalysisSaveFile            ( &m_AnalysisSaveFile[0], VVENC_MAX_STRING_LEN  );
+  IStreamToArr<char>                toAnalysisLoadFile            ( &m_AnalysisLoadFile[0], VVENC_MAX_STRING_LEN  );
+  IStreamToArr<char>                toSplitModelFile              ( &m_SplitModelFile[0], VVENC_MAX_STRING_LEN  );
+  IStreamToArr<char>                toSplitModelDumpFile          ( &m_SplitModelDumpFile[0], VVENC_MAX_STRING_LEN  );
+  IStreamToVec<int>                 toLadderQPs                   ( &m_ladderQPs );
+  IStreamToVec<int>                 toLadderBitrates              ( &m_ladderBitrates );
 
   //
   // setup configuration parameters
@@ -670,6 +679,7 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
   ("RefreshSec,-rs",                                  m_IntraPeriodSec,                                 "Intra period in seconds")
   ("DecodingRefreshType,-dr",                         toDecRefreshType,                                 "Intra refresh type (0:none, 1:CRA, 2:IDR, 3:RecPointSEI)")
   ("GOPSize,g",                                       m_GOPSize,                                        "GOP size of temporal structure")
+  ("LowDelay",                                        m_lowDelay,                                       "Low-delay coding without picture reordering, each picture is output right after it has been passed to the encoder (0:off, 1:on)")
   ;
 
   opts.setSubSection("Rate control, Perceptual Quantization");
@@ -754,6 +764,11 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
   opts.addOptions()
   ("RCInitialQP",                                     m_RCInitialQP,                                    "Rate control: initial QP. With two-pass encoding, this specifies the first-pass base QP (instead of using a default QP). Activated if value is greater than zero" )
   ("RCForceIntraQP",                                  m_RCForceIntraQP,                                 "Rate control: force intra QP to be equal to initial QP" )
+  ("FirstPassMode",                                   m_FirstPassMode,                                  "Rate control: first pass of two-pass encoding (0: encode with reduced tools, 1: estimate statistics from the lookahead analysis only)" )
+  ("RCStatsFile",                                     toRCStatsFile,                                    "Rate control: file for the first-pass statistics of two-pass encoding, written by the first pass and read by a second pass run on its own" )
+  ("RCPass",                                          m_RCPass,                                         "Rate control: pass to run with RCStatsFile (-1: both passes, 1: first pass only, 2: second pass only)" )
+  ("LadderQPs",                                       toLadderQPs,                                      "Multi-rate ladder: QPs of additional streams, written to <BitstreamFile>_<n>, whose search is seeded from the analysis of the configured QP" )
+  ("LadderBitrates",                                  toLadderBitrates,                                 "Multi-rate ladder: target bitrates of additional streams, written to <BitstreamFile>_<n>, whose search is seeded from the analysis of the configured bitrate" )
 
   ("PerceptQPATempFiltIPic",                          m_usePerceptQPATempFiltISlice,                    "Temporal high-pass filter in QPA activity calculation for key pictures (0:off, 1:on, 2:on incl. temporal pumping reduction, -1:auto)")
   ;
@@ -814,6 +829,7 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
 
   ("WaveFrontSynchro",                                m_entropyCodingSyncEnabled,                       "Enable entropy coding sync")
   ("EntryPointsPresent",                              m_entryPointsPresent,                             "Enable entry points in slice header")
+  ("SliceCtuRows",                                    m_sliceCtuRows,                                   "Number of CTU rows per slice (0: one slice per picture)")
 
   ;
 
@@ -862,6 +878,9 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
   ("AMaxBT",                                          m_useAMaxBT,                                      "Adaptive maximal BT-size")
   ("FastQtBtEnc",                                     m_fastQtBtEnc,                                    "Fast encoding setting for QTBT")
   ("ContentBasedFastQtbt",                            m_contentBasedFastQtbt,                           "Signal based QTBT speed-up")
+  ("SplitModelConf",                                  m_SplitModelConf,                                 "Statistical split termination: skip a split if the split model is at least this confident that it does not win (0: off)")
+  ("SplitModelFile",                                  toSplitModelFile,                                 "Statistical split termination: file with trained weights replacing the built-in split model")
+  ("SplitModelDumpFile",                              toSplitModelDumpFile,                             "Statistical split termination: write the features and split decisions of the encoding as training data")
   ("FEN",                                             m_fastInterSearchMode,                            "fast encoder setting")
   ("ECU",                                             m_bUseEarlyCU,                                    "Early CU setting")
   ("FDM",                                             m_useFastDecisionForMerge,                        "Fast decision for Merge RD Cost")
@@ -898,7 +917,9 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
   ("ClipForBiPredMEEnabled",                          m_bClipForBiPredMeEnabled,                        "Enable clipping in the Bi-Pred ME.")
   ("FastMEAssumingSmootherMVEnabled",                 m_bFastMEAssumingSmootherMVEnabled,               "Enable fast ME assuming a smoother MV.")
   ("IntegerET",                                       m_bIntegerET,                                     "Enable early termination for integer motion search")
+  ("MCTFMvPred",                                      m_bMCTFMvPred,                                    "Use the MCTF motion fields as start candidates for integer motion search")
   ("FastSubPel",                                      m_fastSubPel,                                     "Enable fast sub-pel ME")
+  ("HalfPelRefCache",                                 m_bHalfPelRefCache,                               "Keep half-sample interpolated planes of the reference pictures for the fractional ME (more memory, no impact on the bitstream)")
   ;
 
   // Deblocking filter parameters
@@ -1035,6 +1056,10 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
   ("MCTFNumTrailFrames",                              m_vvencMCTF.MCTFNumTrailFrames,                   "Number of additional MCTF trail frames, which will not be encoded, but can used for MCTF filtering")
   ("MCTFFrame",                                       toMCTFFrames,                                          "Frame to filter Strength for frame in GOP based temporal filter")
   ("MCTFStrength",                                    toMCTFStrengths,                                       "Strength for  frame in GOP based temporal filter.")
+  ("LookAhead",                                       m_LookAhead,                                      "Analyse the input pictures once at reduced resolution (intra/inter costs, motion, activity), motion seeds the integer motion search")
+  ("AnalysisSaveFile",                                toAnalysisSaveFile,                               "Store the partitioning, prediction modes and motion of the coded pictures for later re-encodes")
+  ("AnalysisLoadFile",                                toAnalysisLoadFile,                               "Restrict the search to the decisions stored by an earlier encode with the same GOP structure")
+  ("AnalysisRefine",                                  m_AnalysisRefine,                                 "Refinement of loaded decisions (0: partitioning and prediction type, 1: partitioning, all modes, 2: additionally one further split)")
 
   ("FastLocalDualTreeMode",                           m_fastLocalDualTreeMode,                          "Fast intra pass coding for local dual-tree in intra coding region (0:off, 1:use threshold, 2:one intra mode only)")
   ("QtbttExtraFast",                                  m_qtbttSpeedUp,                                   "Non-VTM compatible QTBTT speed-ups" )
@@ -1044,7 +1069,11 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
   opts.addOptions()
   ("MaxParallelFrames",                               m_maxParallelFrames,                              "Maximum number of frames to be processed in parallel(0:off, >=2: enable parallel frames)")
   ("WppBitEqual",                                     m_ensureWppBitEqual,                              "Ensure bit equality with WPP case (0:off (sequencial mode), 1:copy from wpp line above, 2:line wise reset)")
+  ("RealTimeFps",                                     m_RealTimeFps,                                    "Real-time speed control: adapt the encoder speed per picture to sustain this frame rate (0: off, <0: source frame rate)")
+  ("RealTimeMaxDelay",                                m_RealTimeMaxDelay,                               "Real-time speed control: max. number of frames the encoder may fall behind, before switching to the fastest speed level (<0: GOP size)")
   ("EnablePicPartitioning",                           m_picPartitionFlag,                               "Enable picture partitioning (0: single tile, single slice, 1: multiple tiles/slices)")
+  ("SIMDTuning",                                      m_SIMDTuning,                                     "Time the SIMD kernels on encoder start and use the fastest extension per kernel and block width (x86 only)")
+  ("SIMDTuningFile",                                  toSIMDTuningFile,                                 "Cache file for the SIMD kernel tuning, reused if it matches the CPU")
   ;
 
   opts.setSubSection("Coding tools");
@@ -1063,6 +1092,7 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
   ("RPR",                                             m_rprEnabledFlag,                                 "Reference Sample Resolution (0: disable, 1: eneabled, 2: RPR ready")
   ("IBC",                                             m_IBCMode,                                        "IBC (0:off, 1:IBC, 2: IBC with SCC detection)")
   ("IBCFastMethod",                                   m_IBCFastMethod,                                  "Fast methods for IBC. 1:default, [2..6] speedups")
+  ("HashME",                                          m_HashME,                                         "Hash based exact match search for IBC and screen content ME (requires IBC or FastSearchSCC)")
   ("BCW",                                             m_BCW,                                            "Enable Generalized Bi-prediction(Bcw) 0: disabled, 1: enabled, 2: fast")
   ("FastInferMerge",                                  m_FIMMode,                                        "Fast method to skip Inter/Intra modes. 0: off, [1..4] speedups")
   ;
@@ -1251,6 +1281,36 @@ bool VVEncAppCfg::parseCfgFF( int argc, char* argv[] )
     m_RCNumPasses = m_RCTargetBitrate > 0 ? 2 : 1;
   }
 
+  if( m_RCPass != -1 && m_RCPass != 1 && m_RCPass != 2 )
+  {
+    cout <<  "error: RCPass must be -1, 1 or 2" << std::endl;
+    return false;
+  }
+  if( m_RCPass > 0 && ( m_RCNumPasses != 2 || m_RCStatsFile[0] == '\0' ) )
+  {
+    cout <<  "error: running a single pass requires two-pass rate control and a RCStatsFile" << std::endl;
+    return false;
+  }
+
+  if( ! m_ladderQPs.empty() || ! m_ladderBitrates.empty() )
+  {
+    if( ! m_ladderQPs.empty() && ! m_ladderBitrates.empty() )
+    {
+      cout <<  "error: either LadderQPs or LadderBitrates can be used" << std::endl;
+      return false;
+    }
+    if( ( m_RCTargetBitrate > 0 ) != ( ! m_ladderBitrates.empty() ) )
+    {
+      cout <<  "error: LadderBitrates requires a TargetBitrate, LadderQPs constant QP encoding" << std::endl;
+      return false;
+    }
+    if( m_AnalysisLoadFile[0] != '\0' || m_RCStatsFile[0] != '\0' || m_bitstreamFileName.empty() )
+    {
+      cout <<  "error: a multi-rate ladder requires a BitstreamFile and cannot be combined with AnalysisLoadFile or RCStatsFile" << std::endl;
+      return false;
+    }
+  }
+
   if( m_packedYUVMode && ! m_reconFileName.empty() )  
   {
     if( ( m_outputBitDepth[ 0 ] != 10 && m_outputBitDepth[ 0 ] != 12 )
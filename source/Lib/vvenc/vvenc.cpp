@@ -240,6 +240,17 @@ VVENC_DECL int vvenc_encoder_set_RecYUVBufferCallback(vvencEncoder *enc, void *
   return VVENC_OK;
 }
 
+VVENC_DECL int vvenc_encoder_set_SliceCallback(vvencEncoder *enc, void * ctx, vvencSliceCallback callback )
+{
+  auto d = (vvenc::VVEncImpl*)enc;
+  if (!d)
+  {
+    return VVENC_ERR_INITIALIZE;
+  }
+
+  return d->setSliceCallback( ctx, callback );
+}
+
 VVENC_DECL int vvenc_init_pass( vvencEncoder *enc, int pass )
 {
   auto d = (vvenc::VVEncImpl*)enc;
@@ -340,6 +340,7 @@ VVENC_DECL void vvenc_config_default(vvenc_config *c )
   c->m_IntraPeriodSec                          = 1;             ///< period of I-slice in seconds (random access period)
   c->m_DecodingRefreshType                     = VVENC_DRT_CRA;       ///< random access type
   c->m_GOPSize                                 = 32;            ///< GOP size of hierarchical structure
+  c->m_lowDelay                                = false;         ///< low-delay coding without picture reordering
 
   c->m_QP                                      = 32;            ///< QP value of key-picture (integer)
   c->m_usePerceptQPA                           = false;         ///< Mode of perceptually motivated input-adaptive QP modification, abbrev. perceptual QP adaptation (QPA).
@@ -483,6 +484,9 @@ VVENC_DECL void vvenc_config_default(vvenc_config *c )
   c->m_useAMaxBT                               = -1;
   c->m_fastQtBtEnc                             = true;
   c->m_contentBasedFastQtbt                    = false;
+  c->m_SplitModelConf                          = 0.0;
+  memset( c->m_SplitModelFile, '\0', sizeof(c->m_SplitModelFile) );
+  memset( c->m_SplitModelDumpFile, '\0', sizeof(c->m_SplitModelDumpFile) );
   c->m_fastInterSearchMode                     = VVENC_FASTINTERSEARCH_AUTO;
   c->m_bUseEarlyCU                             = false;
   c->m_useFastDecisionForMerge                 = true;
@@ -509,6 +513,8 @@ VVENC_DECL void vvenc_config_default(vvenc_config *c )
 
   c->m_RCInitialQP                             = 0;
   c->m_RCForceIntraQP                          = false;
+  c->m_FirstPassMode                           = 0;
+  memset( c->m_RCStatsFile, '\0', sizeof(c->m_RCStatsFile) );
 
   c->m_motionEstimationSearchMethod            = VVENC_MESEARCH_DIAMOND;
   c->m_motionEstimationSearchMethodSCC         = 0;
@@ -519,7 +525,9 @@ VVENC_DECL void vvenc_config_default(vvenc_config *c )
   c->m_bClipForBiPredMeEnabled                 = false;
   c->m_bFastMEAssumingSmootherMVEnabled        = true;
   c->m_bIntegerET                              = false;
+  c->m_bMCTFMvPred                             = false;
   c->m_fastSubPel                              = 0;
+  c->m_bHalfPelRefCache                        = false;
   c->m_SMVD                                    = 0;
   c->m_AMVRspeed                               = 0;
   c->m_LMChroma                                = false;
@@ -561,6 +569,7 @@ VVENC_DECL void vvenc_config_default(vvenc_config *c )
 
   c->m_IBCMode                                 = 0;
   c->m_IBCFastMethod                           = 1;
+  c->m_HashME                                  = false;
 
   c->m_BCW                                     = 0;
 
@@ -578,6 +587,7 @@ VVENC_DECL void vvenc_config_default(vvenc_config *c )
   c->m_bLFCrossTileBoundaryFlag                = true;
   c->m_bLFCrossSliceBoundaryFlag               = true;
   c->m_loopFilterAcrossSlicesEnabled           = false;
+  c->m_sliceCtuRows                            = 0;
 
   c->m_bUseSAO                                 = true;
   c->m_saoEncodingRate                         = -1.0;
@@ -619,6 +629,10 @@ VVENC_DECL void vvenc_config_default(vvenc_config *c )
   c->m_alfTempPred                             = -1;
 
   vvenc_vvencMCTF_default( &c->m_vvencMCTF );
+  c->m_LookAhead                               = false;
+  memset( c->m_AnalysisSaveFile, '\0', sizeof(c->m_AnalysisSaveFile) );
+  memset( c->m_AnalysisLoadFile, '\0', sizeof(c->m_AnalysisLoadFile) );
+  c->m_AnalysisRefine                          = 1;
 
   c->m_quantThresholdVal                       = -1;
   c->m_qtbttSpeedUp                            = 1;
@@ -628,8 +642,14 @@ VVENC_DECL void vvenc_config_default(vvenc_config *c )
   c->m_maxParallelFrames                       = -1;
   c->m_ensureWppBitEqual                       = -1;
 
+  c->m_RealTimeFps                             = 0.0;
+  c->m_RealTimeMaxDelay                        = -1;
+
   c->m_picPartitionFlag                        = false;
 
+  c->m_SIMDTuning                              = false;
+  memset( c->m_SIMDTuningFile, '\0', sizeof(c->m_SIMDTuningFile) );
+
   memset( c->m_summaryOutFilename    , '\0', sizeof(c->m_summaryOutFilename) );
   memset( c->m_summaryPicFilenameBase, '\0', sizeof(c->m_summaryPicFilenameBase) );
   c->m_summaryVerboseness                      = 0;
@@ -693,9 +713,15 @@ VVENC_DECL bool vvenc_init_config_parameter( vvenc_config *c )
   vvenc_confirmParameter( c, c->m_IntraPeriod < -1,                                            "IDR period (in frames) must be >= -1");
   vvenc_confirmParameter( c, c->m_IntraPeriodSec < 0,                                          "IDR period (in seconds) must be >= 0");
 
+  // low delay: the automatic GOP structure is a low-delay B structure of 8 pictures
+  if( c->m_lowDelay && c->m_GOPList[0].m_POC == -1 && c->m_IntraPeriod != 1 )
+  {
+    c->m_GOPSize = 8;
+  }
+
   vvenc_confirmParameter( c, c->m_GOPSize < 1 || c->m_GOPSize > 64,                                                        "GOP Size must be between 1 and 64" );
   vvenc_confirmParameter( c, c->m_GOPSize > 1 &&  c->m_GOPSize % 2,                                                        "GOP Size must be a multiple of 2" );
-  vvenc_confirmParameter( c, c->m_GOPList[0].m_POC == -1 && c->m_GOPSize != 1 && c->m_GOPSize != 16 && c->m_GOPSize != 32, "GOP list auto config only supported GOP sizes: 1, 16, 32" );
+  vvenc_confirmParameter( c, c->m_GOPList[0].m_POC == -1 && ! c->m_lowDelay && c->m_GOPSize != 1 && c->m_GOPSize != 16 && c->m_GOPSize != 32, "GOP list auto config only supported GOP sizes: 1, 16, 32" );
 
   vvenc_confirmParameter( c, c->m_QP < 0 || c->m_QP > vvenc::MAX_QP,                                                 "QP exceeds supported range (0 to 63)" );
 
@@ -751,11 +777,21 @@ VVENC_DECL bool vvenc_init_config_parameter( vvenc_config *c )
     c->m_level = vvenc::LevelTierFeatures::getLevelForInput( c->m_SourceWidth, c->m_SourceHeight, c->m_levelTier, temporalRate, temporalScale, c->m_RCTargetBitrate );
   }
 
+  if ( c->m_lowDelay )
+  {
+    // pictures are encoded as soon as they are received, the temporal filter uses past pictures only
+    c->m_vvencMCTF.MCTFFutureReference = false;
+    if ( c->m_updateCtrl == 0 )
+    {
+      c->m_updateCtrl = 2;
+    }
+  }
+
   if ( c->m_InputQueueSize <= 0 )
   {
-    c->m_InputQueueSize = c->m_GOPSize;
+    c->m_InputQueueSize = c->m_lowDelay ? 1 : c->m_GOPSize;
 
-    if ( c->m_vvencMCTF.MCTF )
+    if ( c->m_vvencMCTF.MCTF && ! c->m_lowDelay )
     {
       c->m_InputQueueSize += vvenc::MCTF_ADD_QUEUE_DELAY;
     }
@@ -824,13 +860,17 @@ VVENC_DECL bool vvenc_init_config_parameter( vvenc_config *c )
   if( c->m_saoEncodingRateChroma < 0.0 ) c->m_saoEncodingRateChroma = c->m_numThreads ? 0.0 : 0.5 ;
   if( c->m_maxParallelFrames < 0 )
   {
-    c->m_maxParallelFrames = std::min( c->m_numThreads, 4 );
-    if( c->m_RCTargetBitrate > 0
-        && c->m_RCNumPasses == 1
-        && c->m_maxParallelFrames > 2 )
-    {
-      c->m_maxParallelFrames = 2;
-    }
+    c->m_maxParallelFrames = c->m_lowDelay ? 0 : std::min( c->m_numThreads, 4 );
+  }
+
+  // real-time speed control
+  if( c->m_RealTimeFps < 0.0 )
+  {
+    c->m_RealTimeFps = c->m_FrameRate;
+  }
+  if( c->m_RealTimeMaxDelay < 0 )
+  {
+    c->m_RealTimeMaxDelay = c->m_GOPSize;
   }
 
   // quantization threshold
@@ -1274,8 +1314,38 @@ VVENC_DECL bool vvenc_init_config_parameter( vvenc_config *c )
   }
   else
   {
+    // set default LD config
+    if( c->m_lowDelay && c->m_GOPSize == 8 && c->m_GOPList[0].m_POC == -1 && c->m_GOPList[1].m_POC == -1 )
+    {
+      for( int i = 0; i < 8; i++ )
+      {
+        vvenc_GOPEntry_default( &c->m_GOPList[i] );
+        c->m_GOPList[i].m_sliceType = 'B';
+        c->m_GOPList[i].m_QPFactor  = 1;
+        c->m_GOPList[i].m_POC       = i + 1;
+
+        // every other picture has a lower QP, every eighth picture acts as key picture
+        c->m_GOPList[i].m_QPOffset            = i == 7 ? 1 : ( i & 1 ? 4 : 5 );
+        c->m_GOPList[i].m_QPOffsetModelOffset = i == 7 ? 0.0 : -6.5;
+        c->m_GOPList[i].m_QPOffsetModelScale  = i == 7 ? 0.0 : 0.2590;
+
+        // the previous picture and the last key pictures, both lists are identical (generalized P/B)
+        c->m_GOPList[i].m_numRefPicsActive[0] = 2;
+        c->m_GOPList[i].m_numRefPicsActive[1] = 2;
+        c->m_GOPList[i].m_numRefPics[0] = 4;
+        c->m_GOPList[i].m_numRefPics[1] = 4;
+        c->m_GOPList[i].m_deltaRefPics[0][0] = 1;
+        c->m_GOPList[i].m_deltaRefPics[0][1] = i == 0 ?  9 : i + 1;
+        c->m_GOPList[i].m_deltaRefPics[0][2] = i == 0 ? 17 : i + 9;
+        c->m_GOPList[i].m_deltaRefPics[0][3] = i == 0 ? 25 : i + 17;
+        for( int j = 0; j < 4; j++ )
+        {
+          c->m_GOPList[i].m_deltaRefPics[1][j] = c->m_GOPList[i].m_deltaRefPics[0][j];
+        }
+      }
+    }
     // set default RA config
-    if( c->m_GOPSize == 16 && c->m_GOPList[0].m_POC == -1 && c->m_GOPList[1].m_POC == -1 )
+    else if( c->m_GOPSize == 16 && c->m_GOPList[0].m_POC == -1 && c->m_GOPList[1].m_POC == -1 )
     {
       for( int i = 0; i < 16; i++ )
       {
@@ -2004,6 +2074,11 @@ VVENC_DECL bool vvenc_init_config_parameter( vvenc_config *c )
   vvenc_checkCharArrayStr( c->m_traceFile, VVENC_MAX_STRING_LEN);
   vvenc_checkCharArrayStr( c->m_summaryOutFilename, VVENC_MAX_STRING_LEN);
   vvenc_checkCharArrayStr( c->m_summaryPicFilenameBase, VVENC_MAX_STRING_LEN);
+  vvenc_checkCharArrayStr( c->m_RCStatsFile, VVENC_MAX_STRING_LEN);
+  vvenc_checkCharArrayStr( c->m_AnalysisSaveFile, VVENC_MAX_STRING_LEN);
+  vvenc_checkCharArrayStr( c->m_AnalysisLoadFile, VVENC_MAX_STRING_LEN);
+  vvenc_checkCharArrayStr( c->m_SplitModelFile, VVENC_MAX_STRING_LEN);
+  vvenc_checkCharArrayStr( c->m_SplitModelDumpFile, VVENC_MAX_STRING_LEN);
 
   c->m_configDone = true;
 
@@ -2156,8 +2231,26 @@ static bool checkCfgParameter( vvenc_config *c )
   vvenc_confirmParameter( c, c->m_framesToBeEncoded < c->m_switchPOC,                                          "debug POC out of range" );
 
   vvenc_confirmParameter( c, (c->m_IntraPeriod > 0 && c->m_IntraPeriod < c->m_GOPSize) || c->m_IntraPeriod == 0,     "Intra period must be more than GOP size, or -1 , not 0" );
-  vvenc_confirmParameter( c, c->m_InputQueueSize < c->m_GOPSize ,                                              "Input queue size must be greater or equal to gop size" );
-  vvenc_confirmParameter( c, c->m_vvencMCTF.MCTF && c->m_InputQueueSize < c->m_GOPSize + vvenc::MCTF_ADD_QUEUE_DELAY , "Input queue size must be greater or equal to gop size + N frames for MCTF" );
+  vvenc_confirmParameter( c, ! c->m_lowDelay && c->m_InputQueueSize < c->m_GOPSize ,                           "Input queue size must be greater or equal to gop size" );
+  vvenc_confirmParameter( c, ! c->m_lowDelay && c->m_vvencMCTF.MCTF && c->m_InputQueueSize < c->m_GOPSize + vvenc::MCTF_ADD_QUEUE_DELAY , "Input queue size must be greater or equal to gop size + N frames for MCTF" );
+  if( c->m_lowDelay )
+  {
+    bool reordering = false;
+    for( int i = 0; i < c->m_GOPSize; i++ )
+    {
+      reordering |= c->m_GOPList[ i ].m_POC != i + 1;
+      for( int l = 0; l < 2; l++ )
+      {
+        for( int j = 0; j < c->m_GOPList[ i ].m_numRefPics[ l ]; j++ )
+        {
+          reordering |= c->m_GOPList[ i ].m_deltaRefPics[ l ][ j ] <= 0;
+        }
+      }
+    }
+    vvenc_confirmParameter( c, reordering,                     "LowDelay requires a GOP structure in display order without references to future pictures" );
+    vvenc_confirmParameter( c, c->m_maxParallelFrames > 0,     "LowDelay does not support frame parallel encoding" );
+  }
+  vvenc_confirmParameter( c, c->m_sliceCtuRows < 0,                                                            "SliceCtuRows must be >= 0" );
 
   vvenc_confirmParameter( c, c->m_DecodingRefreshType < 0 || c->m_DecodingRefreshType > 3,                     "Decoding Refresh Type must be comprised between 0 and 3 included" );
   vvenc_confirmParameter( c, c->m_IntraPeriod > 0 && !(c->m_DecodingRefreshType==1 || c->m_DecodingRefreshType==2), "Only Decoding Refresh Type CRA for non low delay supported" );                  //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -2238,7 +2331,10 @@ static bool checkCfgParameter( vvenc_config *c )
 
   vvenc_confirmParameter( c, c->m_RCTargetBitrate == 0 && c->m_RCNumPasses != 1, "Only single pass encoding supported, when rate control is disabled" );
   vvenc_confirmParameter( c, c->m_RCNumPasses < 1 || c->m_RCNumPasses > 2,       "Only one pass or two pass encoding supported" );
-  vvenc_confirmParameter( c, c->m_RCTargetBitrate > 0 && c->m_maxParallelFrames > 4, "Up to 4 parallel frames supported with rate control" );
+  vvenc_confirmParameter( c, c->m_FirstPassMode < 0 || c->m_FirstPassMode > 1,   "FirstPassMode must be 0 or 1" );
+  vvenc_confirmParameter( c, c->m_RCStatsFile[0] != '\0' && c->m_RCNumPasses != 2, "RCStatsFile requires two-pass rate control" );
+  vvenc_confirmParameter( c, c->m_AnalysisRefine < 0 || c->m_AnalysisRefine > 2, "AnalysisRefine must be in the range 0..2" );
+  vvenc_confirmParameter( c, c->m_AnalysisSaveFile[0] != '\0' && c->m_AnalysisLoadFile[0] != '\0' && !strcmp( c->m_AnalysisSaveFile, c->m_AnalysisLoadFile ), "AnalysisSaveFile and AnalysisLoadFile must differ" );
 
   vvenc_confirmParameter(c, !((c->m_level==VVENC_LEVEL1)
     || (c->m_level==VVENC_LEVEL2) || (c->m_level==VVENC_LEVEL2_1)
@@ -2313,6 +2409,7 @@ static bool checkCfgParameter( vvenc_config *c )
   vvenc_confirmParameter(c, c->m_numThreads < 0,                                               "NumThreads out of range" );
   vvenc_confirmParameter(c, c->m_ensureWppBitEqual < 0       || c->m_ensureWppBitEqual > 1,       "WppBitEqual out of range (0,1)");
   vvenc_confirmParameter(c, c->m_useAMaxBT < 0               || c->m_useAMaxBT > 1,               "AMaxBT out of range (0,1)");
+  vvenc_confirmParameter(c, c->m_SplitModelConf < 0.0        || c->m_SplitModelConf >= 1.0,       "SplitModelConf out of range [0,1)");
   vvenc_confirmParameter(c, c->m_cabacInitPresent < 0        || c->m_cabacInitPresent > 1,        "CabacInitPresent out of range (0,1)");
   vvenc_confirmParameter(c, c->m_alfTempPred < 0             || c->m_alfTempPred > 1,             "ALFTempPred out of range (0,1)");
   vvenc_confirmParameter(c, c->m_alfSpeed < 0                || c->m_alfSpeed > 1,                "ALFSpeed out of range (0,1)");
@@ -2327,16 +2424,15 @@ static bool checkCfgParameter( vvenc_config *c )
   if( c->m_maxParallelFrames )
   {
     vvenc_confirmParameter(c, c->m_numThreads == 0,       "For frame parallel processing NumThreads > 0 is required" );
-    vvenc_confirmParameter(c, c->m_useAMaxBT,             "Frame parallel processing: AMaxBT is not supported (must be disabled)" );
-    vvenc_confirmParameter(c, c->m_cabacInitPresent,      "Frame parallel processing: CabacInitPresent is not supported (must be disabled)" );
-    vvenc_confirmParameter(c, c->m_saoEncodingRate > 0.0, "Frame parallel processing: SaoEncodingRate is not supported (must be disabled)" );
-    vvenc_confirmParameter(c, c->m_alfTempPred,           "Frame parallel processing: ALFTempPred is not supported (must be disabled)" );
+    vvenc_confirmParameter(c, c->m_alfTempPred && c->m_decodeBitstreams[0][0] != '\0', "Frame parallel processing: ALFTempPred is not supported when decoding a debug bitstream" );
 #if ENABLE_TRACING
     vvenc_confirmParameter(c, c->m_traceFile[0] != '\0' && c->m_maxParallelFrames > 1, "Tracing and frame parallel encoding not supported" );
 #endif
     vvenc_confirmParameter(c, c->m_maxParallelFrames > c->m_InputQueueSize, "Max parallel frames should be less than size of input queue" );
   }
 
+  vvenc_confirmParameter(c, c->m_RealTimeFps > 0.0 && c->m_RealTimeMaxDelay < 1, "RealTimeMaxDelay must be at least 1" );
+
   vvenc_confirmParameter(c,((c->m_PadSourceWidth) & 7) != 0, "internal picture width must be a multiple of 8 - check cropping options");
   vvenc_confirmParameter(c,((c->m_PadSourceHeight) & 7) != 0, "internal picture height must be a multiple of 8 - check cropping options");
 
@@ -2706,6 +2802,8 @@ VVENC_DECL int vvenc_init_preset( vvenc_config *c, vvencPresetMode preset )
   c->m_lumaReshapeEnable               = 0;
   c->m_vvencMCTF.MCTF                  = 0;
   c->m_vvencMCTF.MCTFSpeed             = 0;
+  c->m_bMCTFMvPred                     = 0;
+  c->m_LookAhead                       = 0;
   c->m_MIP                             = 0;
   c->m_useFastMIP                      = 0;
   c->m_MMVD                            = 0;
@@ -2726,6 +2824,7 @@ VVENC_DECL int vvenc_init_preset( vvenc_config *c, vvencPresetMode preset )
   c->m_useBDPCM                        = 2;
   c->m_IBCMode                         = 2;
   c->m_IBCFastMethod                   = 6;
+  c->m_HashME                          = 1;
   c->m_TS                              = 2;
   c->m_useChromaTS                     = 0;
   c->m_TSsize                          = 3;
@@ -2767,6 +2866,8 @@ VVENC_DECL int vvenc_init_preset( vvenc_config *c, vvencPresetMode preset )
       c->m_bUseEarlyCU                     = 1;
       c->m_bIntegerET                      = 1;
       c->m_IntraEstDecBit                  = 3;
+      c->m_bMCTFMvPred                     = 1;
+      c->m_LookAhead                       = 1;
 
       // tools                             
       c->m_RDOQ                            = 2;
@@ -2813,6 +2914,8 @@ VVENC_DECL int vvenc_init_preset( vvenc_config *c, vvencPresetMode preset )
       c->m_bUseEarlyCU                     = 1;
       c->m_bIntegerET                      = 0;
       c->m_IntraEstDecBit                  = 3;
+      c->m_bMCTFMvPred                     = 1;
+      c->m_LookAhead                       = 1;
 
       // tools                             
       c->m_RDOQ                            = 2;
@@ -3204,6 +3307,10 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
   const int iWaveFrontSubstreams = c->m_entropyCodingSyncEnabled ? ( c->m_PadSourceHeight + c->m_CTUSize - 1 ) / c->m_CTUSize : 1;
   css << "WPP:" << (c->m_entropyCodingSyncEnabled ? 1 : 0) << " ";
   css << "WPP-Substreams:" << iWaveFrontSubstreams << " ";
+  if( c->m_sliceCtuRows > 0 )
+  {
+    css << "SliceCtuRows:" << c->m_sliceCtuRows << " ";
+  }
   css << "TMVP:" << c->m_TMVPModeId << " ";
 
   css << "DQ:" << c->m_DepQuantEnabled << " ";
@@ -3273,6 +3380,10 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
   {
     css << "[L:" << c->m_vvencMCTF.MCTFNumLeadFrames << ", T:" << c->m_vvencMCTF.MCTFNumTrailFrames << "] ";
   }
+  css << "LookAhead:" << c->m_LookAhead << " ";
+  css << "LowDelay:" << c->m_lowDelay << " ";
+  if( c->m_AnalysisLoadFile[0] != '\0' )
+    css << "AnalysisRefine:" << c->m_AnalysisRefine << " ";
 
   css << "\nFAST TOOL CFG: ";
   css << "ECU:" << c->m_bUseEarlyCU << " ";
@@ -3289,6 +3400,7 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
   css << "AMaxBT:" << c->m_useAMaxBT << " ";
   css << "FastQtBtEnc:" << c->m_fastQtBtEnc << " ";
   css << "ContentBasedFastQtbt:" << c->m_contentBasedFastQtbt << " ";
+  css << "SplitModelConf:" << c->m_SplitModelConf << " ";
   if( c->m_MIP )
   {
     css << "FastMIP:" << c->m_useFastMIP << " ";
@@ -3297,12 +3409,14 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
   css << "IntraEstDecBit:" << c->m_IntraEstDecBit << " ";
   css << "FastLocalDualTree:" << c->m_fastLocalDualTreeMode << " ";
   css << "IntegerET:" << c->m_bIntegerET << " ";
+  css << "MCTFMvPred:" << c->m_bMCTFMvPred << " ";
   css << "FastSubPel:" << c->m_fastSubPel << " ";
   css << "QtbttExtraFast:" << c->m_qtbttSpeedUp << " ";
   if( c->m_IBCMode )
   {
     css << "IBCFastMethod:" << c->m_IBCFastMethod << " ";
   }
+  css << "HashME:" << c->m_HashME << " ";
   css << "FIM:" << c->m_FIMMode << " ";
   if( c->m_FastInferMerge )
   {
@@ -3325,6 +3439,12 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
     css << "TargetBitrate:" << c->m_RCTargetBitrate << " ";
     css << "RCInitialQP:" << c->m_RCInitialQP << " ";
     css << "RCForceIntraQP:" << c->m_RCForceIntraQP << " ";
+    if ( c->m_RCNumPasses == 2 )
+    {
+      css << "FirstPassMode:" << c->m_FirstPassMode << " ";
+      if ( c->m_RCStatsFile[0] != '\0' )
+        css << "RCStatsFile:" << c->m_RCStatsFile << " ";
+    }
   }
 
   css << "\nPARALLEL PROCESSING CFG: ";
@@ -3332,6 +3452,11 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
   css << "MaxParallelFrames:" << c->m_maxParallelFrames << " ";
   css << "WppBitEqual:" << c->m_ensureWppBitEqual << " ";
   css << "WF:" << c->m_entropyCodingSyncEnabled << "";
+  if( c->m_RealTimeFps > 0.0 )
+  {
+    css << " RealTimeFps:" << c->m_RealTimeFps << " ";
+    css << "RealTimeMaxDelay:" << c->m_RealTimeMaxDelay << "";
+  }
   css << "\n";
   }
 
@@ -65,6 +65,9 @@ THE POSSIBILITY OF SUCH DAMAGE.
 #if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_TRAFO
 #include "CommonLib/TrQuant_EMT.h"
 #endif
+#if defined( TARGET_SIMD_X86 )
+#include "CommonLib/x86/KernelTuningX86.h"
+#endif
 
 #if defined( __linux__ )
 #include <malloc.h>
@@ -108,10 +111,78 @@ int VVEncImpl::getConfig( vvenc_config& config ) const
   return VVENC_OK;
 }
 
-int VVEncImpl::reconfig( const vvenc_config&  )
+int VVEncImpl::reconfig( const vvenc_config& config )
 {
   if( !m_bInitialized ){ return VVENC_ERR_INITIALIZE; }
-  return VVENC_ERR_NOT_SUPPORTED;
+  if( m_eState == INTERNAL_STATE_FLUSHING || m_eState == INTERNAL_STATE_FINALIZED ) { m_cErrorString = "encoder already received flush indication, please reinit."; return VVENC_ERR_RESTART_REQUIRED; }
+
+  // take over the reconfigurable parameters, all other parameters are kept
+  const vvenc_config& curCfg = m_cVVEncCfg;
+  vvenc_config newCfg        = m_cVVEncCfg;
+  newCfg.m_RCTargetBitrate              = config.m_RCTargetBitrate;
+  newCfg.m_QP                           = config.m_QP;
+  newCfg.m_motionEstimationSearchMethod = config.m_motionEstimationSearchMethod;
+  newCfg.m_SearchRange                  = config.m_SearchRange;
+  newCfg.m_bipredSearchRange            = config.m_bipredSearchRange;
+  newCfg.m_minSearchWindow              = config.m_minSearchWindow;
+  newCfg.m_bRestrictMESampling          = config.m_bRestrictMESampling;
+  newCfg.m_fastSubPel                   = config.m_fastSubPel;
+  newCfg.m_numThreads                   = config.m_numThreads;
+
+  std::string cErr;
+  if( curCfg.m_RCNumPasses > 1 )
+  {
+    cErr = "reconfiguration not supported with two-pass rate control";
+  }
+  else if( ( newCfg.m_RCTargetBitrate > 0 ) != ( curCfg.m_RCTargetBitrate > 0 ) )
+  {
+    cErr = "rate control cannot be switched on or off by reconfiguration";
+  }
+  else if( newCfg.m_RCTargetBitrate != curCfg.m_RCTargetBitrate && curCfg.m_hrdParametersPresent )
+  {
+    cErr = "target bitrate cannot be changed, when HRD parameters are signalled";
+  }
+  else if( newCfg.m_QP != curCfg.m_QP && curCfg.m_RCTargetBitrate > 0 )
+  {
+    cErr = "QP cannot be changed with rate control";
+  }
+  else if( newCfg.m_QP != curCfg.m_QP && curCfg.m_usePerceptQPA && ( newCfg.m_QP <= MAX_QP_PERCEPT_QPA ) != ( curCfg.m_QP <= MAX_QP_PERCEPT_QPA ) )
+  {
+    cErr = "QP change would switch the delta QP signalling of the perceptual QPA";
+  }
+  else if( curCfg.m_numThreads == 0 ? newCfg.m_numThreads != 0 : ( newCfg.m_numThreads < 1 || newCfg.m_numThreads > curCfg.m_numThreads ) )
+  {
+    cErr = "number of threads can only be reduced or restored up to the initial number of threads";
+  }
+  if( ! cErr.empty() )
+  {
+    m_cErrorString = "reconfig: " + cErr;
+    return VVENC_ERR_NOT_SUPPORTED;
+  }
+
+  vvenc_config chkCfg = newCfg;
+  if( vvenc_init_config_parameter( &chkCfg ) )
+  {
+    m_cErrorString = "reconfig: invalid parameter";
+    return VVENC_ERR_PARAMETER;
+  }
+
+#if HANDLE_EXCEPTION
+  try
+#endif
+  {
+    m_pEncLib->reconfig( newCfg );
+  }
+#if HANDLE_EXCEPTION
+  catch( std::exception& e )
+  {
+    m_cErrorString = e.what();
+    return VVENC_ERR_UNSPECIFIED;
+  }
+#endif
+
+  m_cVVEncCfg = newCfg;
+  return VVENC_OK;
 }
 
 int VVEncImpl::checkConfig( const vvenc_config& config )
@@ -142,6 +213,19 @@ int VVEncImpl::init( const vvenc_config& config )
     return VVENC_ERR_INITIALIZE;
   }
 
+#if defined( TARGET_SIMD_X86 )
+  if( m_cVVEncCfg.m_SIMDTuning && g_kernelTuning.init( m_cVVEncCfg.m_SIMDTuningFile ) )
+  {
+#if ENABLE_SIMD_OPT_BUFFER
+    g_kernelTuning.apply( g_pelBufOP );
+#endif
+#if ENABLE_SIMD_TRAFO
+    g_kernelTuning.apply( g_tCoeffOps );
+#endif
+    curSimd += ",tuned";
+  }
+#endif
+
   std::stringstream cssCap;
   cssCap << getCompileInfoString() << "[SIMD=" << curSimd <<"]";
   m_sEncoderCapabilities = cssCap.str();
@@ -257,6 +341,30 @@ int VVEncImpl::setRecYUVBufferCallback( void * ctx, vvencRecYUVBufferCallback ca
   return VVENC_OK;
 }
 
+int VVEncImpl::setSliceCallback( void * ctx, vvencSliceCallback callback )
+{
+  if( !m_bInitialized || !m_pEncLib ){ return VVENC_ERR_INITIALIZE; }
+
+  if( nullptr == callback )
+  {
+    m_pEncLib->setSliceCallback( nullptr );
+    return VVENC_OK;
+  }
+
+  m_pEncLib->setSliceCallback( [this, ctx, callback]( AccessUnitList& sliceAu, bool isAuStart )
+  {
+    vvencAccessUnit accessUnit;
+    vvenc_accessUnit_default( &accessUnit );
+    vvenc_accessUnit_alloc_payload( &accessUnit, xGetAccessUnitsSize( sliceAu, isAuStart ) );
+    if( xCopyAu( accessUnit, sliceAu, isAuStart ) == 0 )
+    {
+      callback( ctx, &accessUnit );
+    }
+    vvenc_accessUnit_free_payload( &accessUnit );
+  } );
+  return VVENC_OK;
+}
+
 int VVEncImpl::encode( vvencYUVBuffer* pcYUVBuffer, vvencAccessUnit* pcAccessUnit, bool* pbEncodeDone )
 {
   if( !m_bInitialized )                      { return VVENC_ERR_INITIALIZE; }
@@ -472,7 +580,7 @@ int VVEncImpl::printSummary() const
   return 0;
 }
 
-int VVEncImpl::xGetAccessUnitsSize( const vvenc::AccessUnitList& rcAuList )
+int VVEncImpl::xGetAccessUnitsSize( const vvenc::AccessUnitList& rcAuList, bool isAuStart )
 {
   uint32_t sizeSum = 0;
   if ( ! rcAuList.empty() )
@@ -480,7 +588,7 @@ int VVEncImpl::xGetAccessUnitsSize( const vvenc::AccessUnitList& rcAuList )
     for (vvenc::AccessUnitList::const_iterator it = rcAuList.begin(); it != rcAuList.end(); it++)
     {
       const vvenc::NALUnitEBSP& nalu = **it;
-      if (it == rcAuList.begin() ||
+      if ((it == rcAuList.begin() && isAuStart) ||
           nalu.m_nalUnitType == VVENC_NAL_UNIT_DCI ||
           nalu.m_nalUnitType == VVENC_NAL_UNIT_SPS ||
           nalu.m_nalUnitType == VVENC_NAL_UNIT_VPS ||
@@ -502,7 +610,7 @@ int VVEncImpl::xGetAccessUnitsSize( const vvenc::AccessUnitList& rcAuList )
 }
 
 
-int VVEncImpl::xCopyAu( vvencAccessUnit& rcAccessUnit, const vvenc::AccessUnitList& rcAuList )
+int VVEncImpl::xCopyAu( vvencAccessUnit& rcAccessUnit, const vvenc::AccessUnitList& rcAuList, bool isAuStart )
 {
   rcAccessUnit.rap = false;
 
@@ -517,7 +625,7 @@ int VVEncImpl::xCopyAu( vvencAccessUnit& rcAccessUnit, const vvenc::AccessUnitLi
       const vvenc::NALUnitEBSP& nalu = **it;
       uint32_t size = 0; /* size of annexB unit in bytes */
 
-      if (it == rcAuList.begin() ||
+      if ((it == rcAuList.begin() && isAuStart) ||
           nalu.m_nalUnitType == VVENC_NAL_UNIT_DCI ||
           nalu.m_nalUnitType == VVENC_NAL_UNIT_SPS ||
           nalu.m_nalUnitType == VVENC_NAL_UNIT_VPS ||
@@ -568,7 +676,7 @@ int VVEncImpl::xCopyAu( vvencAccessUnit& rcAccessUnit, const vvenc::AccessUnitLi
     {
       const vvenc::NALUnitEBSP& nalu = **it;
       static const uint8_t start_code_prefix[] = {0,0,0,1};
-      if (it == rcAuList.begin() ||
+      if ((it == rcAuList.begin() && isAuStart) ||
           nalu.m_nalUnitType == VVENC_NAL_UNIT_DCI ||
           nalu.m_nalUnitType == VVENC_NAL_UNIT_SPS ||
           nalu.m_nalUnitType == VVENC_NAL_UNIT_VPS ||
@@ -104,6 +104,7 @@ public:
   bool isInitialized() const;
 
   int setRecYUVBufferCallback( void *, vvencRecYUVBufferCallback );
+  int setSliceCallback( void *, vvencSliceCallback );
 
   int encode( vvencYUVBuffer* pcYUVBuffer, vvencAccessUnit* pcAccessUnit, bool* pbEncodeDone );
 
@@ -131,8 +132,8 @@ public:
   static int         decodeBitstream( const char* FileName);
 
 private:
-  int xGetAccessUnitsSize( const vvenc::AccessUnitList& rcAuList );
-  int xCopyAu( vvencAccessUnit& rcAccessUnit, const AccessUnitList& rcAu );
+  int xGetAccessUnitsSize( const vvenc::AccessUnitList& rcAuList, bool isAuStart = true );
+  int xCopyAu( vvencAccessUnit& rcAccessUnit, const AccessUnitList& rcAu, bool isAuStart = true );
 
 private:
   VVEncInternalState     m_eState               = INTERNAL_STATE_UNINITIALIZED;
@@ -485,6 +485,183 @@ int callingOrderRegular()
   return 0;
 }
 
+int callingOrderRegularReconfig()
+{
+  vvenc_config vvencParams;
+  vvenc_config_default( &vvencParams );
+
+  fillEncoderParameters( vvencParams );
+
+  vvencEncoder *enc = vvenc_encoder_create();
+  if( nullptr == enc )
+  {
+    return -1;
+  }
+
+  if( 0 != vvenc_encoder_open( enc, &vvencParams ) )
+  {
+    vvenc_encoder_close( enc );
+    return -1;
+  }
+
+  vvencAccessUnit* AU = vvenc_accessUnit_alloc();
+  vvenc_accessUnit_alloc_payload( AU, vvencParams.m_SourceWidth*vvencParams.m_SourceHeight );
+
+  vvencYUVBuffer* pcYuvPicture = vvenc_YUVBuffer_alloc();
+  vvenc_YUVBuffer_alloc_buffer( pcYuvPicture, vvencParams.m_internChromaFormat, vvencParams.m_SourceWidth, vvencParams.m_SourceHeight );
+
+  fillInputPic( pcYuvPicture );
+
+  bool encodeDone = false;
+  for( int i = 0; i < 40; i++ )
+  {
+    if( i == 8 )
+    {
+      // change QP and motion search in the middle of the first GOP
+      vvenc_config reconfigParams;
+      if( 0 != vvenc_get_config( enc, &reconfigParams ) )
+      {
+        vvenc_YUVBuffer_free( pcYuvPicture, true );
+        vvenc_accessUnit_free( AU, true );
+        return -1;
+      }
+      reconfigParams.m_QP          += 5;
+      reconfigParams.m_SearchRange /= 2;
+      if( 0 != vvenc_reconfig( enc, &reconfigParams ) )
+      {
+        vvenc_YUVBuffer_free( pcYuvPicture, true );
+        vvenc_accessUnit_free( AU, true );
+        return -1;
+      }
+    }
+
+    pcYuvPicture->sequenceNumber = i;
+    if( 0 != vvenc_encode( enc, pcYuvPicture, AU, &encodeDone ))
+    {
+      vvenc_YUVBuffer_free( pcYuvPicture, true );
+      vvenc_accessUnit_free( AU, true );
+      return -1;
+    }
+  }
+
+  while( ! encodeDone )
+  {
+    if( 0 != vvenc_encode( enc, nullptr, AU, &encodeDone ))
+    {
+      vvenc_YUVBuffer_free( pcYuvPicture, true );
+      vvenc_accessUnit_free( AU, true );
+      return -1;
+    }
+  }
+
+  if( 0 != vvenc_encoder_close( enc ) )
+  {
+    vvenc_YUVBuffer_free( pcYuvPicture, true );
+    vvenc_accessUnit_free( AU, true );
+    return -1;
+  }
+
+  vvenc_YUVBuffer_free( pcYuvPicture, true );
+  vvenc_accessUnit_free( AU, true );
+
+  return 0;
+}
+
+int callingOrderRegularLowDelay()
+{
+  vvenc_config vvencParams;
+  vvenc_config_default( &vvencParams );
+
+  fillEncoderParameters( vvencParams, false );
+  vvencParams.m_lowDelay = true;
+  vvenc_init_config_parameter( &vvencParams );
+
+  vvencEncoder *enc = vvenc_encoder_create();
+  if( nullptr == enc )
+  {
+    return -1;
+  }
+
+  if( 0 != vvenc_encoder_open( enc, &vvencParams ) )
+  {
+    vvenc_encoder_close( enc );
+    return -1;
+  }
+
+  vvencAccessUnit* AU = vvenc_accessUnit_alloc();
+  vvenc_accessUnit_alloc_payload( AU, vvencParams.m_SourceWidth*vvencParams.m_SourceHeight );
+
+  vvencYUVBuffer* pcYuvPicture = vvenc_YUVBuffer_alloc();
+  vvenc_YUVBuffer_alloc_buffer( pcYuvPicture, vvencParams.m_internChromaFormat, vvencParams.m_SourceWidth, vvencParams.m_SourceHeight );
+
+  fillInputPic( pcYuvPicture );
+
+  bool encodeDone = false;
+  for( int i = 0; i < 20; i++ )
+  {
+    pcYuvPicture->sequenceNumber = i;
+    // each picture has to be returned by the call it was passed in
+    if( 0 != vvenc_encode( enc, pcYuvPicture, AU, &encodeDone ) || AU->payloadUsedSize <= 0 || AU->poc != (uint64_t)i )
+    {
+      vvenc_YUVBuffer_free( pcYuvPicture, true );
+      vvenc_accessUnit_free( AU, true );
+      return -1;
+    }
+  }
+
+  while( ! encodeDone )
+  {
+    if( 0 != vvenc_encode( enc, nullptr, AU, &encodeDone ) || AU->payloadUsedSize > 0 )
+    {
+      vvenc_YUVBuffer_free( pcYuvPicture, true );
+      vvenc_accessUnit_free( AU, true );
+      return -1;
+    }
+  }
+
+  if( 0 != vvenc_encoder_close( enc ) )
+  {
+    vvenc_YUVBuffer_free( pcYuvPicture, true );
+    vvenc_accessUnit_free( AU, true );
+    return -1;
+  }
+
+  vvenc_YUVBuffer_free( pcYuvPicture, true );
+  vvenc_accessUnit_free( AU, true );
+
+  return 0;
+}
+
+int callingOrderReconfigRateControl()
+{
+  vvenc_config vvencParams;
+  vvenc_config_default( &vvencParams );
+
+  fillEncoderParameters( vvencParams );
+
+  vvencEncoder *enc = vvenc_encoder_create();
+  if( nullptr == enc )
+  {
+    return -1;
+  }
+
+  if( 0 != vvenc_encoder_open( enc, &vvencParams ) )
+  {
+    vvenc_encoder_close( enc );
+    return -1;
+  }
+
+  // switching on rate control is not supported
+  vvenc_config reconfigParams;
+  vvenc_get_config( enc, &reconfigParams );
+  reconfigParams.m_RCTargetBitrate = 500000;
+  const int ret = vvenc_reconfig( enc, &reconfigParams );
+
+  vvenc_encoder_close( enc );
+
+  return ret;
+}
+
 int callingOrderNotRegular()
 {
   vvenc_config vvencParams;
@@ -777,6 +954,9 @@ int testLibCallingOrder()
   testfunc( "callingOrderRegular",          &callingOrderRegular,          false );
   testfunc( "callingOrderRegularInitPass",  &callingOrderRegularInitPass,  false );
   testfunc( "callingOrderRegularInit2Pass", &callingOrderRegularInit2Pass, false );
+  testfunc( "callingOrderRegularReconfig",  &callingOrderRegularReconfig,  false );
+  testfunc( "callingOrderReconfigRateControl", &callingOrderReconfigRateControl, true );
+  testfunc( "callingOrderRegularLowDelay",  &callingOrderRegularLowDelay,  false );
 
   testfunc( "callingOrderNotRegular",       &callingOrderNotRegular,       true );
 
@@ -0,0 +1,769 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+For any license concerning other Intellectual Property rights than the software,
+especially patent licenses, a separate Agreement needs to be closed. 
+For more information please contact:
+
+Fraunhofer Heinrich Hertz Institute
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+
+Copyright (c) 2019-2021, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of Fraunhofer nor the names of its contributors may
+   be used to endorse or promote products derived from this software without
+   specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+THE POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+/**
+  \ingroup vvencsimdtest
+  \file    vvencsimdtest.cpp
+  \brief   Checks the x86 SIMD kernels of the dispatch tables against their C reference
+           implementations and optionally reports cycles per sample for both.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "CommonLib/CommonDef.h"
+
+#if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include "CommonLib/Unit.h"
+#include "CommonLib/RdCost.h"
+#include "CommonLib/TrQuant_EMT.h"
+#include "CommonLib/InterpolationFilter.h"
+#include "CommonLib/AdaptiveLoopFilter.h"
+
+using namespace vvenc;
+
+static int          g_numTests = 0;
+static int          g_numFails = 0;
+static bool         g_bench    = false;
+static std::mt19937 g_rng( 0x5eed );
+
+static const ClpRng g_clpRng10 = { 0, 1023, 10, 0 };
+
+static const int g_blkSizes[][2] = { { 4, 4 }, { 8, 4 }, { 4, 8 }, { 8, 8 }, { 16, 8 }, { 8, 16 }, { 16, 16 }, { 32, 8 },
+                                     { 32, 32 }, { 64, 16 }, { 64, 64 }, { 128, 32 }, { 128, 128 } };
+
+static int randInt( int lo, int hi )
+{
+  return std::uniform_int_distribution<int>( lo, hi )( g_rng );
+}
+
+static const char* vextName( X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case SSE41: return "SSE41";
+  case SSE42: return "SSE42";
+  case AVX:   return "AVX";
+  case AVX2:  return "AVX2";
+  default:    return "SCALAR";
+  }
+}
+
+#define INIT_SIMD( obj, initFunc, vext )       \
+  switch( vext )                               \
+  {                                            \
+  case AVX2: ( obj ).initFunc<AVX2>();  break; \
+  case AVX:  ( obj ).initFunc<AVX>();   break; \
+  default:   ( obj ).initFunc<SSE41>(); break; \
+  }
+
+// picture-like buffer with a margin around the block, the whole allocation is compared to catch out of block writes.
+// the block origin and all rows are 32 byte aligned like in the picture and unit buffers of the encoder
+template<typename T>
+struct TestBuf
+{
+  static const int margin = MEMORY_ALIGN_DEF_SIZE / sizeof( T );
+
+  TestBuf( int w, int h )
+    : stride( ( w + 2 * margin + margin - 1 ) / margin * margin )
+    , size  ( size_t( stride ) * ( h + 2 * margin ) )
+    , mem   ( ( T* ) xMalloc( T, size ) )
+  {
+    memset( mem, 0, size * sizeof( T ) );
+  }
+  ~TestBuf() { xFree( mem ); }
+
+  T*   buf   ()                         { return mem + margin * stride + margin; }
+  void rand  ( int lo, int hi )         { for( size_t i = 0; i < size; i++ ) mem[i] = T( randInt( lo, hi ) ); }
+  void copy  ( const TestBuf& other )   { memcpy( mem, other.mem, size * sizeof( T ) ); }
+  bool operator==( const TestBuf& other ) const { return !memcmp( mem, other.mem, size * sizeof( T ) ); }
+
+  const int    stride;
+  const size_t size;
+  T*           mem;
+
+private:
+  TestBuf( const TestBuf& ) = delete;
+  TestBuf& operator=( const TestBuf& ) = delete;
+};
+
+typedef TestBuf<Pel> PelTestBuf;
+
+template<typename F>
+static double cyclesPerSample( F&& func, int numSamples )
+{
+  const int iters = std::max( 8, ( 1 << 20 ) / std::max( numSamples, 1 ) );
+  uint64_t  best  = UINT64_MAX;
+
+  func();
+  for( int r = 0; r < 5; r++ )
+  {
+    const uint64_t start = __rdtsc();
+    for( int i = 0; i < iters; i++ )
+    {
+      func();
+    }
+    best = std::min<uint64_t>( best, __rdtsc() - start );
+  }
+  return double( best ) / iters / numSamples;
+}
+
+// runs the reference and the SIMD version once, compares the results and optionally measures both
+template<typename FRef, typename FOpt, typename FCmp>
+static void checkKernel( const char* kernel, X86_VEXT vext, int w, int h, FRef&& runRef, FOpt&& runOpt, FCmp&& isEqual )
+{
+  runRef();
+  runOpt();
+
+  g_numTests++;
+  if( !isEqual() )
+  {
+    g_numFails++;
+    fprintf( stderr, "mismatch: %-36s %3dx%-3d %s\n", kernel, w, h, vextName( vext ) );
+  }
+
+  if( g_bench )
+  {
+    const double cRef = cyclesPerSample( runRef, w * h );
+    const double cOpt = cyclesPerSample( runOpt, w * h );
+    printf( "%-36s %3dx%-3d %-6s C %8.3f  SIMD %8.3f cycles/sample  x%.2f\n", kernel, w, h, vextName( vext ), cRef, cOpt, cRef / cOpt );
+  }
+}
+
+// ====================================================================================================================
+// PelBufferOps
+// ====================================================================================================================
+
+static void testPelBufOps( X86_VEXT vext )
+{
+  PelBufferOps ref;
+  PelBufferOps opt;
+  INIT_SIMD( opt, _initPelBufOpsX86, vext );
+
+  for( const auto& sz : g_blkSizes )
+  {
+    const int w = sz[0], h = sz[1];
+
+    PelTestBuf src0( w, h ), src1( w, h ), dstRef( w, h ), dstOpt( w, h );
+    src0.rand( -IF_INTERNAL_OFFS, 16383 - IF_INTERNAL_OFFS );
+    src1.rand( -IF_INTERNAL_OFFS, 16383 - IF_INTERNAL_OFFS );
+
+    auto cmpDst = [&]() { return dstRef == dstOpt; };
+
+    {
+      const unsigned shift  = std::max<int>( 2, IF_INTERNAL_PREC - g_clpRng10.bd ) + 1;
+      const int      offset = ( 1 << ( shift - 1 ) ) + 2 * IF_INTERNAL_OFFS;
+
+      auto addAvg = ( w & 15 ) == 0 ? &PelBufferOps::addAvg16 : ( w & 7 ) == 0 ? &PelBufferOps::addAvg8 : &PelBufferOps::addAvg4;
+      checkKernel( ( w & 15 ) == 0 ? "addAvg16" : ( w & 7 ) == 0 ? "addAvg8" : "addAvg4", vext, w, h,
+                   [&]() { ( ref.*addAvg )( src0.buf(), src0.stride, src1.buf(), src1.stride, dstRef.buf(), dstRef.stride, w, h, shift, offset, g_clpRng10 ); },
+                   [&]() { ( opt.*addAvg )( src0.buf(), src0.stride, src1.buf(), src1.stride, dstOpt.buf(), dstOpt.stride, w, h, shift, offset, g_clpRng10 ); },
+                   cmpDst );
+      checkKernel( "addAvg", vext, w, h,
+                   [&]() { ref.addAvg( src0.buf(), src1.buf(), dstRef.buf(), w * h, shift, offset, g_clpRng10 ); },
+                   [&]() { opt.addAvg( src0.buf(), src1.buf(), dstOpt.buf(), w * h, shift, offset, g_clpRng10 ); },
+                   cmpDst );
+
+      const int w1 = randInt( 0, 1 ) ? 5 : -2;
+      const int w0 = 8 - w1;
+      const int wShift  = shift - 1 + 3;
+      const int wOffset = ( 1 << ( wShift - 1 ) ) + ( IF_INTERNAL_OFFS << 3 );
+      auto wghtAvg = ( w & 7 ) == 0 ? &PelBufferOps::wghtAvg8 : &PelBufferOps::wghtAvg4;
+      checkKernel( ( w & 7 ) == 0 ? "wghtAvg8" : "wghtAvg4", vext, w, h,
+                   [&]() { ( ref.*wghtAvg )( src0.buf(), src0.stride, src1.buf(), src1.stride, dstRef.buf(), dstRef.stride, w, h, wShift, wOffset, w0, w1, g_clpRng10 ); },
+                   [&]() { ( opt.*wghtAvg )( src0.buf(), src0.stride, src1.buf(), src1.stride, dstOpt.buf(), dstOpt.stride, w, h, wShift, wOffset, w0, w1, g_clpRng10 ); },
+                   cmpDst );
+
+      PelTestBuf hfRef( w, h ), hfOpt( w, h );
+      hfRef.rand( -IF_INTERNAL_OFFS, 16383 - IF_INTERNAL_OFFS );
+      hfOpt.copy( hfRef );
+      auto removeHighFreq = ( w & 7 ) == 0 ? &PelBufferOps::removeHighFreq8 : &PelBufferOps::removeHighFreq4;
+      checkKernel( ( w & 7 ) == 0 ? "removeHighFreq8" : "removeHighFreq4", vext, w, h,
+                   [&]() { ( ref.*removeHighFreq )( hfRef.buf(), hfRef.stride, src1.buf(), src1.stride, w, h ); },
+                   [&]() { ( opt.*removeHighFreq )( hfOpt.buf(), hfOpt.stride, src1.buf(), src1.stride, w, h ); },
+                   [&]() { return hfRef == hfOpt; } );
+    }
+
+    src0.rand( 0, 1023 );
+    src1.rand( -1023, 1023 );
+
+    auto sub = ( w & 7 ) == 0 ? &PelBufferOps::sub8 : &PelBufferOps::sub4;
+    checkKernel( ( w & 7 ) == 0 ? "sub8" : "sub4", vext, w, h,
+                 [&]() { ( ref.*sub )( src0.buf(), src0.stride, src1.buf(), src1.stride, dstRef.buf(), dstRef.stride, w, h ); },
+                 [&]() { ( opt.*sub )( src0.buf(), src0.stride, src1.buf(), src1.stride, dstOpt.buf(), dstOpt.stride, w, h ); },
+                 cmpDst );
+
+    auto reco = ( w & 7 ) == 0 ? &PelBufferOps::reco8 : &PelBufferOps::reco4;
+    checkKernel( ( w & 7 ) == 0 ? "reco8" : "reco4", vext, w, h,
+                 [&]() { ( ref.*reco )( src0.buf(), src0.stride, src1.buf(), src1.stride, dstRef.buf(), dstRef.stride, w, h, g_clpRng10 ); },
+                 [&]() { ( opt.*reco )( src0.buf(), src0.stride, src1.buf(), src1.stride, dstOpt.buf(), dstOpt.stride, w, h, g_clpRng10 ); },
+                 cmpDst );
+    checkKernel( "reco", vext, w, h,
+                 [&]() { ref.reco( src0.buf(), src1.buf(), dstRef.buf(), w * h, g_clpRng10 ); },
+                 [&]() { opt.reco( src0.buf(), src1.buf(), dstOpt.buf(), w * h, g_clpRng10 ); },
+                 cmpDst );
+
+    auto copyClip = ( w & 7 ) == 0 ? &PelBufferOps::copyClip8 : &PelBufferOps::copyClip4;
+    checkKernel( ( w & 7 ) == 0 ? "copyClip8" : "copyClip4", vext, w, h,
+                 [&]() { ( ref.*copyClip )( src1.buf(), src1.stride, dstRef.buf(), dstRef.stride, w, h, g_clpRng10 ); },
+                 [&]() { ( opt.*copyClip )( src1.buf(), src1.stride, dstOpt.buf(), dstOpt.stride, w, h, g_clpRng10 ); },
+                 cmpDst );
+    checkKernel( "copyClip", vext, w, h,
+                 [&]() { ref.copyClip( src1.buf(), dstRef.buf(), w * h, g_clpRng10 ); },
+                 [&]() { opt.copyClip( src1.buf(), dstOpt.buf(), w * h, g_clpRng10 ); },
+                 cmpDst );
+
+    for( int bClip = 0; bClip < 2; bClip++ )
+    {
+      const int scale = randInt( 1 << 10, 1 << 12 );
+      auto linTf = ( w & 7 ) == 0 ? &PelBufferOps::linTf8 : &PelBufferOps::linTf4;
+      checkKernel( ( w & 7 ) == 0 ? "linTf8" : "linTf4", vext, w, h,
+                   [&]() { ( ref.*linTf )( src1.buf(), src1.stride, dstRef.buf(), dstRef.stride, w, h, scale, 11, 1 << 10, g_clpRng10, bClip != 0 ); },
+                   [&]() { ( opt.*linTf )( src1.buf(), src1.stride, dstOpt.buf(), dstOpt.stride, w, h, scale, 11, 1 << 10, g_clpRng10, bClip != 0 ); },
+                   cmpDst );
+    }
+
+    checkKernel( "copyBuffer", vext, w, h,
+                 [&]() { ref.copyBuffer( ( const char* ) src0.buf(), src0.stride * sizeof( Pel ), ( char* ) dstRef.buf(), dstRef.stride * sizeof( Pel ), w * sizeof( Pel ), h ); },
+                 [&]() { opt.copyBuffer( ( const char* ) src0.buf(), src0.stride * sizeof( Pel ), ( char* ) dstOpt.buf(), dstOpt.stride * sizeof( Pel ), w * sizeof( Pel ), h ); },
+                 cmpDst );
+
+    for( int numIntra = 0; numIntra < 3; numIntra++ )
+    {
+      PelTestBuf resRef( w, h ), resOpt( w, h );
+      resRef.rand( 0, 1023 );
+      resOpt.copy( resRef );
+      checkKernel( "weightCiip", vext, w, h,
+                   [&]() { ref.weightCiip( resRef.buf(), src0.buf(), w * h, numIntra ); },
+                   [&]() { opt.weightCiip( resOpt.buf(), src0.buf(), w * h, numIntra ); },
+                   [&]() { return resRef == resOpt; } );
+    }
+
+    {
+      std::vector<Pel> lut( 1024 );
+      for( auto& v : lut ) v = Pel( randInt( 0, 1023 ) );
+      checkKernel( "applyLut", vext, w, h,
+                   [&]() { ref.applyLut( src0.buf(), src0.stride, dstRef.buf(), dstRef.stride, w, h, lut.data() ); },
+                   [&]() { opt.applyLut( src0.buf(), src0.stride, dstOpt.buf(), dstOpt.stride, w, h, lut.data() ); },
+                   cmpDst );
+    }
+
+    {
+      uint64_t actRef = 0, actOpt = 0;
+      auto cmpAct = [&]() { return actRef == actOpt; };
+      PelTestBuf prev1( w, h ), prev2( w, h );
+      src0.rand( 0, 1023 );
+      prev1.rand( 0, 1023 );
+      prev2.rand( 0, 1023 );
+
+      checkKernel( "AvgHighPass", vext, w, h,
+                   [&]() { actRef = ref.AvgHighPass( w, h, src0.buf(), src0.stride ); },
+                   [&]() { actOpt = opt.AvgHighPass( w, h, src0.buf(), src0.stride ); },
+                   cmpAct );
+      checkKernel( "AvgHighPassWithDownsampling", vext, w, h,
+                   [&]() { actRef = ref.AvgHighPassWithDownsampling( w, h, src0.buf(), src0.stride ); },
+                   [&]() { actOpt = opt.AvgHighPassWithDownsampling( w, h, src0.buf(), src0.stride ); },
+                   cmpAct );
+      checkKernel( "HDHighPass", vext, w, h,
+                   [&]() { actRef = ref.HDHighPass( w, h, src0.buf(), prev1.buf(), src0.stride, prev1.stride ); },
+                   [&]() { actOpt = opt.HDHighPass( w, h, src0.buf(), prev1.buf(), src0.stride, prev1.stride ); },
+                   cmpAct );
+      checkKernel( "HDHighPass2", vext, w, h,
+                   [&]() { actRef = ref.HDHighPass2( w, h, src0.buf(), prev1.buf(), prev2.buf(), src0.stride, prev1.stride, prev2.stride ); },
+                   [&]() { actOpt = opt.HDHighPass2( w, h, src0.buf(), prev1.buf(), prev2.buf(), src0.stride, prev1.stride, prev2.stride ); },
+                   cmpAct );
+      checkKernel( "AvgHighPassWithDownsamplingDiff1st", vext, w, h,
+                   [&]() { actRef = ref.AvgHighPassWithDownsamplingDiff1st( w, h, src0.buf(), prev1.buf(), src0.stride, prev1.stride ); },
+                   [&]() { actOpt = opt.AvgHighPassWithDownsamplingDiff1st( w, h, src0.buf(), prev1.buf(), src0.stride, prev1.stride ); },
+                   cmpAct );
+      checkKernel( "AvgHighPassWithDownsamplingDiff2nd", vext, w, h,
+                   [&]() { actRef = ref.AvgHighPassWithDownsamplingDiff2nd( w, h, src0.buf(), prev1.buf(), prev2.buf(), src0.stride, prev1.stride, prev2.stride ); },
+                   [&]() { actOpt = opt.AvgHighPassWithDownsamplingDiff2nd( w, h, src0.buf(), prev1.buf(), prev2.buf(), src0.stride, prev1.stride, prev2.stride ); },
+                   cmpAct );
+
+      int64_t sumRef = 0, sumSqRef = 0, sumOpt = 0, sumSqOpt = 0;
+      checkKernel( "sumAndSumSq", vext, w, h,
+                   [&]() { ref.sumAndSumSq( src0.buf(), src0.stride, w, h, &sumRef, &sumSqRef ); },
+                   [&]() { opt.sumAndSumSq( src0.buf(), src0.stride, w, h, &sumOpt, &sumSqOpt ); },
+                   [&]() { return sumRef == sumOpt && sumSqRef == sumSqOpt; } );
+    }
+
+    {
+      std::vector<int> colSumRef( w ), colSumSqRef( w ), colSumOpt, colSumSqOpt;
+      for( int x = 0; x < w; x++ )
+      {
+        colSumRef[x]   = randInt( 0, 1023 * 64 );
+        colSumSqRef[x] = randInt( 0, 1023 * 1023 * 64 );
+      }
+      colSumOpt   = colSumRef;
+      colSumSqOpt = colSumSqRef;
+      const Pel* rows[3][2] = { { src0.buf(), nullptr }, { nullptr, src0.buf() + src0.stride }, { src0.buf() + 2 * src0.stride, src0.buf() } };
+      for( const auto& r : rows )
+      {
+        checkKernel( "addSubColSums", vext, w, 1,
+                     [&]() { ref.addSubColSums( r[0], r[1], colSumRef.data(), colSumSqRef.data(), w ); },
+                     [&]() { opt.addSubColSums( r[0], r[1], colSumOpt.data(), colSumSqOpt.data(), w ); },
+                     [&]() { return colSumRef == colSumOpt && colSumSqRef == colSumSqOpt; } );
+      }
+    }
+  }
+
+  {
+    PelTestBuf src( 8, 8 ), dstRef( 8, 8 ), dstOpt( 8, 8 );
+    src.rand( -32768, 32767 );
+    checkKernel( "transpose4x4", vext, 4, 4,
+                 [&]() { ref.transpose4x4( src.buf(), src.stride, dstRef.buf(), dstRef.stride ); },
+                 [&]() { opt.transpose4x4( src.buf(), src.stride, dstOpt.buf(), dstOpt.stride ); },
+                 [&]() { return dstRef == dstOpt; } );
+    checkKernel( "transpose8x8", vext, 8, 8,
+                 [&]() { ref.transpose8x8( src.buf(), src.stride, dstRef.buf(), dstRef.stride ); },
+                 [&]() { opt.transpose8x8( src.buf(), src.stride, dstOpt.buf(), dstOpt.stride ); },
+                 [&]() { return dstRef == dstOpt; } );
+
+    int devRef = 0, devOpt = 0;
+    src.rand( 0, 1023 );
+    checkKernel( "AvgAbsDev4x4", vext, 4, 4,
+                 [&]() { devRef = ref.AvgAbsDev4x4( src.buf(), src.stride, 4, 4 ); },
+                 [&]() { devOpt = opt.AvgAbsDev4x4( src.buf(), src.stride, 4, 4 ); },
+                 [&]() { return devRef == devOpt; } );
+  }
+
+  {
+    const int maxVal = 1023;
+    alignas( MEMORY_ALIGN_DEF_SIZE ) Pel     input[16];
+    alignas( MEMORY_ALIGN_DEF_SIZE ) uint8_t weight[64 * 8];
+    alignas( MEMORY_ALIGN_DEF_SIZE ) Pel     resRef[64];
+    alignas( MEMORY_ALIGN_DEF_SIZE ) Pel     resOpt[64];
+    for( auto& v : weight ) v = uint8_t( randInt( 0, 127 ) );
+    for( auto& v : input  ) v = Pel( randInt( -512, 511 ) );
+    const int inputOffset = randInt( 0, 1023 );
+
+    for( int transpose = 0; transpose < 2; transpose++ )
+    {
+      checkKernel( "mipMatrixMul_4_4", vext, 4, 4,
+                   [&]() { ref.mipMatrixMul_4_4( resRef, input, weight, maxVal, inputOffset, transpose != 0 ); },
+                   [&]() { opt.mipMatrixMul_4_4( resOpt, input, weight, maxVal, inputOffset, transpose != 0 ); },
+                   [&]() { return !memcmp( resRef, resOpt, 16 * sizeof( Pel ) ); } );
+      checkKernel( "mipMatrixMul_8_4", vext, 4, 4,
+                   [&]() { ref.mipMatrixMul_8_4( resRef, input, weight, maxVal, inputOffset, transpose != 0 ); },
+                   [&]() { opt.mipMatrixMul_8_4( resOpt, input, weight, maxVal, inputOffset, transpose != 0 ); },
+                   [&]() { return !memcmp( resRef, resOpt, 16 * sizeof( Pel ) ); } );
+      checkKernel( "mipMatrixMul_8_8", vext, 8, 8,
+                   [&]() { ref.mipMatrixMul_8_8( resRef, input, weight, maxVal, inputOffset, transpose != 0 ); },
+                   [&]() { opt.mipMatrixMul_8_8( resOpt, input, weight, maxVal, inputOffset, transpose != 0 ); },
+                   [&]() { return !memcmp( resRef, resOpt, 64 * sizeof( Pel ) ); } );
+    }
+  }
+}
+
+// ====================================================================================================================
+// TCoeffOps
+// ====================================================================================================================
+
+#if ENABLE_SIMD_TRAFO
+static void testTCoeffOps( X86_VEXT vext )
+{
+  TCoeffOps ref;
+  TCoeffOps opt;
+  INIT_SIMD( opt, _initTCoeffOpsX86, vext );
+
+  alignas( MEMORY_ALIGN_DEF_SIZE ) static TCoeff       src   [MAX_TB_SIZEY * MAX_TB_SIZEY];
+  alignas( MEMORY_ALIGN_DEF_SIZE ) static TCoeff       dstRef[MAX_TB_SIZEY * MAX_TB_SIZEY];
+  alignas( MEMORY_ALIGN_DEF_SIZE ) static TCoeff       dstOpt[MAX_TB_SIZEY * MAX_TB_SIZEY];
+  alignas( MEMORY_ALIGN_DEF_SIZE ) static TMatrixCoeff mat   [MAX_TB_SIZEY * MAX_TB_SIZEY];
+
+  auto cmpCoeff = [&]() { return !memcmp( dstRef, dstOpt, sizeof( dstRef ) ); };
+  auto resetDst = [&]() { memset( dstRef, 0, sizeof( dstRef ) ); memset( dstOpt, 0, sizeof( dstOpt ) ); };
+
+  for( auto& v : mat ) v = TMatrixCoeff( randInt( -90, 90 ) );
+
+  for( const auto& sz : g_blkSizes )
+  {
+    const int w = std::min( sz[0], MAX_TB_SIZEY ), h = std::min( sz[1], MAX_TB_SIZEY );
+
+    PelTestBuf resi( w, h ), resiRef( w, h ), resiOpt( w, h );
+    resi.rand( -1023, 1023 );
+
+    resetDst();
+    auto cpyCoeff = ( w & 7 ) == 0 ? &TCoeffOps::cpyCoeff8 : &TCoeffOps::cpyCoeff4;
+    checkKernel( ( w & 7 ) == 0 ? "cpyCoeff8" : "cpyCoeff4", vext, w, h,
+                 [&]() { ( ref.*cpyCoeff )( resi.buf(), resi.stride, dstRef, w, h ); },
+                 [&]() { ( opt.*cpyCoeff )( resi.buf(), resi.stride, dstOpt, w, h ); },
+                 cmpCoeff );
+
+    auto cpyResi = ( w & 7 ) == 0 ? &TCoeffOps::cpyResi8 : &TCoeffOps::cpyResi4;
+    checkKernel( ( w & 7 ) == 0 ? "cpyResi8" : "cpyResi4", vext, w, h,
+                 [&]() { ( ref.*cpyResi )( dstRef, resiRef.buf(), resiRef.stride, w, h ); },
+                 [&]() { ( opt.*cpyResi )( dstOpt, resiOpt.buf(), resiOpt.stride, w, h ); },
+                 [&]() { return resiRef == resiOpt; } );
+
+    for( auto& v : src ) v = TCoeff( randInt( -( 1 << 20 ), 1 << 20 ) );
+    memcpy( dstRef, src, sizeof( src ) );
+    memcpy( dstOpt, src, sizeof( src ) );
+    const int shift = randInt( 6, 12 );
+    auto roundClip = w == 4 ? &TCoeffOps::roundClip4 : &TCoeffOps::roundClip8;
+    checkKernel( w == 4 ? "roundClip4" : "roundClip8", vext, w, h,
+                 [&]() { ( ref.*roundClip )( dstRef, w, h, w, -32768, 32767, 1 << ( shift - 1 ), shift ); },
+                 [&]() { ( opt.*roundClip )( dstOpt, w, h, w, -32768, 32767, 1 << ( shift - 1 ), shift ); },
+                 cmpCoeff );
+  }
+
+  for( int trSize = 4; trSize <= MAX_TB_SIZEY; trSize <<= 1 )
+  {
+    for( int line = 4; line <= MAX_TB_SIZEY; line <<= 1 )
+    {
+      const int cutoff = std::min( trSize, JVET_C0024_ZERO_OUT_TH );
+      const int reducedLine = std::min( line, JVET_C0024_ZERO_OUT_TH );
+
+      for( auto& v : src ) v = TCoeff( randInt( -32768, 32767 ) );
+      resetDst();
+      auto fastInv = trSize == 4 ? &TCoeffOps::fastInvCore4 : &TCoeffOps::fastInvCore8;
+      checkKernel( trSize == 4 ? "fastInvCore4" : "fastInvCore8", vext, trSize, line,
+                   [&]() { ( ref.*fastInv )( mat, src, dstRef, trSize, line, reducedLine, cutoff ); },
+                   [&]() { ( opt.*fastInv )( mat, src, dstOpt, trSize, line, reducedLine, cutoff ); },
+                   cmpCoeff );
+
+      for( auto& v : src ) v = TCoeff( randInt( -1023, 1023 ) );
+      resetDst();
+      auto fastFwd = trSize == 4 ? &TCoeffOps::fastFwdCore4_2D : &TCoeffOps::fastFwdCore8_2D;
+      checkKernel( trSize == 4 ? "fastFwdCore4_2D" : "fastFwdCore8_2D", vext, trSize, line,
+                   [&]() { ( ref.*fastFwd )( mat, src, dstRef, trSize, line, reducedLine, cutoff, 6 ); },
+                   [&]() { ( opt.*fastFwd )( mat, src, dstOpt, trSize, line, reducedLine, cutoff, 6 ); },
+                   cmpCoeff );
+    }
+  }
+}
+#endif
+
+// ====================================================================================================================
+// RdCost
+// ====================================================================================================================
+
+#if ENABLE_SIMD_OPT_DIST
+static void testRdCost( X86_VEXT vext )
+{
+  RdCost ref;
+  RdCost opt;
+  ref.create();
+  opt.create();
+  INIT_SIMD( opt, _initRdCostX86, vext );
+
+  static const struct { DFunc dfunc; const char* name; int bitDepth; } funcs[] =
+  {
+    { DF_SAD, "DF_SAD", 10 }, { DF_SSE, "DF_SSE", 10 }, { DF_HAD, "DF_HAD", 10 },
+  };
+
+  for( const auto& sz : g_blkSizes )
+  {
+    const int w = sz[0], h = sz[1];
+
+    for( const auto& f : funcs )
+    {
+      PelTestBuf org( w, h ), cur( w, h );
+      org.rand( 0, ( 1 << f.bitDepth ) - 1 );
+      cur.rand( 0, ( 1 << f.bitDepth ) - 1 );
+
+      const CPelBuf orgBuf( org.buf(), org.stride, w, h );
+      const CPelBuf curBuf( cur.buf(), cur.stride, w, h );
+
+      for( int subShift = 0; subShift < ( f.dfunc == DF_SAD && h > 4 ? 2 : 1 ); subShift++ )
+      {
+        DistParam dpRef = ref.setDistParam( orgBuf, curBuf, f.bitDepth, f.dfunc );
+        DistParam dpOpt = opt.setDistParam( orgBuf, curBuf, f.bitDepth, f.dfunc );
+        dpRef.subShift  = dpOpt.subShift = subShift;
+
+        Distortion distRef = 0, distOpt = 0;
+        checkKernel( f.name, vext, w, h,
+                     [&]() { distRef = dpRef.distFunc( dpRef ); },
+                     [&]() { distOpt = dpOpt.distFunc( dpOpt ); },
+                     [&]() { return distRef == distOpt; } );
+      }
+    }
+  }
+}
+#endif
+
+// ====================================================================================================================
+// InterpolationFilter
+// ====================================================================================================================
+
+#if ENABLE_SIMD_OPT_MCIF
+static void testInterpolationFilter( X86_VEXT vext )
+{
+  InterpolationFilter ref;
+  InterpolationFilter opt;
+  INIT_SIMD( opt, _initInterpolationFilterX86, vext );
+
+  const ChromaFormat fmt = CHROMA_420;
+
+  for( const auto& sz : g_blkSizes )
+  {
+    const int w = sz[0], h = sz[1];
+
+    PelTestBuf src( w, h ), tmpRef( w, h + 8 ), tmpOpt( w, h + 8 ), dstRef( w, h ), dstOpt( w, h );
+    src.rand( 0, 1023 );
+
+    auto cmpDst = [&]() { return dstRef == dstOpt && tmpRef == tmpOpt; };
+
+    for( int comp = COMP_Y; comp <= COMP_Cb; comp++ )
+    {
+      const ComponentID compID = ComponentID( comp );
+      const int         taps   = isLuma( compID ) ? NTAPS_LUMA : NTAPS_CHROMA;
+      const int         fracX  = randInt( 1, 15 );
+      const int         fracY  = randInt( 1, 15 );
+      const int         vOff   = ( taps >> 1 ) - 1;
+
+      for( int isLast = 0; isLast < 2; isLast++ )
+      {
+        checkKernel( isLuma( compID ) ? "filterHor luma" : "filterHor chroma", vext, w, h,
+                     [&]() { ref.filterHor( compID, src.buf(), src.stride, dstRef.buf(), dstRef.stride, w, h, fracX, isLast != 0, fmt, g_clpRng10 ); },
+                     [&]() { opt.filterHor( compID, src.buf(), src.stride, dstOpt.buf(), dstOpt.stride, w, h, fracX, isLast != 0, fmt, g_clpRng10 ); },
+                     cmpDst );
+        checkKernel( isLuma( compID ) ? "filterVer luma" : "filterVer chroma", vext, w, h,
+                     [&]() { ref.filterVer( compID, src.buf(), src.stride, dstRef.buf(), dstRef.stride, w, h, fracY, true, isLast != 0, fmt, g_clpRng10 ); },
+                     [&]() { opt.filterVer( compID, src.buf(), src.stride, dstOpt.buf(), dstOpt.stride, w, h, fracY, true, isLast != 0, fmt, g_clpRng10 ); },
+                     cmpDst );
+        checkKernel( isLuma( compID ) ? "filterHorVer luma" : "filterHorVer chroma", vext, w, h,
+                     [&]()
+                     {
+                       ref.filterHor( compID, src.buf() - vOff * src.stride, src.stride, tmpRef.buf(), tmpRef.stride, w, h + taps - 1, fracX, false, fmt, g_clpRng10 );
+                       ref.filterVer( compID, tmpRef.buf() + vOff * tmpRef.stride, tmpRef.stride, dstRef.buf(), dstRef.stride, w, h, fracY, false, isLast != 0, fmt, g_clpRng10 );
+                     },
+                     [&]()
+                     {
+                       opt.filterHor( compID, src.buf() - vOff * src.stride, src.stride, tmpOpt.buf(), tmpOpt.stride, w, h + taps - 1, fracX, false, fmt, g_clpRng10 );
+                       opt.filterVer( compID, tmpOpt.buf() + vOff * tmpOpt.stride, tmpOpt.stride, dstOpt.buf(), dstOpt.stride, w, h, fracY, false, isLast != 0, fmt, g_clpRng10 );
+                     },
+                     cmpDst );
+
+        if( w == 4 && h == 4 )
+        {
+          checkKernel( isLuma( compID ) ? "filter4x4 luma" : "filter4x4 chroma", vext, w, h,
+                       [&]() { ref.filter4x4( compID, src.buf(), src.stride, dstRef.buf(), dstRef.stride, w, h, fracX, fracY, isLast != 0, fmt, g_clpRng10 ); },
+                       [&]() { opt.filter4x4( compID, src.buf(), src.stride, dstOpt.buf(), dstOpt.stride, w, h, fracX, fracY, isLast != 0, fmt, g_clpRng10 ); },
+                       cmpDst );
+        }
+        else if( w == 8 && h >= 8 )
+        {
+          checkKernel( isLuma( compID ) ? "filter8x8 luma" : "filter8x8 chroma", vext, w, h,
+                       [&]() { ref.filter8x8( compID, src.buf(), src.stride, dstRef.buf(), dstRef.stride, w, h, fracX, fracY, isLast != 0, fmt, g_clpRng10 ); },
+                       [&]() { opt.filter8x8( compID, src.buf(), src.stride, dstOpt.buf(), dstOpt.stride, w, h, fracX, fracY, isLast != 0, fmt, g_clpRng10 ); },
+                       cmpDst );
+        }
+        else if( w == 16 && h >= 8 )
+        {
+          checkKernel( isLuma( compID ) ? "filter16x16 luma" : "filter16x16 chroma", vext, w, h,
+                       [&]() { ref.filter16x16( compID, src.buf(), src.stride, dstRef.buf(), dstRef.stride, w, h, fracX, fracY, isLast != 0, fmt, g_clpRng10 ); },
+                       [&]() { opt.filter16x16( compID, src.buf(), src.stride, dstOpt.buf(), dstOpt.stride, w, h, fracX, fracY, isLast != 0, fmt, g_clpRng10 ); },
+                       cmpDst );
+        }
+      }
+    }
+  }
+}
+#endif
+
+// ====================================================================================================================
+// AdaptiveLoopFilter
+// ====================================================================================================================
+
+#if ENABLE_SIMD_OPT_ALF
+static void testAlfCovariance( X86_VEXT vext )
+{
+  const int numClip = AdaptiveLoopFilter::MaxAlfNumClippingValues;
+
+  std::unique_ptr<AdaptiveLoopFilter> ref( new AdaptiveLoopFilter );
+  std::unique_ptr<AdaptiveLoopFilter> opt( new AdaptiveLoopFilter );
+  INIT_SIMD( *opt, _initAdaptiveLoopFilterX86, vext );
+
+  typedef double CovMat[MAX_NUM_ALF_LUMA_COEFF][MAX_NUM_ALF_LUMA_COEFF];
+
+  std::vector<CovMat> ERef( numClip * numClip ), EOpt( numClip * numClip );
+  double yRef[numClip][MAX_NUM_ALF_LUMA_COEFF], yOpt[numClip][MAX_NUM_ALF_LUMA_COEFF];
+  double pixAccRef = 0, pixAccOpt = 0;
+
+  auto resetCov = [&]()
+  {
+    for( int i = 0; i < numClip * numClip; i++ )
+    {
+      for( int k = 0; k < MAX_NUM_ALF_LUMA_COEFF; k++ )
+      {
+        for( int l = 0; l < MAX_NUM_ALF_LUMA_COEFF; l++ )
+        {
+          ERef[i][k][l] = EOpt[i][k][l] = randInt( 0, 1 << 24 );
+        }
+      }
+    }
+    for( int b = 0; b < numClip; b++ )
+    {
+      for( int k = 0; k < MAX_NUM_ALF_LUMA_COEFF; k++ )
+      {
+        yRef[b][k] = yOpt[b][k] = randInt( -( 1 << 24 ), 1 << 24 );
+      }
+    }
+    pixAccRef = pixAccOpt = randInt( 0, 1 << 24 );
+  };
+  auto cmpCov = [&]()
+  {
+    return !memcmp( ERef.data(), EOpt.data(), ERef.size() * sizeof( CovMat ) ) && !memcmp( yRef, yOpt, sizeof( yRef ) ) && pixAccRef == pixAccOpt;
+  };
+
+  static const int numCoeffs[] = { 6, 7, 12, 13 };
+
+  for( int numCoeff : numCoeffs )
+  {
+    alignas( MEMORY_ALIGN_DEF_SIZE ) Pel ELocal[MAX_NUM_ALF_LUMA_COEFF * 16];
+    alignas( MEMORY_ALIGN_DEF_SIZE ) Pel yLocal[16];
+    for( auto& v : ELocal ) v = Pel( randInt( -2046, 2046 ) );
+    for( auto& v : yLocal ) v = Pel( randInt( -1023, 1023 ) );
+
+    resetCov();
+    checkKernel( "calcCovLin4x4", vext, 4, 4,
+                 [&]() { ref->m_calcCovLin4x4( ELocal, yLocal, numCoeff, ERef[0], yRef[0], pixAccRef ); },
+                 [&]() { opt->m_calcCovLin4x4( ELocal, yLocal, numCoeff, EOpt[0], yOpt[0], pixAccOpt ); },
+                 cmpCov );
+  }
+
+  for( int numCoeff : numCoeffs )
+  {
+    int ELocal[MAX_NUM_ALF_LUMA_COEFF][numClip];
+    for( auto& row : ELocal ) for( auto& v : row ) v = randInt( -2046, 2046 );
+    const int    yLocal = randInt( -1023, 1023 );
+
+    CovMat* rowsRef[numClip];
+    CovMat* rowsOpt[numClip];
+    for( int b = 0; b < numClip; b++ )
+    {
+      rowsRef[b] = &ERef[b * numClip];
+      rowsOpt[b] = &EOpt[b * numClip];
+    }
+
+    for( double weight : { 1.0, 0.75 + randInt( 0, 1 << 10 ) / double( 1 << 10 ) } )
+    {
+      resetCov();
+      checkKernel( weight == 1.0 ? "calcCovNonLin" : "calcCovNonLin weighted", vext, 1, 1,
+                   [&]() { ref->m_calcCovNonLin( ELocal, yLocal, weight, numCoeff, rowsRef, yRef, pixAccRef ); },
+                   [&]() { opt->m_calcCovNonLin( ELocal, yLocal, weight, numCoeff, rowsOpt, yOpt, pixAccOpt ); },
+                   cmpCov );
+    }
+  }
+}
+#endif
+
+int main( int argc, char* argv[] )
+{
+  for( int i = 1; i < argc; i++ )
+  {
+    if( !strcmp( argv[i], "--bench" ) )
+    {
+      g_bench = true;
+    }
+    else
+    {
+      printf( "vvencsimdtest [--bench]\n" );
+      printf( "  checks all SIMD kernels against the C reference, --bench additionally reports cycles per sample\n" );
+      return -1;
+    }
+  }
+
+  const X86_VEXT maxVext = _get_x86_extensions();
+
+  // the reference objects have to stay with the C kernels, SIMD versions are set up explicitly below
+  read_x86_extension_flags( "SCALAR" );
+
+  for( X86_VEXT vext : { SSE41, AVX, AVX2 } )
+  {
+    if( vext > maxVext )
+    {
+      printf( "%s not supported by this CPU, skipped\n", vextName( vext ) );
+      continue;
+    }
+
+    const int numFails = g_numFails;
+
+    testPelBufOps( vext );
+#if ENABLE_SIMD_TRAFO
+    testTCoeffOps( vext );
+#endif
+#if ENABLE_SIMD_OPT_DIST
+    testRdCost( vext );
+#endif
+#if ENABLE_SIMD_OPT_MCIF
+    testInterpolationFilter( vext );
+#endif
+#if ENABLE_SIMD_OPT_ALF
+    testAlfCovariance( vext );
+#endif
+
+    printf( "%-6s %s\n", vextName( vext ), numFails == g_numFails ? "ok" : "FAILED" );
+  }
+
+  printf( "%d kernel checks, %d failures\n", g_numTests, g_numFails );
+
+  return g_numFails ? 1 : 0;
+}
+
+#else
+
+int main()
+{
+  printf( "x86 SIMD disabled, nothing to test\n" );
+  return 0;
+}
+
+#endif